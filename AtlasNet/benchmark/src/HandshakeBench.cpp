@@ -0,0 +1,326 @@
+// Connection admission under a burst of incoming connects.
+// A GNS listen socket and N clients share this process. Every connect goes through
+// ConnectionAdmission, the code Interlink admits with, and the burst is timed until all of them
+// are connected:
+//  - snapshot: peers the registry snapshot knows, accepted inside the status callback
+//  - deferred: peers registered after the snapshot was taken, left connecting while the
+//    admission thread asks Redis, then accepted from the loop the way Interlink's tick does
+//  - sync: for comparison, ServerRegistry::ExistsInRegistry inside the status callback, one Redis
+//    round trip each, the way admission worked before it had a snapshot
+// The process has a single GNS identity, so connections are attributed round robin to --peers
+// fake shard identities registered for the run. Needs the InternalDB Redis to be reachable.
+// Usage: HandshakeBench [--connects N] [--peers N] [--modes a,b,..] [--port N] [--json]
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "Debug/Log.hpp"
+#include "Global/Misc/LatencyHistogram.hpp"
+#include "Global/Misc/UUID.hpp"
+#include "Interlink/ConnectionAdmission.hpp"
+#include "Interlink/Database/ServerRegistry.hpp"
+#include "Interlink/GameNetworkingSockets.hpp"
+#include "Network/IPAddress.hpp"
+#include "Network/NetworkIdentity.hpp"
+
+namespace
+{
+using clock = std::chrono::steady_clock;
+
+enum class Mode
+{
+	eSync,
+	eSnapshot,
+	eDeferred
+};
+
+struct Result
+{
+	std::string_view ModeName;
+	size_t Connects = 0;
+	size_t Connected = 0;
+	double Seconds = 0;
+	LatencyHistogram CallbackUsec;
+	LatencyHistogram ConnectMs;
+};
+
+class Burst
+{
+   public:
+	Burst(ISteamNetworkingSockets* sockets, Mode mode, const std::vector<NetworkIdentity>& peers)
+		: Sockets(sockets), AdmissionMode(mode), Peers(peers)
+	{
+	}
+
+	void Run(uint16_t port, size_t connects, Result& result)
+	{
+		Active = this;
+		SteamNetworkingConfigValue_t opt;
+		opt.SetPtr(k_ESteamNetworkingConfig_Callback_ConnectionStatusChanged,
+				   (void*)&Burst::OnStatusChanged);
+		SteamNetworkingIPAddr addr;
+		addr.SetIPv4(0x7f000001, port);
+		const HSteamListenSocket listen = Sockets->CreateListenSocketIP(addr, 1, &opt);
+		if (listen == k_HSteamListenSocket_Invalid)
+		{
+			std::fprintf(stderr, "Failed to listen on port %u\n", port);
+			return;
+		}
+		Admission.Start(
+			[this](const ConnectionAdmission::Lookup& lookup)
+			{
+				std::lock_guard lock(Mutex);
+				Decided.push_back(lookup);
+			});
+
+		const auto start = clock::now();
+		for (size_t i = 0; i < connects; i++)
+		{
+			const HSteamNetConnection conn = Sockets->ConnectByIPAddress(addr, 1, &opt);
+			if (conn != k_HSteamNetConnection_Invalid)
+				Dialed[conn] = clock::now();
+		}
+		const auto deadline = start + std::chrono::seconds(60);
+		while (Connected < Dialed.size() && clock::now() < deadline)
+		{
+			Sockets->RunCallbacks();
+			AcceptDecided();
+			std::this_thread::sleep_for(std::chrono::microseconds(100));
+		}
+		result.Seconds = std::chrono::duration<double>(clock::now() - start).count();
+		result.Connects = connects;
+		result.Connected = Connected;
+		result.CallbackUsec.Merge(CallbackUsec);
+		result.ConnectMs.Merge(ConnectMs);
+
+		Admission.Stop();
+		for (const auto& [conn, dialed] : Dialed)
+			Sockets->CloseConnection(conn, 0, nullptr, false);
+		for (HSteamNetConnection conn : Accepted)
+			Sockets->CloseConnection(conn, 0, nullptr, false);
+		Sockets->CloseListenSocket(listen);
+		Active = nullptr;
+	}
+
+   private:
+	static void OnStatusChanged(SteamNetConnectionStatusChangedCallback_t* info)
+	{
+		// Closes from the previous burst still come in while the next one settles
+		if (Active)
+			Active->StatusChanged(info);
+	}
+
+	void StatusChanged(SteamNetConnectionStatusChangedCallback_t* info)
+	{
+		const bool incoming = info->m_info.m_hListenSocket != k_HSteamListenSocket_Invalid;
+		if (info->m_info.m_eState == k_ESteamNetworkingConnectionState_Connecting && incoming)
+		{
+			const auto start = clock::now();
+			const NetworkIdentity& peer = Peers[info->m_hConn % Peers.size()];
+			if (AdmissionMode == Mode::eSync)
+				Finish(info->m_hConn, ServerRegistry::Get().ExistsInRegistry(peer));
+			else if (Admission.Admit(info->m_hConn, peer))
+				Finish(info->m_hConn, true);
+			CallbackUsec.Record(std::chrono::duration_cast<std::chrono::microseconds>(
+									clock::now() - start)
+									.count());
+		}
+		else if (info->m_info.m_eState == k_ESteamNetworkingConnectionState_Connected &&
+				 !incoming)
+		{
+			if (auto it = Dialed.find(info->m_hConn); it != Dialed.end())
+			{
+				ConnectMs.Record(std::chrono::duration_cast<std::chrono::milliseconds>(
+									 clock::now() - it->second)
+									 .count());
+				Connected++;
+			}
+		}
+	}
+
+	void Finish(HSteamNetConnection conn, bool known)
+	{
+		if (!known)
+			Admission.Reject(Sockets, conn);
+		else if (Admission.Accept(Sockets, conn))
+			Accepted.push_back(conn);
+	}
+
+	/// What Interlink::Execute(Admit) does on the tick for each lookup that came back.
+	void AcceptDecided()
+	{
+		std::vector<ConnectionAdmission::Lookup> decided;
+		{
+			std::lock_guard lock(Mutex);
+			decided.swap(Decided);
+		}
+		for (const ConnectionAdmission::Lookup& lookup : decided)
+			Finish(lookup.Connection, lookup.Known);
+	}
+
+	static inline Burst* Active = nullptr;
+	ISteamNetworkingSockets* Sockets;
+	Mode AdmissionMode;
+	const std::vector<NetworkIdentity>& Peers;
+	std::unordered_map<HSteamNetConnection, clock::time_point> Dialed;
+	std::vector<HSteamNetConnection> Accepted;
+	size_t Connected = 0;
+	LatencyHistogram CallbackUsec;
+	LatencyHistogram ConnectMs;
+
+	ConnectionAdmission Admission;
+	std::mutex Mutex;
+	std::vector<ConnectionAdmission::Lookup> Decided;
+};
+
+void Print(const Result& r, bool json)
+{
+	const double rate = r.Seconds > 0 ? (double)r.Connected / r.Seconds : 0;
+	if (json)
+	{
+		std::printf(
+			"{\"mode\":\"%.*s\",\"connects\":%zu,\"connected\":%zu,\"seconds\":%.3f,"
+			"\"connects_per_sec\":%.0f,\"callback_p50_us\":%llu,\"callback_p99_us\":%llu,"
+			"\"callback_max_us\":%llu,\"connect_p50_ms\":%llu,\"connect_p99_ms\":%llu}\n",
+			(int)r.ModeName.size(), r.ModeName.data(), r.Connects, r.Connected, r.Seconds, rate,
+			(unsigned long long)r.CallbackUsec.Percentile(0.5),
+			(unsigned long long)r.CallbackUsec.Percentile(0.99),
+			(unsigned long long)r.CallbackUsec.Max(),
+			(unsigned long long)r.ConnectMs.Percentile(0.5),
+			(unsigned long long)r.ConnectMs.Percentile(0.99));
+		return;
+	}
+	std::printf("%.*s,%zu,%zu,%.3f,%.0f,%llu,%llu,%llu,%llu,%llu\n", (int)r.ModeName.size(),
+				r.ModeName.data(), r.Connects, r.Connected, r.Seconds, rate,
+				(unsigned long long)r.CallbackUsec.Percentile(0.5),
+				(unsigned long long)r.CallbackUsec.Percentile(0.99),
+				(unsigned long long)r.CallbackUsec.Max(),
+				(unsigned long long)r.ConnectMs.Percentile(0.5),
+				(unsigned long long)r.ConnectMs.Percentile(0.99));
+}
+
+std::vector<std::string> ParseNames(const char* list)
+{
+	std::vector<std::string> out;
+	std::string current;
+	for (const char* c = list; *c; c++)
+	{
+		if (*c == ',')
+		{
+			out.push_back(std::move(current));
+			current.clear();
+		}
+		else
+			current.push_back(*c);
+	}
+	if (!current.empty())
+		out.push_back(std::move(current));
+	return out;
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+	size_t connects = 5000;
+	size_t peerCount = 64;
+	uint16_t port = 27900;
+	std::vector<std::string> modes = {"snapshot", "deferred", "sync"};
+	bool json = false;
+	for (int i = 1; i < argc; i++)
+	{
+		const std::string_view arg = argv[i];
+		const char* value = i + 1 < argc ? argv[i + 1] : "";
+		if (arg == "--json")
+			json = true;
+		else if (arg == "--connects" && ++i < argc)
+			connects = std::strtoul(value, nullptr, 10);
+		else if (arg == "--peers" && ++i < argc)
+			peerCount = std::max<size_t>(1, std::strtoul(value, nullptr, 10));
+		else if (arg == "--port" && ++i < argc)
+			port = (uint16_t)std::strtoul(value, nullptr, 10);
+		else if (arg == "--modes" && ++i < argc)
+			modes = ParseNames(value);
+		else
+		{
+			std::fprintf(stderr,
+						 "usage: %s [--connects N] [--peers N] [--modes snapshot,deferred,sync] "
+						 "[--port N] [--json]\n",
+						 argv[0]);
+			return 1;
+		}
+	}
+	Log::SetLevel(Log::Level::Warning);
+	Log::InitFromEnv();
+
+	SteamDatagramErrMsg error;
+	if (!GameNetworkingSockets_Init(nullptr, error))
+	{
+		std::fprintf(stderr, "GameNetworkingSockets_Init failed: %s\n", error);
+		return 1;
+	}
+	ISteamNetworkingSockets* sockets = SteamNetworkingSockets();
+
+	// Known peers are in the snapshot. It is frozen before the late ones register, so those
+	// miss it like a server that registered moments ago.
+	std::vector<NetworkIdentity> knownPeers, latePeers;
+	IPAddress address;
+	address.Parse("127.0.0.1:" + std::to_string(port));
+	auto registerPeers = [&](std::vector<NetworkIdentity>& peers)
+	{
+		for (size_t i = 0; i < peerCount; i++)
+		{
+			peers.push_back(NetworkIdentity::MakeIDShard(UUIDGen::Gen()));
+			ServerRegistry::Get().RegisterSelf(peers.back(), address);
+		}
+	};
+	registerPeers(knownPeers);
+	ServerRegistry::Get().StartSnapshot();
+	ServerRegistry::Get().StopSnapshot();
+	registerPeers(latePeers);
+
+	if (!json)
+		std::printf(
+			"mode,connects,connected,seconds,connects_per_sec,callback_p50_us,callback_p99_us,"
+			"callback_max_us,connect_p50_ms,connect_p99_ms\n");
+	for (const std::string& name : modes)
+	{
+		Mode mode;
+		if (name == "sync")
+			mode = Mode::eSync;
+		else if (name == "snapshot")
+			mode = Mode::eSnapshot;
+		else if (name == "deferred")
+			mode = Mode::eDeferred;
+		else
+		{
+			std::fprintf(stderr, "Unknown mode %s\n", name.c_str());
+			continue;
+		}
+		Result result{.ModeName = name};
+		Burst(sockets, mode, mode == Mode::eDeferred ? latePeers : knownPeers)
+			.Run(port, connects, result);
+		Print(result, json);
+		std::fflush(stdout);
+		// Let the closed connections drain before the next burst reuses the port
+		const auto settle = clock::now() + std::chrono::seconds(1);
+		while (clock::now() < settle)
+		{
+			sockets->RunCallbacks();
+			std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		}
+	}
+
+	for (const NetworkIdentity& peer : knownPeers)
+		ServerRegistry::Get().DeRegisterSelf(peer);
+	for (const NetworkIdentity& peer : latePeers)
+		ServerRegistry::Get().DeRegisterSelf(peer);
+	GameNetworkingSockets_Kill();
+	return 0;
+}
@@ -0,0 +1,677 @@
+// Interlink messaging throughput and round trip latency, one sender fanning out to N receivers.
+// Endpoints run on one of two transports, named in the transport column:
+//  - gns: every receiver is a child process with its own GNS Interlink listening on 127.0.0.1,
+//    registered in the ServerRegistry and dialed by the sender like any other peer. Covers
+//    FlushOutbound and its SendMessages batching, lanes, Nagle and the UDP/crypto stack. Needs
+//    the InternalDB Redis to be reachable.
+//  - loopback: eLoopbackOnly Interlinks sharing this process. Only serialization, the tick loop,
+//    streaming and dispatch. The loopback transport hands messages over as they are whatever the
+//    send flag, so it runs under eReliableBatched alone.
+// For every send flag, payload size and fan-out:
+//  - throughput: send as fast as a window of unacknowledged messages per receiver allows
+//  - rtt: ping every receiver at once, each echoes back, one round outstanding at a time
+// Receivers report what they got in acks, so both transports are measured the same way.
+// Usage: InterlinkBench [--transports gns,loopback] [--ms N] [--window N] [--sizes a,b,..]
+//                       [--fanout a,b,..] [--port N] [--json]
+// Prints CSV, or one JSON object per line with --json.
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <boost/uuid/string_generator.hpp>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "Debug/Log.hpp"
+#include "Global/Misc/UUID.hpp"
+#include "Global/Serialize/ByteReader.hpp"
+#include "Global/Serialize/ByteWriter.hpp"
+#include "Interlink/Database/ServerRegistry.hpp"
+#include "Interlink/Interlink.hpp"
+#include "Network/IPAddress.hpp"
+#include "Network/NetworkIdentity.hpp"
+#include "Network/Packet/Packet.hpp"
+
+namespace
+{
+using clock = std::chrono::steady_clock;
+
+int64_t NowNs()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now().time_since_epoch())
+		.count();
+}
+
+enum class BenchKind : uint8_t
+{
+	eData,
+	eEcho,
+	eEchoReply,
+	eQuery,	 /// Ask for an ack right away
+	eAck
+};
+
+class BenchPacket : public TPacket<BenchPacket, "BenchPacket">
+{
+   public:
+	BenchKind Kind = BenchKind::eData;
+	/// Data: increasing across runs. Ack: the highest data sequence received so far.
+	uint64_t Sequence = 0;
+	/// Echo: send time for the round trip. Query: its ID, which the ack answering it carries.
+	int64_t SentAtNs = 0;
+	/// Ack: data messages received so far.
+	uint64_t Received = 0;
+	/// Echo: how the reply is sent.
+	NetworkMessageSendFlag ReplyFlag = NetworkMessageSendFlag::eReliableBatched;
+	std::vector<uint8_t> Payload;
+
+	BenchPacket() : TPacket() {}
+
+   private:
+	void SerializeData(ByteWriter& bw) const override
+	{
+		bw.u8((uint8_t)Kind);
+		bw.u64(Sequence);
+		bw.i64(SentAtNs);
+		bw.u64(Received);
+		bw.i32((int32_t)ReplyFlag);
+		bw.blob(std::span(Payload));
+	}
+	void DeserializeData(ByteReader& br) override
+	{
+		Kind = (BenchKind)br.u8();
+		Sequence = br.u64();
+		SentAtNs = br.i64();
+		Received = br.u64();
+		ReplyFlag = (NetworkMessageSendFlag)br.i32();
+		const auto blob = br.blob();
+		Payload.assign(blob.begin(), blob.end());
+	}
+	bool ValidateData() const override { return true; }
+};
+ATLASNET_REGISTER_PACKET(BenchPacket, "BenchPacket");
+
+struct Flag
+{
+	NetworkMessageSendFlag Value;
+	const char* Name;
+};
+constexpr Flag Flags[] = {
+	{NetworkMessageSendFlag::eImmidiateOrDrop, "eImmidiateOrDrop"},
+	{NetworkMessageSendFlag::eUnreliableNow, "eUnreliableNow"},
+	{NetworkMessageSendFlag::eUnreliableBatched, "eUnreliableBatched"},
+	{NetworkMessageSendFlag::eReliableNow, "eReliableNow"},
+	{NetworkMessageSendFlag::eReliableBatched, "eReliableBatched"},
+};
+constexpr Flag LoopbackFlags[] = {
+	{NetworkMessageSendFlag::eReliableBatched, "eReliableBatched"},
+};
+
+template <typename Pred>
+bool WaitFor(Pred pred, clock::duration timeout)
+{
+	const auto deadline = clock::now() + timeout;
+	while (!pred())
+	{
+		if (clock::now() > deadline)
+			return false;
+		std::this_thread::yield();
+	}
+	return true;
+}
+
+/// Counts data messages and answers the sender, whichever process it is in.
+class Receiver
+{
+   public:
+	/// Acks are sent unasked every this many data messages, the sender queries when it waits.
+	static constexpr uint64_t AckEvery = 32;
+
+	explicit Receiver(Interlink& link) : Link(link)
+	{
+		// Handlers run on the tick thread, the counters need no synchronization
+		Subscription = Link.GetPacketManager().Subscribe<BenchPacket>(
+			[this](const BenchPacket& packet, const PacketManager::PacketInfo& info)
+			{ OnPacket(packet, info.sender); });
+	}
+	~Receiver() { Subscription.Reset(); }
+
+   private:
+	void OnPacket(const BenchPacket& packet, const NetworkIdentity& sender)
+	{
+		switch (packet.Kind)
+		{
+			case BenchKind::eData:
+				Highest = std::max(Highest, packet.Sequence);
+				if (++Received % AckEvery == 0)
+					Ack(sender, 0);
+				break;
+			case BenchKind::eEcho:
+			{
+				thread_local BenchPacket reply;
+				reply.Kind = BenchKind::eEchoReply;
+				reply.Sequence = packet.Sequence;
+				reply.SentAtNs = packet.SentAtNs;
+				reply.Payload = packet.Payload;
+				Link.SendMessage(sender, reply, packet.ReplyFlag);
+			}
+			break;
+			case BenchKind::eQuery:
+				Ack(sender, packet.SentAtNs);
+				break;
+			default:
+				break;
+		}
+	}
+
+	void Ack(const NetworkIdentity& sender, int64_t query)
+	{
+		BenchPacket ack;
+		ack.Kind = BenchKind::eAck;
+		ack.Sequence = Highest;
+		ack.SentAtNs = query;
+		ack.Received = Received;
+		Link.SendMessage(sender, ack, NetworkMessageSendFlag::eReliableNow);
+	}
+
+	Interlink& Link;
+	PacketManager::Subscription Subscription;
+	uint64_t Received = 0;
+	uint64_t Highest = 0;
+};
+
+struct Result
+{
+	const char* Transport;
+	const char* FlagName;
+	size_t PayloadBytes;
+	size_t Fanout;
+	uint64_t Sent = 0;
+	uint64_t Delivered = 0;
+	double MessagesPerSec = 0;
+	double MegabytesPerSec = 0;
+	double RttUs[4] = {};  // p50 p90 p99 p999
+	double RttMaxUs = 0;
+	size_t RttSamples = 0;
+};
+
+/// Drives the receivers and keeps track of what their acks report.
+class Sender
+{
+   public:
+	Sender(Interlink& link, std::vector<NetworkIdentity> receivers)
+		: Link(link), Receivers(std::move(receivers)), Peers(Receivers.size())
+	{
+		for (size_t i = 0; i < Receivers.size(); i++)
+			Index[Receivers[i]] = i;
+		Subscription = Link.GetPacketManager().Subscribe<BenchPacket>(
+			[this](const BenchPacket& packet, const PacketManager::PacketInfo& info)
+			{ OnPacket(packet, info.sender); });
+	}
+	~Sender() { Subscription.Reset(); }
+
+	/// @brief Ask the first n receivers for an ack and wait for every answer.
+	bool Sync(size_t n, clock::duration timeout)
+	{
+		const int64_t query = ++LastQuery;
+		SendQuery(n, query);
+		return WaitFor(
+			[&]
+			{
+				for (size_t i = 0; i < n; i++)
+					if (Peers[i].Answered.load(std::memory_order_acquire) < query)
+						return false;
+				return true;
+			},
+			timeout);
+	}
+
+	void MeasureThroughput(size_t n, NetworkMessageSendFlag flag,
+						   std::chrono::milliseconds duration, uint64_t window, Result& result)
+	{
+		if (!Sync(n, std::chrono::seconds(5)))
+		{
+			std::fprintf(stderr, "Receivers did not answer before the throughput run\n");
+			return;
+		}
+		std::vector<uint64_t> base;
+		for (size_t i = 0; i < n; i++)
+			base.push_back(Peers[i].Received.load(std::memory_order_acquire));
+		auto delivered = [&]
+		{
+			uint64_t total = 0;
+			for (size_t i = 0; i < n; i++)
+				total += Peers[i].Received.load(std::memory_order_acquire) - base[i];
+			return total;
+		};
+		const uint64_t runStart = NextSequence;
+		// A lost message is never acked, what counts is how far behind the slowest receiver is
+		auto acked = [&]
+		{
+			uint64_t least = UINT64_MAX;
+			for (size_t i = 0; i < n; i++)
+				least = std::min(least, Peers[i].Highest.load(std::memory_order_acquire));
+			return std::max(runStart, least + 1);
+		};
+
+		BenchPacket packet;
+		packet.Payload.assign(result.PayloadBytes, 0xAB);
+		const auto start = clock::now();
+		const auto deadline = start + duration;
+		auto lastQuery = start;
+		while (clock::now() < deadline)
+		{
+			if (NextSequence - acked() >= window)
+			{
+				if (const auto now = clock::now(); now - lastQuery > std::chrono::milliseconds(1))
+				{
+					SendQuery(n, 0);
+					lastQuery = now;
+				}
+				std::this_thread::yield();
+				continue;
+			}
+			packet.Sequence = NextSequence++;
+			Send(n, packet, flag);
+		}
+		const uint64_t sent = (NextSequence - runStart) * n;
+
+		// Unreliable flags may lose messages, so the count is final once it stops moving
+		uint64_t count = 0;
+		auto lastProgress = clock::now();
+		const auto settleDeadline = lastProgress + std::chrono::seconds(2);
+		for (int stable = 0; stable < 3 && clock::now() < settleDeadline;)
+		{
+			Sync(n, std::chrono::milliseconds(500));
+			const uint64_t now = delivered();
+			if (now != count)
+			{
+				count = now;
+				lastProgress = clock::now();
+				stable = 0;
+			}
+			else
+				stable++;
+			if (count >= sent)
+				break;
+			std::this_thread::sleep_for(std::chrono::milliseconds(20));
+		}
+		const double seconds = std::chrono::duration<double>(lastProgress - start).count();
+		result.Sent = sent;
+		result.Delivered = count;
+		result.MessagesPerSec = count / seconds;
+		result.MegabytesPerSec = count * double(result.PayloadBytes) / seconds / 1e6;
+	}
+
+	void MeasureRtt(size_t n, NetworkMessageSendFlag flag, std::chrono::milliseconds duration,
+					Result& result)
+	{
+		BenchPacket packet;
+		packet.Kind = BenchKind::eEcho;
+		packet.ReplyFlag = flag;
+		packet.Payload.assign(result.PayloadBytes, 0xCD);
+
+		{
+			std::lock_guard lock(RttMutex);
+			RttNs.clear();
+		}
+		const auto deadline = clock::now() + duration;
+		while (clock::now() < deadline)
+		{
+			const uint64_t expected = Replies.load(std::memory_order_acquire) + n;
+			packet.Sequence++;
+			packet.SentAtNs = NowNs();
+			Send(n, packet, flag);
+			// A lost ping or reply only costs the round, samples come from the reply itself
+			WaitFor([&] { return Replies.load(std::memory_order_acquire) >= expected; },
+					std::chrono::milliseconds(200));
+		}
+
+		std::vector<int64_t> rtt;
+		{
+			std::lock_guard lock(RttMutex);
+			rtt = RttNs;
+		}
+		result.RttSamples = rtt.size();
+		if (rtt.empty())
+			return;
+		std::sort(rtt.begin(), rtt.end());
+		const double quantiles[] = {0.5, 0.9, 0.99, 0.999};
+		for (size_t i = 0; i < 4; i++)
+			result.RttUs[i] =
+				rtt[std::min(rtt.size() - 1, size_t(quantiles[i] * rtt.size()))] / 1e3;
+		result.RttMaxUs = rtt.back() / 1e3;
+	}
+
+   private:
+	struct Peer
+	{
+		std::atomic<uint64_t> Received{0};
+		std::atomic<uint64_t> Highest{0};
+		std::atomic<int64_t> Answered{0};
+	};
+
+	void OnPacket(const BenchPacket& packet, const NetworkIdentity& sender)
+	{
+		if (packet.Kind == BenchKind::eEchoReply)
+		{
+			const int64_t rtt = NowNs() - packet.SentAtNs;
+			std::lock_guard lock(RttMutex);
+			RttNs.push_back(rtt);
+			Replies.fetch_add(1, std::memory_order_release);
+			return;
+		}
+		const auto it = Index.find(sender);
+		if (packet.Kind != BenchKind::eAck || it == Index.end())
+			return;
+		// Acks are reliable, so they arrive in order
+		Peer& peer = Peers[it->second];
+		peer.Received.store(packet.Received, std::memory_order_release);
+		peer.Highest.store(packet.Sequence, std::memory_order_release);
+		if (packet.SentAtNs != 0)
+			peer.Answered.store(packet.SentAtNs, std::memory_order_release);
+	}
+
+	void Send(size_t n, const BenchPacket& packet, NetworkMessageSendFlag flag)
+	{
+		if (n == 1)
+			Link.SendMessage(Receivers[0], packet, flag);
+		else
+			Link.SendMessageToMany(std::span<const NetworkIdentity>(Receivers).first(n), packet,
+								   flag);
+	}
+
+	void SendQuery(size_t n, int64_t query)
+	{
+		BenchPacket packet;
+		packet.Kind = BenchKind::eQuery;
+		packet.SentAtNs = query;
+		Send(n, packet, NetworkMessageSendFlag::eReliableNow);
+	}
+
+	Interlink& Link;
+	std::vector<NetworkIdentity> Receivers;
+	std::unordered_map<NetworkIdentity, size_t> Index;
+	std::vector<Peer> Peers;
+	PacketManager::Subscription Subscription;
+	uint64_t NextSequence = 1;
+	int64_t LastQuery = 0;
+	std::atomic<uint64_t> Replies{0};
+	std::mutex RttMutex;
+	std::vector<int64_t> RttNs;
+};
+
+struct Options
+{
+	std::chrono::milliseconds Duration{500};
+	uint64_t Window = 256;
+	std::vector<size_t> Sizes = {16, 256, 4096, 65536, 262144};
+	std::vector<size_t> Fanouts = {1, 2, 4, 8};
+	uint16_t Port = 27950;
+	bool Json = false;
+};
+
+void Print(const Result& r, bool json)
+{
+	if (json)
+	{
+		std::printf(
+			"{\"transport\":\"%s\",\"flag\":\"%s\",\"payload_bytes\":%zu,\"fanout\":%zu,"
+			"\"sent\":%llu,\"delivered\":%llu,\"msgs_per_sec\":%.0f,\"mb_per_sec\":%.2f,"
+			"\"rtt_samples\":%zu,\"rtt_p50_us\":%.1f,\"rtt_p90_us\":%.1f,\"rtt_p99_us\":%.1f,"
+			"\"rtt_p999_us\":%.1f,\"rtt_max_us\":%.1f}\n",
+			r.Transport, r.FlagName, r.PayloadBytes, r.Fanout, (unsigned long long)r.Sent,
+			(unsigned long long)r.Delivered, r.MessagesPerSec, r.MegabytesPerSec, r.RttSamples,
+			r.RttUs[0], r.RttUs[1], r.RttUs[2], r.RttUs[3], r.RttMaxUs);
+	}
+	else
+	{
+		std::printf("%s,%s,%zu,%zu,%llu,%llu,%.0f,%.2f,%zu,%.1f,%.1f,%.1f,%.1f,%.1f\n",
+					r.Transport, r.FlagName, r.PayloadBytes, r.Fanout,
+					(unsigned long long)r.Sent, (unsigned long long)r.Delivered,
+					r.MessagesPerSec, r.MegabytesPerSec, r.RttSamples, r.RttUs[0], r.RttUs[1],
+					r.RttUs[2], r.RttUs[3], r.RttMaxUs);
+	}
+	std::fflush(stdout);
+}
+
+template <size_t N>
+void Sweep(Sender& sender, const char* transport, const Flag (&flags)[N], const Options& options)
+{
+	for (const Flag& flag : flags)
+	{
+		for (size_t size : options.Sizes)
+		{
+			for (size_t fanout : options.Fanouts)
+			{
+				Result result{.Transport = transport,
+							  .FlagName = flag.Name,
+							  .PayloadBytes = size,
+							  .Fanout = fanout};
+				sender.MeasureThroughput(fanout, flag.Value, options.Duration, options.Window,
+										 result);
+				sender.MeasureRtt(fanout, flag.Value, options.Duration, result);
+				Print(result, options.Json);
+			}
+		}
+	}
+}
+
+InterlinkProperties NetworkProperties(const NetworkIdentity& id, uint16_t port)
+{
+	IPAddress address;
+	address.Parse("127.0.0.1:" + std::to_string(port));
+	return InterlinkProperties{.ThisID = id,
+							   .Transport = InterlinkTransportMode::eNetwork,
+							   .ListenPort = port,
+							   .AdvertiseAddress = address};
+}
+
+void RunLoopback(size_t receivers, const Options& options)
+{
+	auto make = []
+	{
+		auto link = std::make_unique<Interlink>();
+		link->Init(InterlinkProperties{.ThisID = NetworkIdentity::MakeIDShard(UUIDGen::Gen()),
+									   .Transport = InterlinkTransportMode::eLoopbackOnly});
+		return link;
+	};
+	std::vector<std::unique_ptr<Interlink>> links;
+	std::vector<std::unique_ptr<Receiver>> served;
+	std::vector<NetworkIdentity> ids;
+	for (size_t i = 0; i < receivers; i++)
+	{
+		links.push_back(make());
+		served.push_back(std::make_unique<Receiver>(*links.back()));
+		ids.push_back(links.back()->GetID());
+	}
+	auto senderLink = make();
+	{
+		Sender sender(*senderLink, ids);
+		Sweep(sender, "loopback", LoopbackFlags, options);
+	}
+	senderLink->Shutdown();
+	served.clear();
+	for (const auto& link : links)
+		link->Shutdown();
+}
+
+std::atomic_bool Stop = false;
+
+/// A receiver process of the gns transport, until the sender stops it or goes away.
+int RunReceiverProcess(const NetworkIdentity& id, uint16_t port)
+{
+	const pid_t parent = getppid();
+	signal(SIGTERM, [](int) { Stop = true; });
+	Interlink& link = Interlink::Get();
+	link.Init(NetworkProperties(id, port));
+	{
+		Receiver receiver(link);
+		while (!Stop && getppid() == parent)
+			std::this_thread::sleep_for(std::chrono::milliseconds(50));
+	}
+	link.Shutdown();
+	ServerRegistry::Get().DeRegisterSelf(id);
+	return 0;
+}
+
+bool RunNetwork(size_t receivers, const Options& options)
+{
+	std::vector<NetworkIdentity> ids;
+	std::vector<pid_t> children;
+	for (size_t i = 0; i < receivers; i++)
+	{
+		ids.push_back(NetworkIdentity::MakeIDShard(UUIDGen::Gen()));
+		const std::string uuid = UUIDGen::ToString(ids.back().ID);
+		const std::string port = std::to_string(options.Port + 1 + i);
+		const pid_t pid = fork();
+		if (pid == 0)
+		{
+			execl("/proc/self/exe", "InterlinkBench", "--receiver", uuid.c_str(), "--port",
+				  port.c_str(), (char*)nullptr);
+			_exit(127);
+		}
+		if (pid > 0)
+			children.push_back(pid);
+	}
+
+	const NetworkIdentity self = NetworkIdentity::MakeIDShard(UUIDGen::Gen());
+	Interlink& link = Interlink::Get();
+	link.Init(NetworkProperties(self, options.Port));
+	bool ok = WaitFor(
+		[&]
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(50));
+			return std::all_of(ids.begin(), ids.end(), [](const NetworkIdentity& id)
+							   { return ServerRegistry::Get().ExistsInRegistry(id); });
+		},
+		std::chrono::seconds(10));
+	{
+		Sender sender(link, ids);
+		// The first sync dials every receiver
+		ok = ok && sender.Sync(receivers, std::chrono::seconds(10));
+		if (ok)
+			Sweep(sender, "gns", Flags, options);
+		else
+			std::fprintf(stderr, "gns receivers did not come up\n");
+	}
+
+	for (pid_t child : children)
+		kill(child, SIGTERM);
+	for (pid_t child : children)
+		waitpid(child, nullptr, 0);
+	link.Shutdown();
+	ServerRegistry::Get().DeRegisterSelf(self);
+	return ok;
+}
+
+std::vector<size_t> ParseList(const char* arg)
+{
+	std::vector<size_t> out;
+	for (const char* p = arg; *p;)
+	{
+		char* end;
+		const size_t value = std::strtoul(p, &end, 10);
+		if (end == p)
+			break;
+		out.push_back(value);
+		p = *end == ',' ? end + 1 : end;
+	}
+	return out;
+}
+
+std::vector<std::string> ParseNames(const char* list)
+{
+	std::vector<std::string> out;
+	std::string current;
+	for (const char* c = list; *c; c++)
+	{
+		if (*c == ',')
+		{
+			out.push_back(std::move(current));
+			current.clear();
+		}
+		else
+			current.push_back(*c);
+	}
+	if (!current.empty())
+		out.push_back(std::move(current));
+	return out;
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+	Options options;
+	std::vector<std::string> transports = {"gns", "loopback"};
+	std::string receiverOf;
+	for (int i = 1; i < argc; i++)
+	{
+		const std::string_view arg = argv[i];
+		const char* value = i + 1 < argc ? argv[i + 1] : "";
+		if (arg == "--json")
+			options.Json = true;
+		else if (arg == "--ms" && ++i < argc)
+			options.Duration = std::chrono::milliseconds(std::strtoul(value, nullptr, 10));
+		else if (arg == "--window" && ++i < argc)
+			options.Window = std::max<uint64_t>(1, std::strtoull(value, nullptr, 10));
+		else if (arg == "--sizes" && ++i < argc)
+			options.Sizes = ParseList(value);
+		else if (arg == "--fanout" && ++i < argc)
+			options.Fanouts = ParseList(value);
+		else if (arg == "--port" && ++i < argc)
+			options.Port = (uint16_t)std::strtoul(value, nullptr, 10);
+		else if (arg == "--transports" && ++i < argc)
+			transports = ParseNames(value);
+		// Internal, how gns receiver processes are started
+		else if (arg == "--receiver" && ++i < argc)
+			receiverOf = value;
+		else
+		{
+			std::fprintf(stderr,
+						 "usage: %s [--transports gns,loopback] [--ms N] [--window N] "
+						 "[--sizes a,b,..] [--fanout a,b,..] [--port N] [--json]\n",
+						 argv[0]);
+			return 1;
+		}
+	}
+	Log::SetLevel(Log::Level::Warning);
+	Log::InitFromEnv();
+
+	if (!receiverOf.empty())
+		return RunReceiverProcess(
+			NetworkIdentity::MakeIDShard(boost::uuids::string_generator()(receiverOf)),
+			options.Port);
+
+	std::erase(options.Fanouts, 0);
+	const size_t maxFanout =
+		options.Fanouts.empty()
+			? 0
+			: *std::max_element(options.Fanouts.begin(), options.Fanouts.end());
+	if (!options.Json)
+		std::printf(
+			"transport,flag,payload_bytes,fanout,sent,delivered,msgs_per_sec,mb_per_sec,"
+			"rtt_samples,rtt_p50_us,rtt_p90_us,rtt_p99_us,rtt_p999_us,rtt_max_us\n");
+	int status = 0;
+	for (const std::string& transport : transports)
+	{
+		if (transport == "loopback")
+			RunLoopback(maxFanout, options);
+		else if (transport == "gns")
+			status |= RunNetwork(maxFanout, options) ? 0 : 1;
+		else
+			std::fprintf(stderr, "Unknown transport %s\n", transport.c_str());
+	}
+	return status;
+}
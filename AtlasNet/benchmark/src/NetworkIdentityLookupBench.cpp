@@ -0,0 +1,82 @@
+// Connection table lookup cost by NetworkIdentity.
+// "legacy" reproduces the old table: an ordered index compared through ToString().
+// "hashed" is the table Interlink uses now: a hashed index over the packed type + UUID.
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "Global/Misc/UUID.hpp"
+#include "Global/pch.hpp"
+#include "Network/NetworkIdentity.hpp"
+
+namespace
+{
+struct Entry
+{
+	NetworkIdentity target;
+	int handle = 0;
+};
+struct LegacyLess
+{
+	bool operator()(const NetworkIdentity& a, const NetworkIdentity& b) const
+	{
+		return a.ToString() < b.ToString();
+	}
+};
+using LegacyTable = boost::multi_index_container<
+	Entry, boost::multi_index::indexed_by<boost::multi_index::ordered_non_unique<
+			   boost::multi_index::member<Entry, NetworkIdentity, &Entry::target>, LegacyLess>>>;
+using HashedTable = boost::multi_index_container<
+	Entry, boost::multi_index::indexed_by<boost::multi_index::hashed_non_unique<
+			   boost::multi_index::member<Entry, NetworkIdentity, &Entry::target>>>>;
+
+template <typename Table>
+double NanosPerLookup(const Table& table, const std::vector<NetworkIdentity>& queries,
+					  size_t rounds)
+{
+	using clock = std::chrono::steady_clock;
+	size_t found = 0;
+	const auto start = clock::now();
+	for (size_t r = 0; r < rounds; r++)
+		for (const NetworkIdentity& id : queries)
+			found += table.find(id) != table.end();
+	const auto elapsed = clock::now() - start;
+	if (found != rounds * queries.size())
+		std::fprintf(stderr, "lookup missed %zu entries\n", rounds * queries.size() - found);
+	return std::chrono::duration<double, std::nano>(elapsed).count() /
+		   double(rounds * queries.size());
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+	const size_t connections = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 256;
+	const size_t rounds = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 200;
+
+	std::vector<NetworkIdentity> ids;
+	ids.reserve(connections);
+	for (size_t i = 0; i < connections; i++)
+		ids.push_back(i % 8 == 0 ? NetworkIdentity::MakeIDGameClient(UUIDGen::Gen())
+								 : NetworkIdentity::MakeIDShard(UUIDGen::Gen()));
+
+	LegacyTable legacy;
+	HashedTable hashed;
+	for (size_t i = 0; i < ids.size(); i++)
+	{
+		legacy.insert(Entry{ids[i], int(i)});
+		hashed.insert(Entry{ids[i], int(i)});
+	}
+
+	std::vector<NetworkIdentity> queries = ids;
+	std::shuffle(queries.begin(), queries.end(), std::mt19937(1234));
+
+	const double legacyNs = NanosPerLookup(legacy, queries, rounds);
+	const double hashedNs = NanosPerLookup(hashed, queries, rounds);
+
+	std::printf("connections,legacy_ns_per_lookup,hashed_ns_per_lookup,speedup\n");
+	std::printf("%zu,%.1f,%.1f,%.1fx\n", connections, legacyNs, hashedNs, legacyNs / hashedNs);
+	return 0;
+}
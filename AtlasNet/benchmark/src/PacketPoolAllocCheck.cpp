@@ -0,0 +1,304 @@
+// Heap allocations on the packet receive path once it is warm.
+// Decodes a packet with PacketRegistry::AcquireFromBytes and dispatches it the way
+// Interlink::Deliver does, counting every operator new in between:
+//  - inline: handlers run on the receiving thread, must not allocate at all. Checked for a
+//    synthetic packet and for library packets whose payload lives in a std::variant
+//    (an EntityTransferPacket commit, a LocalEntityListRequestPacket response)
+//  - workers: an eWorkerPool type through PacketDispatchExecutor lanes. The packet is released on
+//    the worker and has to find its way back to the receiving thread's pool, the lane's queue
+//    node is the one allocation allowed per packet.
+// Exits non-zero when a mode allocates more than that.
+// Usage: PacketPoolAllocCheck [--packets N] [--warmup N] [--workers N]
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "Entity/Packet/EntityTransferPacket.hpp"
+#include "Entity/Packet/LocalEntityListRequestPacket.hpp"
+#include "Global/Misc/UUID.hpp"
+#include "Global/Serialize/ByteReader.hpp"
+#include "Global/Serialize/ByteWriter.hpp"
+#include "Network/NetworkIdentity.hpp"
+#include "Network/Packet/Packet.hpp"
+#include "Network/Packet/PacketDispatchExecutor.hpp"
+#include "Network/Packet/PacketManager.hpp"
+#include "Network/Packet/PacketMetrics.hpp"
+
+namespace
+{
+std::atomic<uint64_t> Allocations{0};
+
+void* Allocate(std::size_t size)
+{
+	Allocations.fetch_add(1, std::memory_order_relaxed);
+	if (void* p = std::malloc(size ? size : 1))
+		return p;
+	throw std::bad_alloc();
+}
+
+void* AllocateAligned(std::size_t size, std::align_val_t align)
+{
+	Allocations.fetch_add(1, std::memory_order_relaxed);
+	const std::size_t alignment = static_cast<std::size_t>(align);
+	if (void* p = std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment))
+		return p;
+	throw std::bad_alloc();
+}
+}  // namespace
+
+void* operator new(std::size_t size)
+{
+	return Allocate(size);
+}
+void* operator new[](std::size_t size)
+{
+	return Allocate(size);
+}
+void* operator new(std::size_t size, std::align_val_t align)
+{
+	return AllocateAligned(size, align);
+}
+void* operator new[](std::size_t size, std::align_val_t align)
+{
+	return AllocateAligned(size, align);
+}
+void operator delete(void* p) noexcept
+{
+	std::free(p);
+}
+void operator delete[](void* p) noexcept
+{
+	std::free(p);
+}
+void operator delete(void* p, std::size_t) noexcept
+{
+	std::free(p);
+}
+void operator delete[](void* p, std::size_t) noexcept
+{
+	std::free(p);
+}
+void operator delete(void* p, std::align_val_t) noexcept
+{
+	std::free(p);
+}
+void operator delete[](void* p, std::align_val_t) noexcept
+{
+	std::free(p);
+}
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept
+{
+	std::free(p);
+}
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept
+{
+	std::free(p);
+}
+
+namespace
+{
+template <typename Derived, FixedString Name>
+class AllocCheckPacketBase : public TPacket<Derived, Name>
+{
+   public:
+	uint64_t Sequence = 0;
+	std::vector<uint8_t> Payload;
+
+   private:
+	void SerializeData(ByteWriter& bw) const override
+	{
+		bw.u64(Sequence);
+		bw.blob(std::span(Payload));
+	}
+	// Reuses the instance's buffer, as pooled packets are meant to
+	void DeserializeData(ByteReader& br) override
+	{
+		Sequence = br.u64();
+		const auto blob = br.blob();
+		Payload.assign(blob.begin(), blob.end());
+	}
+	bool ValidateData() const override { return true; }
+};
+
+class AllocCheckPacket : public AllocCheckPacketBase<AllocCheckPacket, "AllocCheckPacket">
+{
+};
+ATLASNET_REGISTER_PACKET(AllocCheckPacket, "AllocCheckPacket");
+
+class AllocCheckWorkerPacket
+	: public AllocCheckPacketBase<AllocCheckWorkerPacket, "AllocCheckWorkerPacket">
+{
+   public:
+	static constexpr PacketDispatchPolicy DispatchPolicy = PacketDispatchPolicy::eWorkerPool;
+};
+ATLASNET_REGISTER_PACKET(AllocCheckWorkerPacket, "AllocCheckWorkerPacket");
+
+struct Options
+{
+	uint64_t Packets = 100000;
+	uint64_t Warmup = 1000;
+	uint32_t Workers = 2;
+};
+
+std::vector<uint8_t> Encode(const IPacket& packet)
+{
+	ByteWriter bw;
+	packet.Serialize(bw);
+	return std::vector<uint8_t>(bw.bytes().begin(), bw.bytes().end());
+}
+
+/// @return Allocations while the timed packets were received and handled.
+template <typename Receive, typename Settle>
+uint64_t CountAllocations(const Options& options, Receive&& receive, Settle&& settle)
+{
+	for (uint64_t i = 0; i < options.Warmup; i++)
+		receive();
+	settle();
+	const uint64_t before = Allocations.load(std::memory_order_relaxed);
+	for (uint64_t i = 0; i < options.Packets; i++)
+		receive();
+	settle();
+	return Allocations.load(std::memory_order_relaxed) - before;
+}
+
+bool Report(const char* mode, const Options& options, uint64_t allocated, uint64_t allowed)
+{
+	std::printf("%s,%llu,%llu,%llu\n", mode, (unsigned long long)options.Packets,
+				(unsigned long long)allocated, (unsigned long long)allowed);
+	if (allocated <= allowed)
+		return true;
+	std::fprintf(stderr, "%s: receive path allocated %llu times over %llu packets, %llu allowed\n",
+				 mode, (unsigned long long)allocated, (unsigned long long)options.Packets,
+				 (unsigned long long)allowed);
+	return false;
+}
+
+template <typename T>
+bool CheckInline(const char* mode, const T& source, const Options& options,
+				 const PacketManager::PacketInfo& info)
+{
+	const std::vector<uint8_t> bytes = Encode(source);
+
+	PacketManager manager;
+	uint64_t handled = 0;
+	PacketManager::Subscription subscription = manager.Subscribe<T>(
+		[&handled](const T&, const PacketManager::PacketInfo&) { handled++; });
+	const PacketRegistry& registry = PacketRegistry::Get();
+
+	const uint64_t allocated = CountAllocations(
+		options,
+		[&]
+		{
+			PooledPacket packet = registry.AcquireFromBytes(bytes);
+			PacketMetrics::RecordReceive(packet->GetPacketType(), bytes.size(), 0);
+			manager.Dispatch(*packet, packet->GetPacketType(), info);
+		},
+		[] {});
+	return Report(mode, options, allocated, 0);
+}
+
+AtlasEntity MakeEntity()
+{
+	AtlasEntity entity;
+	entity.Entity_ID = AtlasEntityMinimal::CreateUniqueID();
+	// Past the inline capacity, so reuse of the decoded entities is what keeps this off the heap
+	entity.Metadata.assign(64, 0x5A);
+	return entity;
+}
+
+bool CheckLibraryPackets(const Options& options, const PacketManager::PacketInfo& info)
+{
+	EntityTransferPacket commit;
+	commit.TransferID = UUIDGen::Gen();
+	commit.stage = EntityTransferPacket::TransferStage::eCommit;
+	auto& commitData = commit.Data.emplace<EntityTransferPacket::CommitStageData>();
+	for (uint64_t i = 0; i < 4; i++)
+		commitData.entitySnapshots.push_back({.Snapshot = MakeEntity(), .Generation = i});
+
+	LocalEntityListRequestPacket response;
+	response.status = LocalEntityListRequestPacket::MsgStatus::eResponse;
+	response.Request_IncludeMetadata = true;
+	auto& entities = response.Response_Entities.emplace<std::vector<AtlasEntity>>();
+	for (int i = 0; i < 64; i++)
+		entities.push_back(MakeEntity());
+
+	const bool commitOk = CheckInline("inline-entity-transfer", commit, options, info);
+	return CheckInline("inline-entity-list", response, options, info) && commitOk;
+}
+
+bool CheckWorkers(const Options& options, const PacketManager::PacketInfo& info)
+{
+	AllocCheckWorkerPacket source;
+	source.Sequence = 1;
+	source.Payload.assign(200, 0x5A);
+	const std::vector<uint8_t> bytes = Encode(source);
+
+	PacketManager manager;
+	std::atomic<uint64_t> handled{0};
+	PacketManager::Subscription subscription = manager.Subscribe<AllocCheckWorkerPacket>(
+		[&handled](const AllocCheckWorkerPacket& packet, const PacketManager::PacketInfo&)
+		{ handled.fetch_add(packet.Sequence, std::memory_order_release); });
+	PacketDispatchExecutor executor(manager);
+	executor.Start(options.Workers);
+	const PacketRegistry& registry = PacketRegistry::Get();
+
+	// Kept well under PoolCapacity, so neither side of the pool ever has to free or allocate
+	constexpr uint64_t MaxInFlight = 16;
+	uint64_t dispatched = 0;
+	auto wait = [&](uint64_t inFlight)
+	{
+		while (dispatched - handled.load(std::memory_order_acquire) > inFlight)
+			std::this_thread::yield();
+	};
+	const uint64_t allocated = CountAllocations(
+		options,
+		[&]
+		{
+			wait(MaxInFlight);
+			PooledPacket packet = registry.AcquireFromBytes(bytes);
+			PacketMetrics::RecordReceive(packet->GetPacketType(), bytes.size(), 0);
+			executor.Dispatch(std::move(packet), info);
+			dispatched++;
+		},
+		[&] { wait(0); });
+	executor.Stop();
+	return Report("workers", options, allocated, options.Packets);
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+	Options options;
+	for (int i = 1; i < argc; i++)
+	{
+		const std::string_view arg = argv[i];
+		const char* value = i + 1 < argc ? argv[i + 1] : "";
+		if (arg == "--packets" && ++i < argc)
+			options.Packets = std::strtoull(value, nullptr, 10);
+		else if (arg == "--warmup" && ++i < argc)
+			options.Warmup = std::strtoull(value, nullptr, 10);
+		else if (arg == "--workers" && ++i < argc)
+			options.Workers = (uint32_t)std::strtoul(value, nullptr, 10);
+		else
+		{
+			std::fprintf(stderr, "usage: %s [--packets N] [--warmup N] [--workers N]\n",
+						 argv[0]);
+			return 2;
+		}
+	}
+
+	const PacketManager::PacketInfo info{.sender = NetworkIdentity::MakeIDShard(UUIDGen::Gen())};
+	std::printf("mode,packets,allocations,allowed\n");
+	AllocCheckPacket source;
+	source.Sequence = 42;
+	source.Payload.assign(200, 0x5A);
+	bool ok = CheckInline("inline", source, options, info);
+	ok = CheckLibraryPackets(options, info) && ok;
+	if (options.Workers > 0)
+		ok = CheckWorkers(options, info) && ok;
+	return ok ? 0 : 1;
+}
@@ -9,6 +9,8 @@ find_package(glm CONFIG REQUIRED)
 find_package(GameNetworkingSockets CONFIG REQUIRED)
 find_package(CURL REQUIRED)
 find_package(ZLIB REQUIRED)
+find_package(lz4 CONFIG REQUIRED)
+find_package(zstd CONFIG REQUIRED)
 find_package(Boost REQUIRED COMPONENTS uuid)
 find_package(Boost REQUIRED COMPONENTS stacktrace_addr2line)
 find_package(Boost REQUIRED COMPONENTS multi_index)
@@ -104,13 +104,20 @@ void ClientLink::Init()
 		{
 			using clock = std::chrono::steady_clock;
 			auto last = clock::now();
+			auto nextReport = last + ReceiveReportInterval;
 
 			while (!st.stop_requested())
 			{
-				Update();
+				const uint32_t received = Update();
+				if (clock::now() >= nextReport)
+				{
+					LogReceiveTelemetry();
+					nextReport = clock::now() + ReceiveReportInterval;
+				}
 
+				// Only back off while idle, a tick that drained messages is followed straight away
 				auto now = clock::now();
-				if (now - last < std::chrono::milliseconds(2))
+				if (received == 0 && now - last < std::chrono::milliseconds(2))
 				{
 					std::this_thread::sleep_for(std::chrono::milliseconds(50));
 				}
@@ -123,34 +130,34 @@ void ClientLink::OnClientIDAssignedPacket(const ClientIDAssignPacket &clientIDPa
 	logger.DebugFormatted("Received packet assigning ID to {} ",
 						  clientIDPacket.AssignedClientID.ToString());
 }
-void ClientLink::ReceiveMessages()
+uint32_t ClientLink::ReceiveMessages()
 {
-	ISteamNetworkingMessage *pIncomingMessages[32];
-	int numMsgs =
-		SteamNetworkingSockets()->ReceiveMessagesOnPollGroup(poll_group, pIncomingMessages, 32);
-
-	for (int i = 0; i < numMsgs; ++i)
-	{
-		ISteamNetworkingMessage *msg = pIncomingMessages[i];
-
-		auto &BySteamCon = Connections.get<IndexByHSteamNetConnection>();
-		ASSERT(BySteamCon.contains(msg->m_conn), "Received message from unregistered connection?");
-		const auto it = BySteamCon.find(msg->m_conn);
+	const ReceiveDrainStats stats = Receiver.Drain(
+		SteamNetworkingSockets(), poll_group,
+		[&](ISteamNetworkingMessage *msg)
+		{
+			auto &BySteamCon = Connections.get<IndexByHSteamNetConnection>();
+			ASSERT(BySteamCon.contains(msg->m_conn),
+				   "Received message from unregistered connection?");
+			const auto it = BySteamCon.find(msg->m_conn);
 
-		const Connection &connection = *it;
+			const Connection &connection = *it;
 
-		const void *data = msg->m_pData;
-		size_t size = msg->m_cbSize;
+			const void *data = msg->m_pData;
+			size_t size = msg->m_cbSize;
 
-		// Normal internal dispatch
-		std::span<const uint8_t> span = std::span<const uint8_t>((uint8_t *)data, size);
-		const auto packet = PacketRegistry::Get().CreateFromBytes(span);
-		logger.DebugFormatted("Arrived Packet of type {}. Dispatching...", packet->GetPacketName());
-		packet_manager.Dispatch(*packet, packet->GetPacketType(),
-								PacketManager::PacketInfo{.sender = connection.target});
+			// Normal internal dispatch
+			std::span<const uint8_t> span = std::span<const uint8_t>((uint8_t *)data, size);
+			const auto packet = PacketRegistry::Get().AcquireFromBytes(span);
+			logger.DebugFormatted("Arrived Packet of type {}. Dispatching...",
+								  packet->GetPacketName());
+			packet_manager.Dispatch(*packet, packet->GetPacketType(),
+									PacketManager::PacketInfo{.sender = connection.target});
 
-		msg->Release();
-	}
+			msg->Release();
+		});
+	ReceiveStats.Record(stats, Receiver.GetBatchSize());
+	return stats.Messages;
 }
 void ClientLink::InitGNS()
 {
@@ -161,10 +168,22 @@ void ClientLink::InitGNS()
 		throw std::runtime_error("fcukc");
 	}
 }
-void ClientLink::Update()
+void ClientLink::LogReceiveTelemetry() const
+{
+	logger.DebugFormatted(
+		"Received {} messages, {} bytes. Batch {}, {} drains over budget, {} left messages behind. "
+		"Messages per drain p50/p99 {}/{}",
+		ReceiveStats.TotalMessages.load(std::memory_order_relaxed),
+		ReceiveStats.TotalBytes.load(std::memory_order_relaxed),
+		ReceiveStats.CurrentBatchSize.load(std::memory_order_relaxed),
+		ReceiveStats.BudgetExhaustedTicks.load(std::memory_order_relaxed),
+		ReceiveStats.LeftMessagesTicks.load(std::memory_order_relaxed),
+		ReceiveStats.MessagesPerTick.Percentile(0.5), ReceiveStats.MessagesPerTick.Percentile(0.99));
+}
+uint32_t ClientLink::Update()
 {
 	SteamNetworkingSockets()->RunCallbacks();
-	ReceiveMessages();
+	return ReceiveMessages();
 }
 void ClientLink::OnConnected(SteamNetConnectionStatusChangedCallback_t *pInfo)
 {
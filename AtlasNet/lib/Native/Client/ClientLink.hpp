@@ -13,6 +13,7 @@
 #include "Network/NetworkIdentity.hpp"
 #include "Network/Packet/Client/ClientIDAssignPacket.hpp"
 #include "Network/Packet/PacketManager.hpp"
+#include "Network/ReceiveDrain.hpp"
 
 class ClientLink : public Singleton<ClientLink>
 {
@@ -24,17 +25,23 @@ class ClientLink : public Singleton<ClientLink>
 		SteamNetConnectionStatusChangedCallback_t* pInfo);
 
 	PacketManager& GetPacketManager() { return packet_manager; }
+	const ReceiveTelemetry& GetReceiveTelemetry() const { return ReceiveStats; }
 
    private:
 	void OnConnected(SteamNetConnectionStatusChangedCallback_t* pInfo);
 	std::jthread TickThread;
-	void Update();
+	uint32_t Update();
 
 	HSteamNetPollGroup poll_group;
 
 	void InitGNS();
 
-	void ReceiveMessages();
+	uint32_t ReceiveMessages();
+	ReceiveDrain Receiver;
+	ReceiveTelemetry ReceiveStats;
+	/// Game clients have no NetworkManifest, the receive counters go to the log instead.
+	static constexpr std::chrono::seconds ReceiveReportInterval{10};
+	void LogReceiveTelemetry() const;
 
 	void OnClientIDAssignedPacket(const ClientIDAssignPacket& clientIDPacket,const PacketManager::PacketInfo&);
 
@@ -64,12 +71,12 @@ class ClientLink : public Singleton<ClientLink>
 										   &Connection::state>>,
 			// non-unique, the reason its non unique is because GameClient on
 			// connection dont have an ID
-			boost::multi_index::ordered_non_unique<
+			boost::multi_index::hashed_non_unique<
 				boost::multi_index::tag<IndexByTarget>,
 				boost::multi_index::member<Connection, NetworkIdentity,
 										   &Connection::target>>,
 			// Unique By HConnection
-			boost::multi_index::ordered_non_unique<
+			boost::multi_index::hashed_non_unique<
 				boost::multi_index::tag<IndexByHSteamNetConnection>,
 				boost::multi_index::member<Connection, HSteamNetConnection,
 										   &Connection::SteamConnection>>>>
@@ -99,3 +99,36 @@ void ClientManifest::__ProxyAddClient(const NetworkIdentity& idProxy,
 	bw.uuid(ID);
 	InternalDB::Get()->SAdd(ProxyID_2_ClientIDs_Set, {bw.as_string_view()});
 }
+
+void ClientManifest::QueueNewProxyClients(RedisBatch& batch, std::span<const Client> clients,
+										  const NetworkIdentity& proxy)
+{
+	ASSERT(proxy.Type == NetworkIdentityType::eProxy, "Proxy must be proxy type");
+	if (clients.empty())
+		return;
+
+	ByteWriter proxyWrite;
+	proxy.Serialize(proxyWrite);
+	const std::string proxyBytes(proxyWrite.as_string_view());
+
+	std::vector<std::string> setIP = {"HSET", ClientID_2_IP_Hashtable};
+	std::vector<std::string> setProxy = {"HSET", ClientID_2_ProxyID_Hashtable};
+	std::vector<std::string> addToProxy = {"SADD", ProxyID_2_ClientIDs_Set};
+	for (const Client& client : clients)
+	{
+		ByteWriter IDWrite;
+		ByteWriter IPWrite;
+		IDWrite.uuid(client.ID);
+		client.ip.Serialize(IPWrite);
+		const std::string id(IDWrite.as_string_view());
+
+		setIP.push_back(id);
+		setIP.emplace_back(IPWrite.as_string_view());
+		setProxy.push_back(id);
+		setProxy.push_back(proxyBytes);
+		addToProxy.push_back(id);
+	}
+	batch.Add(ClientID_2_IP_Hashtable, std::move(setIP));
+	batch.Add(ClientID_2_ProxyID_Hashtable, std::move(setProxy));
+	batch.Add(ProxyID_2_ClientIDs_Set, std::move(addToProxy));
+}
\ No newline at end of file
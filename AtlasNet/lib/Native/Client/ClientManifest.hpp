@@ -1,6 +1,9 @@
 #pragma once
 
+#include <span>
+
 #include "Client.hpp"
+#include "Database/Redis/RedisBatch.hpp"
 #include "Global/Misc/Singleton.hpp"
 #include "Network/IPAddress.hpp"
 #include "Network/NetworkIdentity.hpp"
@@ -26,4 +29,8 @@ class ClientManifest : public Singleton<ClientManifest>
 						 std::vector<ClientID>& clients);
 	std::optional<NetworkIdentity> GetClientProxy(const ClientID& client_ID);
 	void AssignProxyClient(const ClientID& cid, const NetworkIdentity& ID);
+	/// @brief RegisterClient and AssignProxyClient for many clients, as three commands added to
+	/// batch. Only for freshly assigned IDs, there is no previous proxy to take them away from.
+	void QueueNewProxyClients(RedisBatch& batch, std::span<const Client> clients,
+							  const NetworkIdentity& proxy);
 };
\ No newline at end of file
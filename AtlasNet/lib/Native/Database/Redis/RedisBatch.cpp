@@ -0,0 +1,67 @@
+#include "RedisBatch.hpp"
+
+#include <hiredis/hiredis.h>
+#include <sw/redis++/redis++.h>
+
+#include <type_traits>
+#include <unordered_map>
+
+#include "RedisConnection.hpp"
+
+namespace
+{
+template <typename Commands>
+size_t SendPipeline(sw::redis::Pipeline& pipeline, const Commands& commands)
+{
+	for (const auto* c : commands)
+		pipeline.command(c->Args.begin(), c->Args.end());
+
+	// Error replies come back as replies, only a broken connection throws
+	sw::redis::QueuedReplies replies = pipeline.exec();
+	size_t errors = 0;
+	for (size_t i = 0; i < replies.size(); i++)
+	{
+		if (replies.get(i).type == REDIS_REPLY_ERROR)
+			errors++;
+	}
+	return errors;
+}
+}  // namespace
+
+size_t RedisConnection::Execute(RedisBatch& batch) const
+{
+	using Command = RedisBatch::Command;
+	const std::vector<Command> commands = std::move(batch.Commands);
+	batch.Commands.clear();
+	if (commands.empty())
+		return 0;
+
+	return WithSync(
+		[&](auto& r) -> size_t
+		{
+			if constexpr (std::is_same_v<std::decay_t<decltype(r)>, sw::redis::RedisCluster>)
+			{
+				std::unordered_map<std::string_view, std::vector<const Command*>> byKey;
+				for (const Command& c : commands)
+					byKey[c.Key].push_back(&c);
+
+				size_t errors = 0;
+				for (const auto& [key, group] : byKey)
+				{
+					auto pipeline = r.pipeline(key, false);
+					errors += SendPipeline(pipeline, group);
+				}
+				return errors;
+			}
+			else
+			{
+				std::vector<const Command*> all;
+				all.reserve(commands.size());
+				for (const Command& c : commands)
+					all.push_back(&c);
+
+				auto pipeline = r.pipeline(false);
+				return SendPipeline(pipeline, all);
+			}
+		});
+}
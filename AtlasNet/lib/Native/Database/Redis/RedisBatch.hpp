@@ -0,0 +1,34 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Redis commands collected from several writers and sent in one go by
+ * RedisConnection::Execute.
+ * @details A single server gets everything on one pipeline, one round trip no matter how many
+ * commands were added. A cluster routes a pipeline to the node owning one key, so there commands
+ * are grouped by the key they touch and every group is sent on its own pipeline.
+ */
+class RedisBatch
+{
+	friend class RedisConnection;
+	struct Command
+	{
+		std::string Key;
+		std::vector<std::string> Args;
+	};
+	std::vector<Command> Commands;
+
+   public:
+	/// @param key the key the command reads or writes, only used to route it on a cluster.
+	/// @param args the full command, name first. Binary safe.
+	void Add(std::string_view key, std::vector<std::string> args)
+	{
+		Commands.push_back(Command{.Key = std::string(key), .Args = std::move(args)});
+	}
+	[[nodiscard]] size_t Size() const { return Commands.size(); }
+	[[nodiscard]] bool Empty() const { return Commands.empty(); }
+	void Clear() { Commands.clear(); }
+};
@@ -12,6 +12,8 @@
 #include <utility>
 #include <vector>
 
+#include "RedisBatch.hpp"
+
 class RedisConnection
 {
    public:
@@ -546,6 +548,14 @@ class RedisConnection
 	void PublishAsyncCb(std::string_view channel, std::string_view message,
 						ResultCb<int> ok, ErrorCb err = {}) const;
 
+	/**
+	 * @brief Send every command in batch and clear it.
+	 * @details One pipeline on a single server, one per key on a cluster.
+	 * @return how many of the commands Redis answered with an error.
+	 * @throws sw::redis::Error if the connection fails, the batch is cleared regardless.
+	 */
+	size_t Execute(RedisBatch& batch) const;
+
 	/**
 	 * @brief Subscribe to a channel.
 	 * @details Maps to Redis SUBSCRIBE. The callback is called on every message
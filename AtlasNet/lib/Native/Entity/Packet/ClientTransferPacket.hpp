@@ -3,16 +3,22 @@
 #include <cstdint>
 #include <variant>
 
+#include "Client/Client.hpp"
 #include "Entity/Entity.hpp"
 #include "Global/Misc/UUID.hpp"
 #include "Global/Serialize/ByteReader.hpp"
 #include "Global/Serialize/ByteWriter.hpp"
 #include "Network/NetworkIdentity.hpp"
 #include "Network/Packet/Packet.hpp"
+#include "Network/Packet/PacketChannelFrame.hpp"
 
 class ClientTransferPacket : public TPacket<ClientTransferPacket, "ClientTransferPacket">
 {
 	public:
+	// The client is frozen until the transfer completes
+	static constexpr PacketLane Lane = PacketLane::eHandoff;
+	static constexpr PacketCompression Compression = PacketCompression::eLZ4;
+
 	enum class MsgStage	 // A = From Shard, B = To Shard
 	{
 		eShardPrepare,		  // A -> B notify of intent to transfer
@@ -51,10 +57,9 @@ class ClientTransferPacket : public TPacket<ClientTransferPacket, "ClientTransfe
 			entitiesToTransfer.resize(br.u64());
 			for (uint64_t i = 0; i < entitiesToTransfer.size(); i++)
 			{
-				EntityData ed;
+				EntityData& ed = entitiesToTransfer[i];
 				ed.LastEntitySnapshot.Deserialize(br);
 				ed.LastPacketSequence = br.u64();
-				entitiesToTransfer[i] = ed;
 			}
 		}
 	};
@@ -169,9 +174,16 @@ class ClientTransferPacket : public TPacket<ClientTransferPacket, "ClientTransfe
 			uint64_t LastPacketSequence;
 			uint64_t EntityGeneration;
 		};
+		// The client B now owns. A client that just joined arrives this way too, with no A and
+		// usually no entities yet
+		ClientID Client;
+		// Picked by the proxy, addresses the client on the proxy<->B link from now on
+		ChannelID Channel = InvalidChannelID;
 		boost::container::small_vector<EntityData,10> entitiesToTransfer;
 		void Serialize(ByteWriter& bw) const override
 		{
+			bw.uuid(Client);
+			bw.u16(Channel);
 			bw.u64(entitiesToTransfer.size());
 			for (const auto& ed : entitiesToTransfer)
 			{
@@ -182,6 +194,8 @@ class ClientTransferPacket : public TPacket<ClientTransferPacket, "ClientTransfe
 		}
 		void Deserialize(ByteReader& br) override
 		{
+			Client = br.uuid();
+			Channel = br.u16();
 			entitiesToTransfer.resize(br.u64());
 			for (uint64_t i = 0; i < entitiesToTransfer.size(); i++)
 			{
@@ -214,31 +228,31 @@ class ClientTransferPacket : public TPacket<ClientTransferPacket, "ClientTransfe
 	{
 		TransferID = br.uuid();
 		stage = br.read_scalar<MsgStage>();
-		// 3️⃣ Construct correct variant type
+		// 3️⃣ Construct correct variant type, reusing the one a pooled packet already holds
 		switch (stage)
 		{
 			case MsgStage::eShardPrepare:
-				Data.emplace<PrepareStageData>();
+				ReuseAlternative<PrepareStageData>(Data);
 				break;
 
 			case MsgStage::eShardReady:
-				Data.emplace<ReadyStageData>();
+				ReuseAlternative<ReadyStageData>(Data);
 				break;
 
 			case MsgStage::eProxyRequestSwitch:
-				Data.emplace<RequestSwitchStageData>();
+				ReuseAlternative<RequestSwitchStageData>(Data);
 				break;
 
 			case MsgStage::eProxyFreeze:
-				Data.emplace<FreezeStageData>();
+				ReuseAlternative<FreezeStageData>(Data);
 				break;
 
 			case MsgStage::eShardDrained:
-				Data.emplace<DrainedStageData>();
+				ReuseAlternative<DrainedStageData>(Data);
 				break;
 
 			case MsgStage::eProxyTransferActivate:
-				Data.emplace<TransferActivateStageData>();
+				ReuseAlternative<TransferActivateStageData>(Data);
 				break;
 
 			default:
@@ -249,4 +263,3 @@ class ClientTransferPacket : public TPacket<ClientTransferPacket, "ClientTransfe
 	}
 	[[nodiscard]] bool ValidateData() const override { return true; }
 };
-ATLASNET_REGISTER_PACKET(ClientTransferPacket, "ClientTransferPacket");
\ No newline at end of file
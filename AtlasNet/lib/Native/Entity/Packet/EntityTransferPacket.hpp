@@ -9,6 +9,9 @@
 class EntityTransferPacket : public TPacket<EntityTransferPacket, "EntityTransferPacket">
 {
     public:
+	static constexpr PacketLane Lane = PacketLane::eHandoff;
+	static constexpr PacketCompression Compression = PacketCompression::eLZ4;
+
 	enum class TransferStage
 	{
 		ePrepare,	// A -> B notify to prepare to receive certain entities
@@ -85,10 +88,9 @@ class EntityTransferPacket : public TPacket<EntityTransferPacket, "EntityTransfe
 			entitySnapshots.resize(br.u64());
 			for (uint64_t i = 0; i < entitySnapshots.size(); i++)
 			{
-				Data d;
+				Data& d = entitySnapshots[i];
 				d.Snapshot.Deserialize(br);
 				d.Generation = br.u64();
-				entitySnapshots[i] = d;
 			}
 		}
 	};
@@ -130,19 +132,19 @@ class EntityTransferPacket : public TPacket<EntityTransferPacket, "EntityTransfe
 		switch (stage)
 		{
 			case TransferStage::ePrepare:
-				Data.emplace<PrepareStageData>();
+				ReuseAlternative<PrepareStageData>(Data);
 				break;
 
 			case TransferStage::eReady:
-				Data.emplace<ReadyStageData>();
+				ReuseAlternative<ReadyStageData>(Data);
 				break;
 
 			case TransferStage::eCommit:
-				Data.emplace<CommitStageData>();
+				ReuseAlternative<CommitStageData>(Data);
 				break;
 
 			case TransferStage::eComplete:
-				Data.emplace<CompleteStageData>();
+				ReuseAlternative<CompleteStageData>(Data);
 				break;
 
 			default:
@@ -153,4 +155,3 @@ class EntityTransferPacket : public TPacket<EntityTransferPacket, "EntityTransfe
 	}
 	[[nodiscard]] bool ValidateData() const override { return true; }
 };
-ATLASNET_REGISTER_PACKET(EntityTransferPacket, "EntityTransferPacket");
\ No newline at end of file
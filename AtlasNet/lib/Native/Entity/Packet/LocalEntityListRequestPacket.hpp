@@ -9,6 +9,11 @@ class LocalEntityListRequestPacket
 	: public TPacket<LocalEntityListRequestPacket, "LocalEntityListRequestPacket">
 {
     public:
+	// Responses copy and serialize the whole ledger, keep that off the network thread
+	static constexpr PacketDispatchPolicy DispatchPolicy = PacketDispatchPolicy::eWorkerPool;
+	static constexpr PacketLane Lane = PacketLane::eBulk;
+	static constexpr PacketCompression Compression = PacketCompression::eZstd;
+
 	enum MsgStatus
 	{
 		eQuery,
@@ -41,27 +46,22 @@ class LocalEntityListRequestPacket
 		size_t entityCount = br.u64();
 		if (Request_IncludeMetadata)
 		{
-			auto& vecA = Response_Entities.emplace<std::vector<AtlasEntity>>();
-			vecA.reserve(entityCount);
-			// Fill vecA
-			for (int i = 0; i < entityCount; i++)
+			auto& vecA = ReuseAlternative<std::vector<AtlasEntity>>(Response_Entities);
+			// Fill vecA in place, keeping the capacity of the last response
+			vecA.resize(entityCount);
+			for (AtlasEntity& e : vecA)
 			{
-				AtlasEntity e;
 				e.Deserialize(br);
-				vecA.push_back(e);
 			}
 		}
 		else
 		{
-			auto& vecB = Response_Entities.emplace<std::vector<AtlasEntityMinimal>>();
-			// Fill vecB
-			vecB.reserve(entityCount);
-
-			for (int i = 0; i < entityCount; i++)
+			auto& vecB = ReuseAlternative<std::vector<AtlasEntityMinimal>>(Response_Entities);
+			// Fill vecB in place, keeping the capacity of the last response
+			vecB.resize(entityCount);
+			for (AtlasEntityMinimal& e : vecB)
 			{
-				AtlasEntityMinimal e;
 				e.Deserialize(br);
-				vecB.push_back(e);
 			}
 		}
 	}
@@ -86,4 +86,3 @@ class LocalEntityListRequestPacket
 		return false;  // any other status
 	}
 };
-ATLASNET_REGISTER_PACKET(LocalEntityListRequestPacket, "LocalEntityListRequestPacket");
\ No newline at end of file
@@ -8,6 +8,7 @@
 #include <unordered_map>
 #include <unordered_set>
 
+#include "Database/Redis/RedisBatch.hpp"
 #include "Debug/Log.hpp"
 #include "Events/EventEnums.hpp"
 // #include "Events/EventSubscriber.hpp"
@@ -121,6 +122,22 @@ class EventSystem : public Singleton<EventSystem>
 		InternalDB::Get()->Publish(eventName, bw.as_string_view());
 		logger.DebugFormatted("Event {} dispatched", eventName);
 	}
+	/// @brief Like Dispatch, but the publish is added to batch and goes out when it is executed.
+	template <typename T>
+		requires std::is_base_of_v<IEvent, T>
+	void QueueDispatch(RedisBatch& batch, const T& event)
+	{
+		ASSERT(EventSystemInit.load(std::memory_order_acquire),
+			   "Event System has not been initialized");
+
+		const std::string_view eventName =
+			EventRegistry::Get().GetEventName<T>();
+
+		ByteWriter bw;
+		event.Serialize(bw);
+		batch.Add(eventName, {"PUBLISH", std::string(eventName),
+							  std::string(bw.as_string_view())});
+	}
 
    private:
 	void Update() { redisSubscriber.consume(); }
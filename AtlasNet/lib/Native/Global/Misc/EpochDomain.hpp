@@ -0,0 +1,170 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <vector>
+
+#include "Global/pch.hpp"
+
+/**
+ * @brief Epoch based deferred reclamation for read-mostly data published through an atomic pointer.
+ * @details Readers wrap their access in a Guard, which only publishes the current epoch into the
+ * calling thread's slot: no lock, no allocation. Writers swap in a new version and Retire the old
+ * one, which is destroyed once every reader that could still see it has left its guard. Guards
+ * nest on the same thread.
+ */
+class EpochDomain
+{
+   public:
+	static constexpr size_t MaxThreads = 256;
+
+	class Guard
+	{
+	   public:
+		explicit Guard(EpochDomain& domain) : Domain(&domain), Slot(ThisThreadSlot())
+		{
+			Domain->EnterSlot(Slot);
+		}
+		Guard(const Guard&) = delete;
+		Guard& operator=(const Guard&) = delete;
+		~Guard() { Domain->ExitSlot(Slot); }
+
+	   private:
+		EpochDomain* Domain;
+		size_t Slot;
+	};
+
+	EpochDomain() = default;
+	EpochDomain(const EpochDomain&) = delete;
+	EpochDomain& operator=(const EpochDomain&) = delete;
+	~EpochDomain()
+	{
+		// No readers can be left once the owner is being destroyed
+		for (auto& r : Retired) r.Destroy();
+	}
+
+	[[nodiscard]] Guard Enter() { return Guard(*this); }
+
+	/// @brief Destroy `destroy` once no reader can still be looking at what it frees.
+	void Retire(std::function<void()> destroy)
+	{
+		std::lock_guard lock(RetireMutex);
+		Retired.push_back({GlobalEpoch.fetch_add(1, std::memory_order_acq_rel), std::move(destroy)});
+		ReclaimLocked();
+	}
+	/// @brief Free everything retired before the oldest active reader.
+	void Reclaim()
+	{
+		std::lock_guard lock(RetireMutex);
+		ReclaimLocked();
+	}
+	[[nodiscard]] size_t PendingReclaim()
+	{
+		std::lock_guard lock(RetireMutex);
+		return Retired.size();
+	}
+
+   private:
+	struct alignas(64) ReaderSlot
+	{
+		std::atomic<uint64_t> Epoch{0};	 // 0 = not reading
+		uint32_t Depth = 0;				 // only touched by the owning thread
+	};
+	struct RetiredEntry
+	{
+		uint64_t Epoch;
+		std::function<void()> Destroy;
+	};
+
+	void EnterSlot(size_t slot)
+	{
+		ReaderSlot& s = Slots[slot];
+		if (s.Depth++ == 0)
+		{
+			s.Epoch.store(GlobalEpoch.load(std::memory_order_acquire), std::memory_order_relaxed);
+			// Make the slot visible before the protected pointer is loaded
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+		}
+	}
+	void ExitSlot(size_t slot)
+	{
+		ReaderSlot& s = Slots[slot];
+		if (--s.Depth == 0)
+			s.Epoch.store(0, std::memory_order_release);
+	}
+	void ReclaimLocked()
+	{
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		uint64_t oldest = std::numeric_limits<uint64_t>::max();
+		for (const ReaderSlot& s : Slots)
+		{
+			const uint64_t e = s.Epoch.load(std::memory_order_acquire);
+			if (e != 0 && e < oldest)
+				oldest = e;
+		}
+		// A reader that entered at epoch E may hold anything retired at epoch >= E
+		std::erase_if(Retired,
+					  [oldest](RetiredEntry& r)
+					  {
+						  if (r.Epoch >= oldest)
+							  return false;
+						  r.Destroy();
+						  return true;
+					  });
+	}
+
+	/// Process wide slot index for the calling thread, handed back when the thread exits.
+	static size_t ThisThreadSlot()
+	{
+		struct SlotOwner
+		{
+			size_t Index;
+			SlotOwner() : Index(AcquireSlotIndex()) {}
+			~SlotOwner() { ReleaseSlotIndex(Index); }
+		};
+		thread_local SlotOwner owner;
+		return owner.Index;
+	}
+	static size_t AcquireSlotIndex()
+	{
+		std::lock_guard lock(SlotIndexMutex());
+		auto& free = FreeSlotIndices();
+		if (!free.empty())
+		{
+			const size_t index = free.back();
+			free.pop_back();
+			return index;
+		}
+		const size_t index = NextSlotIndex()++;
+		ASSERT(index < MaxThreads, "EpochDomain ran out of reader slots");
+		return index;
+	}
+	static void ReleaseSlotIndex(size_t index)
+	{
+		std::lock_guard lock(SlotIndexMutex());
+		FreeSlotIndices().push_back(index);
+	}
+	static std::mutex& SlotIndexMutex()
+	{
+		static std::mutex m;
+		return m;
+	}
+	static std::vector<size_t>& FreeSlotIndices()
+	{
+		static std::vector<size_t> v;
+		return v;
+	}
+	static size_t& NextSlotIndex()
+	{
+		static size_t next = 0;
+		return next;
+	}
+
+	std::atomic<uint64_t> GlobalEpoch{1};
+	std::array<ReaderSlot, MaxThreads> Slots{};
+	std::mutex RetireMutex;
+	std::vector<RetiredEntry> Retired;
+};
@@ -0,0 +1,96 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Lock free power-of-two bucketed histogram.
+ * @details Bucket i holds samples in [2^(i-1), 2^i), bucket 0 holds zero. Safe to record from any
+ * thread, readers get a slightly racy but monotonic view which is fine for telemetry.
+ */
+class LatencyHistogram
+{
+   public:
+	static constexpr size_t BucketCount = 40;
+
+	void Record(uint64_t value) noexcept
+	{
+		const size_t bucket = std::min<size_t>(std::bit_width(value), BucketCount - 1);
+		Buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+		SampleCount.fetch_add(1, std::memory_order_relaxed);
+		SampleSum.fetch_add(value, std::memory_order_relaxed);
+
+		uint64_t prevMax = SampleMax.load(std::memory_order_relaxed);
+		while (prevMax < value &&
+			   !SampleMax.compare_exchange_weak(prevMax, value, std::memory_order_relaxed))
+		{
+		}
+	}
+
+	[[nodiscard]] uint64_t Count() const noexcept
+	{
+		return SampleCount.load(std::memory_order_relaxed);
+	}
+	[[nodiscard]] uint64_t Sum() const noexcept { return SampleSum.load(std::memory_order_relaxed); }
+	[[nodiscard]] uint64_t Max() const noexcept { return SampleMax.load(std::memory_order_relaxed); }
+	[[nodiscard]] uint64_t Mean() const noexcept
+	{
+		const uint64_t count = Count();
+		return count == 0 ? 0 : Sum() / count;
+	}
+	[[nodiscard]] uint64_t BucketValue(size_t bucket) const noexcept
+	{
+		return Buckets[bucket].load(std::memory_order_relaxed);
+	}
+	/// @brief Upper bound of the bucket that contains the given percentile (0..1).
+	[[nodiscard]] uint64_t Percentile(double p) const noexcept
+	{
+		const uint64_t count = Count();
+		if (count == 0)
+			return 0;
+		const uint64_t rank = static_cast<uint64_t>(p * static_cast<double>(count - 1)) + 1;
+		uint64_t seen = 0;
+		for (size_t i = 0; i < BucketCount; i++)
+		{
+			seen += BucketValue(i);
+			if (seen >= rank)
+				return std::min(BucketUpperBound(i), Max());
+		}
+		return Max();
+	}
+	/// @brief Add another histogram's samples into this one, e.g. to sum per thread shards.
+	void Merge(const LatencyHistogram& other) noexcept
+	{
+		for (size_t i = 0; i < BucketCount; i++)
+			Buckets[i].fetch_add(other.BucketValue(i), std::memory_order_relaxed);
+		SampleCount.fetch_add(other.Count(), std::memory_order_relaxed);
+		SampleSum.fetch_add(other.Sum(), std::memory_order_relaxed);
+
+		const uint64_t value = other.Max();
+		uint64_t prevMax = SampleMax.load(std::memory_order_relaxed);
+		while (prevMax < value &&
+			   !SampleMax.compare_exchange_weak(prevMax, value, std::memory_order_relaxed))
+		{
+		}
+	}
+	void Reset() noexcept
+	{
+		for (auto& b : Buckets) b.store(0, std::memory_order_relaxed);
+		SampleCount.store(0, std::memory_order_relaxed);
+		SampleSum.store(0, std::memory_order_relaxed);
+		SampleMax.store(0, std::memory_order_relaxed);
+	}
+	static constexpr uint64_t BucketUpperBound(size_t bucket) noexcept
+	{
+		return bucket == 0 ? 0 : (uint64_t(1) << bucket) - 1;
+	}
+
+   private:
+	std::array<std::atomic<uint64_t>, BucketCount> Buckets{};
+	std::atomic<uint64_t> SampleCount{0};
+	std::atomic<uint64_t> SampleSum{0};
+	std::atomic<uint64_t> SampleMax{0};
+};
@@ -0,0 +1,67 @@
+#pragma once
+#include <atomic>
+#include <optional>
+#include <utility>
+
+/**
+ * @brief Unbounded lock free multi-producer single-consumer queue.
+ * @details Vyukov's node based queue. Push is a single atomic exchange so any number of threads
+ * can produce without contending on a lock. Only one thread may call Pop/Empty. A Pop racing a
+ * Push that has not linked its node yet can report empty, the producer is expected to signal the
+ * consumer after Push returns.
+ */
+template <typename T>
+class MPSCQueue
+{
+	struct Node
+	{
+		std::atomic<Node*> Next{nullptr};
+		std::optional<T> Value;
+	};
+
+   public:
+	MPSCQueue()
+	{
+		Node* stub = new Node();
+		Head.store(stub, std::memory_order_relaxed);
+		Tail = stub;
+	}
+	MPSCQueue(const MPSCQueue&) = delete;
+	MPSCQueue& operator=(const MPSCQueue&) = delete;
+	~MPSCQueue()
+	{
+		while (Pop())
+		{
+		}
+		delete Tail;
+	}
+
+	void Push(T value)
+	{
+		Node* node = new Node();
+		node->Value.emplace(std::move(value));
+		Node* prev = Head.exchange(node, std::memory_order_acq_rel);
+		prev->Next.store(node, std::memory_order_release);
+	}
+
+	/// @brief Consumer only.
+	std::optional<T> Pop()
+	{
+		Node* tail = Tail;
+		Node* next = tail->Next.load(std::memory_order_acquire);
+		if (!next)
+			return std::nullopt;
+		std::optional<T> value = std::move(next->Value);
+		next->Value.reset();
+		Tail = next;
+		delete tail;
+		return value;
+	}
+
+	/// @brief Consumer only.
+	[[nodiscard]] bool Empty() const { return Tail->Next.load(std::memory_order_acquire) == nullptr; }
+
+   private:
+	alignas(64) std::atomic<Node*> Head;
+	alignas(64) Node* Tail;
+};
@@ -0,0 +1,235 @@
+#include "HandshakeService.hpp"
+
+#include <exception>
+#include <string>
+
+#include "Client/ClientManifest.hpp"
+#include "Database/Redis/RedisBatch.hpp"
+#include "Events/EventSystem.hpp"
+#include "Events/Events/Client/ClientEvents.hpp"
+#include "Global/Misc/UUID.hpp"
+#include "Global/Serialize/ByteReader.hpp"
+#include "Heuristic/Database/HeuristicManifest.hpp"
+#include "InternalDB/InternalDB.hpp"
+#include "Interlink/Interlink.hpp"
+#include "Network/NetworkEnums.hpp"
+
+namespace
+{
+uint64_t MicrosecondsBetween(std::chrono::steady_clock::time_point from,
+							 std::chrono::steady_clock::time_point to)
+{
+	return std::chrono::duration_cast<std::chrono::microseconds>(to - from).count();
+}
+}  // namespace
+
+void HandshakeService::Start(const NetworkIdentity& proxy, const HandshakeSettings& settings)
+{
+	ASSERT(proxy.Type == NetworkIdentityType::eProxy, "Clients only connect to proxies");
+	ASSERT(!Worker.joinable(), "HandshakeService already started");
+	Proxy = proxy;
+	Settings = settings;
+	Worker = std::jthread([this](std::stop_token st) { WorkerEntry(st); });
+}
+
+void HandshakeService::Stop()
+{
+	if (!Worker.joinable())
+		return;
+	Worker.request_stop();
+	Worker.join();
+	std::lock_guard lock(Mutex);
+	if (!Pending.empty())
+		logger.WarningFormatted("Stopped with {} clients not onboarded", Pending.size());
+	Pending.clear();
+}
+
+void HandshakeService::OnClientConnect(const Client& c)
+{
+	{
+		std::lock_guard lock(Mutex);
+		Pending.push_back(
+			PendingClient{.client = c, .Connected = std::chrono::steady_clock::now()});
+	}
+	CV.notify_one();
+}
+
+void HandshakeService::WorkerEntry(std::stop_token st)
+{
+	std::vector<PendingClient> batch;
+	while (!st.stop_requested())
+	{
+		{
+			std::unique_lock lock(Mutex);
+			if (!CV.wait(lock, st, [this] { return !Pending.empty(); }))
+				return;
+			// Let the rest of a burst catch up and share the round trips
+			const auto batchEnd = Pending.front().Connected + Settings.BatchWindow;
+			CV.wait_until(lock, st, batchEnd, [] { return false; });
+			if (st.stop_requested())
+				return;
+			batch.swap(Pending);
+		}
+		RunBatch(batch);
+		batch.clear();
+	}
+}
+
+void HandshakeService::RunBatch(std::vector<PendingClient>& batch)
+{
+	const auto start = std::chrono::steady_clock::now();
+	Telemetry.ClientsPerBatch.Record(batch.size());
+	for (const PendingClient& p : batch)
+		Telemetry.QueuedUsec.Record(MicrosecondsBetween(p.Connected, start));
+
+	std::vector<Placement> placements;
+	placements.reserve(batch.size());
+	Resolve(batch, placements);
+	const auto resolved = std::chrono::steady_clock::now();
+	Telemetry.ResolveUsec.Record(MicrosecondsBetween(start, resolved));
+
+	// Shards may look the client up as soon as they hear of it, so the manifest goes first
+	Persist(batch);
+	const auto persisted = std::chrono::steady_clock::now();
+	Telemetry.PersistUsec.Record(MicrosecondsBetween(resolved, persisted));
+
+	Notify(placements);
+	const auto notified = std::chrono::steady_clock::now();
+	Telemetry.NotifyUsec.Record(MicrosecondsBetween(persisted, notified));
+	for (const PendingClient& p : batch)
+		Telemetry.TotalUsec.Record(MicrosecondsBetween(p.Connected, notified));
+}
+
+void HandshakeService::Resolve(const std::vector<PendingClient>& batch,
+							   std::vector<Placement>& out)
+{
+	bool reloaded = false;
+	if (!Heuristic ||
+		std::chrono::steady_clock::now() - HeuristicLoaded > Settings.HeuristicMaxAge)
+	{
+		ReloadHeuristic();
+		reloaded = true;
+	}
+
+	for (const PendingClient& p : batch)
+	{
+		Placement& placement = out.emplace_back(Placement{.Pending = &p, .Shard = std::nullopt});
+		const ClientVerifyReply reply = VerifyClient(p.client);
+		if (reply.status != ClientVerifyStatus::eAccepted)
+		{
+			logger.WarningFormatted("Client {} was not verified", UUIDGen::ToString(p.client.ID));
+			Telemetry.Unplaced.fetch_add(1, std::memory_order_relaxed);
+			continue;
+		}
+
+		placement.Shard = DetermineShard(reply.SpawnWorldLocation);
+		// A bound may have been claimed since the copy was taken
+		if (!placement.Shard && !reloaded)
+		{
+			ReloadHeuristic();
+			reloaded = true;
+			placement.Shard = DetermineShard(reply.SpawnWorldLocation);
+		}
+		logger.DebugFormatted("Client {} Spawn Location {} Target Shard {}",
+							  UUIDGen::ToString(p.client.ID),
+							  reply.SpawnWorldLocation.ToString(),
+							  placement.Shard ? placement.Shard->ToString()
+											  : "UNABLE TO DETERMINE");
+		if (!placement.Shard)
+			Telemetry.Unplaced.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+void HandshakeService::Persist(const std::vector<PendingClient>& batch)
+{
+	std::vector<Client> clients;
+	clients.reserve(batch.size());
+	for (const PendingClient& p : batch)
+		clients.push_back(p.client);
+
+	RedisBatch redisBatch;
+	ClientManifest::Get().QueueNewProxyClients(redisBatch, clients, Proxy);
+	EventSystem& events = EventSystem::Get();
+	for (const Client& client : clients)
+	{
+		ClientConnectEvent cce;
+		cce.client = client;
+		cce.ConnectedProxy = Proxy;
+		events.QueueDispatch(redisBatch, cce);
+	}
+
+	try
+	{
+		const size_t failed = InternalDB::Get()->Execute(redisBatch);
+		if (failed > 0)
+		{
+			logger.WarningFormatted("{} manifest writes for {} clients failed", failed,
+									clients.size());
+			Telemetry.PersistFailures.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+	catch (const std::exception& e)
+	{
+		logger.ErrorFormatted("Could not persist {} clients: {}", clients.size(), e.what());
+		Telemetry.PersistFailures.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+void HandshakeService::Notify(const std::vector<Placement>& placements)
+{
+	Interlink& interlink = Interlink::Get();
+	for (const Placement& placement : placements)
+	{
+		// The client may have disconnected during the batch, the tick thread checks
+		if (placement.Shard)
+			interlink.ActivateClient(*placement.Shard, placement.Pending->client.ID);
+	}
+}
+
+HandshakeService::ClientVerifyReply HandshakeService::VerifyClient(const Client& c)
+{
+	std::uniform_real_distribution<float> dist(-100.0f, 100.0f);
+	ClientVerifyReply reply;
+	reply.status = ClientVerifyStatus::eAccepted;
+	reply.SpawnWorldLocation.position.x = dist(Rng);
+	reply.SpawnWorldLocation.position.y = dist(Rng);
+	reply.SpawnWorldLocation.position.z = 0.0f;
+	return reply;
+}
+
+std::optional<NetworkIdentity> HandshakeService::DetermineShard(const Transform& t)
+{
+	if (!Heuristic)
+		return std::nullopt;
+	const std::unique_ptr<IBounds> bound = Heuristic->QueryPosition(t.position);
+	if (!bound)
+		return std::nullopt;
+	const auto it = BoundOwners.find(bound->GetID());
+	if (it == BoundOwners.end())
+		return std::nullopt;
+	return it->second;
+}
+
+void HandshakeService::ReloadHeuristic()
+{
+	const auto start = std::chrono::steady_clock::now();
+	HeuristicManifest& manifest = HeuristicManifest::Get();
+	try
+	{
+		Heuristic = manifest.PullHeuristic();
+
+		std::vector<std::string> claimedData;
+		std::unordered_map<NetworkIdentity, std::pair<IBounds::BoundsID, ByteReader>> claimed;
+		manifest.GetClaimedBoundsAsByteReaders(claimedData, claimed);
+		BoundOwners.clear();
+		for (const auto& [owner, bound] : claimed)
+			BoundOwners[bound.first] = owner;
+	}
+	catch (const std::exception& e)
+	{
+		logger.WarningFormatted("Could not load the heuristic: {}", e.what());
+	}
+	// Also on failure, a missing heuristic is not worth a pull for every batch
+	HeuristicLoaded = std::chrono::steady_clock::now();
+	Telemetry.HeuristicReloadUsec.Record(MicrosecondsBetween(start, HeuristicLoaded));
+}
@@ -1,13 +1,89 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <stop_token>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
 #include "Client/Client.hpp"
 #include "Debug/Log.hpp"
 #include "Entity/Transform.hpp"
+#include "Global/Misc/LatencyHistogram.hpp"
 #include "Global/Misc/Singleton.hpp"
-#include "Global/Misc/UUID.hpp"
-#include "Heuristic/Database/HeuristicManifest.hpp"
+#include "Handshake/HandshakeTelemetrySummary.hpp"
+#include "Heuristic/IBounds.hpp"
 #include "Heuristic/IHeuristic.hpp"
 #include "Network/NetworkIdentity.hpp"
+
+struct HandshakeSettings
+{
+	/// How long the first client of a batch waits for others to join it.
+	std::chrono::microseconds BatchWindow{2000};
+	/// Age after which the local heuristic copy is pulled again before placing a batch.
+	std::chrono::milliseconds HeuristicMaxAge{1000};
+};
+
+/**
+ * @brief Latency of each stage of the client handshake, in microseconds.
+ * @details Queued is from the connect until a batch picked the client up. Resolve, Persist and
+ * Notify are timed once per batch, Total once per client from connect to its shard being told.
+ */
+struct HandshakeTelemetry
+{
+	LatencyHistogram QueuedUsec;
+	LatencyHistogram ResolveUsec;
+	LatencyHistogram HeuristicReloadUsec;
+	LatencyHistogram PersistUsec;
+	LatencyHistogram NotifyUsec;
+	LatencyHistogram TotalUsec;
+	LatencyHistogram ClientsPerBatch;
+
+	/// Clients no shard owns the spawn location of. They stay on the proxy unplaced.
+	std::atomic<uint64_t> Unplaced{0};
+	/// Batches whose manifest writes failed, in part or completely.
+	std::atomic<uint64_t> PersistFailures{0};
+
+	[[nodiscard]] HandshakeTelemetrySummary Summarize() const
+	{
+		return HandshakeTelemetrySummary{
+			.Batches = ClientsPerBatch.Count(),
+			.ClientsPerBatchP50 = ClientsPerBatch.Percentile(0.5),
+			.ClientsPerBatchP99 = ClientsPerBatch.Percentile(0.99),
+			.Clients = TotalUsec.Count(),
+			.Unplaced = Unplaced.load(std::memory_order_relaxed),
+			.PersistFailures = PersistFailures.load(std::memory_order_relaxed),
+			.QueuedP50 = QueuedUsec.Percentile(0.5),
+			.QueuedP99 = QueuedUsec.Percentile(0.99),
+			.ResolveP50 = ResolveUsec.Percentile(0.5),
+			.ResolveP99 = ResolveUsec.Percentile(0.99),
+			.HeuristicReloadP50 = HeuristicReloadUsec.Percentile(0.5),
+			.HeuristicReloadP99 = HeuristicReloadUsec.Percentile(0.99),
+			.PersistP50 = PersistUsec.Percentile(0.5),
+			.PersistP99 = PersistUsec.Percentile(0.99),
+			.NotifyP50 = NotifyUsec.Percentile(0.5),
+			.NotifyP99 = NotifyUsec.Percentile(0.99),
+			.TotalP50 = TotalUsec.Percentile(0.5),
+			.TotalP99 = TotalUsec.Percentile(0.99)};
+	}
+};
+
+/**
+ * @brief Onboards clients connecting to this proxy.
+ * @details Clients are handled in batches on a worker thread, in three stages:
+ *  - resolve: pick a spawn location and the shard owning it from a local copy of the heuristic
+ *  - persist: the ClientManifest entries and ClientConnectEvents of the whole batch, sent as one
+ *    Redis pipeline
+ *  - notify: a ClientTransferPacket activation to every shard that got a client, opening the
+ *    virtual channel the client's traffic takes over the proxy<->shard link. Handed to the
+ *    Interlink tick thread, which skips clients that disconnected during the batch
+ */
 class HandshakeService : public Singleton<HandshakeService>
 {
 	Log logger = Log("HandshakeService");
@@ -24,33 +100,53 @@ class HandshakeService : public Singleton<HandshakeService>
 		ClientVerifyStatus status;
 		Transform SpawnWorldLocation;
 	};
-	void OnClientConnect(const Client& c)
-	{
-		ClientVerifyReply r = VerifyClient(c);
-		logger.DebugFormatted("Client {} Spawn Location {}",
-							  UUIDGen::ToString(c.ID),r.SpawnWorldLocation.ToString());
-		std::optional<NetworkIdentity> targetShard =
-			DetermineShard(r.SpawnWorldLocation);
-		logger.DebugFormatted("Client {} Target Shard {}",
-							  UUIDGen::ToString(c.ID),targetShard.has_value()
-								  ? targetShard.value().ToString()
-								  : "UNABLE TO DETERMINE");
-	}
-	[[nodiscard]] ClientVerifyReply VerifyClient(const Client& c)
+
+	~HandshakeService() { Stop(); }
+
+	/// @param proxy this proxy, the one every client handed in connected to.
+	void Start(const NetworkIdentity& proxy, const HandshakeSettings& settings = {});
+	/// @brief Clients still waiting for a batch are dropped.
+	void Stop();
+
+	/// @brief Safe from any thread, returns right away.
+	void OnClientConnect(const Client& c);
+
+	[[nodiscard]] const HandshakeTelemetry& GetTelemetry() const { return Telemetry; }
+
+   private:
+	struct PendingClient
 	{
-		std::random_device rd;
-		std::mt19937 gen(rd());
-		std::uniform_real_distribution<float> dist(-100.0f, 100.0f);
-		ClientVerifyReply reply;
-		reply.status = ClientVerifyStatus::eAccepted;
-		reply.SpawnWorldLocation.position.x = dist(gen);
-		reply.SpawnWorldLocation.position.y = dist(gen);
-		reply.SpawnWorldLocation.position.z = 0.0f;
-		return reply;
-	}
-	[[nodiscard]] std::optional<NetworkIdentity> DetermineShard(
-		const Transform& t)
+		Client client;
+		std::chrono::steady_clock::time_point Connected;
+	};
+	struct Placement
 	{
-		return HeuristicManifest::Get().ShardFromPosition(t);
-	}
-};
\ No newline at end of file
+		const PendingClient* Pending;
+		std::optional<NetworkIdentity> Shard;
+	};
+
+	void WorkerEntry(std::stop_token st);
+	void RunBatch(std::vector<PendingClient>& batch);
+	void Resolve(const std::vector<PendingClient>& batch, std::vector<Placement>& out);
+	void Persist(const std::vector<PendingClient>& batch);
+	void Notify(const std::vector<Placement>& placements);
+
+	[[nodiscard]] ClientVerifyReply VerifyClient(const Client& c);
+	[[nodiscard]] std::optional<NetworkIdentity> DetermineShard(const Transform& t);
+	void ReloadHeuristic();
+
+	NetworkIdentity Proxy;
+	HandshakeSettings Settings;
+	HandshakeTelemetry Telemetry;
+
+	std::jthread Worker;
+	std::mutex Mutex;
+	std::condition_variable_any CV;
+	std::vector<PendingClient> Pending;
+
+	// Worker thread only
+	std::mt19937 Rng{std::random_device{}()};
+	std::unique_ptr<IHeuristic> Heuristic;
+	std::unordered_map<IBounds::BoundsID, NetworkIdentity> BoundOwners;
+	std::chrono::steady_clock::time_point HeuristicLoaded;
+};
@@ -0,0 +1,98 @@
+#pragma once
+#include <string>
+#include <vector>
+
+#include "Global/Serialize/ByteReader.hpp"
+#include "Global/Serialize/ByteWriter.hpp"
+
+/// @brief Cumulative HandshakeTelemetry of one proxy, as published to the NetworkManifest. Times
+/// are in microseconds.
+struct HandshakeTelemetrySummary
+{
+	uint64_t Batches = 0;
+	uint64_t ClientsPerBatchP50 = 0;
+	uint64_t ClientsPerBatchP99 = 0;
+	uint64_t Clients = 0;
+	uint64_t Unplaced = 0;
+	uint64_t PersistFailures = 0;
+
+	uint64_t QueuedP50 = 0;
+	uint64_t QueuedP99 = 0;
+	uint64_t ResolveP50 = 0;
+	uint64_t ResolveP99 = 0;
+	uint64_t HeuristicReloadP50 = 0;
+	uint64_t HeuristicReloadP99 = 0;
+	uint64_t PersistP50 = 0;
+	uint64_t PersistP99 = 0;
+	uint64_t NotifyP50 = 0;
+	uint64_t NotifyP99 = 0;
+	uint64_t TotalP50 = 0;
+	uint64_t TotalP99 = 0;
+
+	static constexpr size_t ColumnCount = 18;
+
+	void Serialize(ByteWriter& bw) const
+	{
+		bw.u64(Batches);
+		bw.u64(ClientsPerBatchP50);
+		bw.u64(ClientsPerBatchP99);
+		bw.u64(Clients);
+		bw.u64(Unplaced);
+		bw.u64(PersistFailures);
+		bw.u64(QueuedP50);
+		bw.u64(QueuedP99);
+		bw.u64(ResolveP50);
+		bw.u64(ResolveP99);
+		bw.u64(HeuristicReloadP50);
+		bw.u64(HeuristicReloadP99);
+		bw.u64(PersistP50);
+		bw.u64(PersistP99);
+		bw.u64(NotifyP50);
+		bw.u64(NotifyP99);
+		bw.u64(TotalP50);
+		bw.u64(TotalP99);
+	}
+	void Deserialize(ByteReader& br)
+	{
+		Batches = br.u64();
+		ClientsPerBatchP50 = br.u64();
+		ClientsPerBatchP99 = br.u64();
+		Clients = br.u64();
+		Unplaced = br.u64();
+		PersistFailures = br.u64();
+		QueuedP50 = br.u64();
+		QueuedP99 = br.u64();
+		ResolveP50 = br.u64();
+		ResolveP99 = br.u64();
+		HeuristicReloadP50 = br.u64();
+		HeuristicReloadP99 = br.u64();
+		PersistP50 = br.u64();
+		PersistP99 = br.u64();
+		NotifyP50 = br.u64();
+		NotifyP99 = br.u64();
+		TotalP50 = br.u64();
+		TotalP99 = br.u64();
+	}
+	/// @brief Column order used by the plain string manifest and the Cartograph.
+	std::vector<std::string> ToRow() const
+	{
+		return {std::to_string(Batches),
+				std::to_string(ClientsPerBatchP50),
+				std::to_string(ClientsPerBatchP99),
+				std::to_string(Clients),
+				std::to_string(Unplaced),
+				std::to_string(PersistFailures),
+				std::to_string(QueuedP50),
+				std::to_string(QueuedP99),
+				std::to_string(ResolveP50),
+				std::to_string(ResolveP99),
+				std::to_string(HeuristicReloadP50),
+				std::to_string(HeuristicReloadP99),
+				std::to_string(PersistP50),
+				std::to_string(PersistP99),
+				std::to_string(NotifyP50),
+				std::to_string(NotifyP99),
+				std::to_string(TotalP50),
+				std::to_string(TotalP99)};
+	}
+};
@@ -1,6 +1,10 @@
 #include "BoundLeaser.hpp"
 
+#include <algorithm>
+#include <unordered_map>
+
 #include "Heuristic/Database/HeuristicManifest.hpp"
+#include "Interlink/Interlink.hpp"
 #include "Network/NetworkCredentials.hpp"
 
 void BoundLeaser::ClaimBound()
@@ -16,3 +20,37 @@ void BoundLeaser::ClaimBound()
 	ASSERT(ClaimedBoundID == HeuristicManifest::Get().BoundIDFromShard(SelfID).value(),
 		   "Internal Error");
 }
+
+void BoundLeaser::RefreshNeighbors()
+{
+	if (!ClaimedBound)
+		return;
+	const auto heuristic = HeuristicManifest::Get().PullHeuristic();
+	if (!heuristic)
+		return;
+	std::vector<IBounds::BoundsID> neighborBounds;
+	heuristic->GetNeighbors(ClaimedBoundID, neighborBounds);
+
+	std::vector<std::string> claimedData;
+	std::unordered_map<NetworkIdentity, std::pair<IBounds::BoundsID, ByteReader>> claimed;
+	HeuristicManifest::Get().GetClaimedBoundsAsByteReaders(claimedData, claimed);
+
+	const auto& SelfID = NetworkCredentials::Get().GetID();
+	std::vector<NetworkIdentity> neighbors;
+	for (const auto& [owner, bound] : claimed)
+	{
+		if (owner == SelfID)
+			continue;
+		if (std::find(neighborBounds.begin(), neighborBounds.end(), bound.first) !=
+			neighborBounds.end())
+			neighbors.push_back(owner);
+	}
+	std::sort(neighbors.begin(), neighbors.end());
+	if (neighbors == WarmNeighbors)
+		return;
+
+	logger.DebugFormatted("Bound {} has {} neighbors, {} of them claimed", ClaimedBoundID,
+						  neighborBounds.size(), neighbors.size());
+	WarmNeighbors = neighbors;
+	Interlink::Get().SetWarmPeers(std::move(neighbors));
+}
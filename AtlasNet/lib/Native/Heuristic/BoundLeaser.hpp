@@ -3,6 +3,7 @@
 #include <chrono>
 #include <stop_token>
 #include <thread>
+#include <vector>
 
 #include "Debug/Log.hpp"
 #include "Global/Misc/Singleton.hpp"
@@ -14,6 +15,10 @@ class BoundLeaser : public Singleton<BoundLeaser>
 	std::unique_ptr<IBounds> ClaimedBound;
 	IBounds::BoundsID ClaimedBoundID;
 
+	/// Owners of the bounds next to ours, kept connected by the Interlink
+	std::vector<NetworkIdentity> WarmNeighbors;
+	std::chrono::steady_clock::time_point NextNeighborRefresh;
+
 	std::jthread LoopThread;
 
    private:
@@ -24,14 +29,26 @@ class BoundLeaser : public Singleton<BoundLeaser>
 			if (!ClaimedBound)
 			{
 				ClaimBound();
+				NextNeighborRefresh = {};
+			}
+			if (std::chrono::steady_clock::now() >= NextNeighborRefresh)
+			{
+				RefreshNeighbors();
+				NextNeighborRefresh = std::chrono::steady_clock::now() + NeighborRefreshInterval;
 			}
 			std::this_thread::sleep_for(std::chrono::milliseconds(100));
 		}
 	}
 
 	void ClaimBound();
+	/// @brief Look up who owns the bounds next to ours and have the Interlink keep them warm, so
+	/// the first handoff across a border does not pay for the connection.
+	void RefreshNeighbors();
 
    public:
+	/// Bounds and their owners change without notice, so the neighbor set is polled this often.
+	std::chrono::milliseconds NeighborRefreshInterval = std::chrono::seconds(2);
+
 	void Init()
 	{
 		logger.Debug("Init");
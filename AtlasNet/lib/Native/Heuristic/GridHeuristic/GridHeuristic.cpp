@@ -1,5 +1,6 @@
 #include "GridHeuristic.hpp"
 
+#include <algorithm>
 #include <iostream>
 
 #include "Global/Serialize/ByteWriter.hpp"
@@ -74,3 +75,20 @@ std::unique_ptr<IBounds> GridHeuristic::QueryPosition(vec3 p)
 
 	return nullptr;
 }
+void GridHeuristic::GetNeighbors(IBounds::BoundsID id,
+								 std::vector<IBounds::BoundsID>& out_neighbors) const
+{
+	out_neighbors.clear();
+	const auto self = std::find_if(quads.begin(), quads.end(),
+								   [id](const GridShape& shape) { return shape.ID == id; });
+	if (self == quads.end())
+		return;
+	// Cells of a grid only touch, pad slightly so float error does not hide a shared edge
+	AABB3f reach = self->aabb;
+	reach.pad(0.01f);
+	for (const auto& shape : quads)
+	{
+		if (shape.ID != id && reach.intersects(shape.aabb))
+			out_neighbors.push_back(shape.ID);
+	}
+}
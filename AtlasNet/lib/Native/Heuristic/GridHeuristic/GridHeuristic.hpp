@@ -34,5 +34,7 @@ class GridHeuristic : public THeuristic<GridShape>
 	void Deserialize(ByteReader& br) override;
 
 	std::unique_ptr<IBounds> QueryPosition(vec3 p) override;
+	void GetNeighbors(IBounds::BoundsID id,
+					  std::vector<IBounds::BoundsID>& out_neighbors) const override;
 	std::span<const GridShape> GetGrids() const { return quads; }
 };
\ No newline at end of file
@@ -93,6 +93,9 @@ class IHeuristic
 	virtual void Serialize(ByteWriter& bw) const = 0;
 	virtual void Deserialize(ByteReader& br) = 0;
 	[[nodiscard]] virtual std::unique_ptr<IBounds> QueryPosition(vec3 p) = 0;
+	/// @brief Bounds sharing a face, edge or corner with id, the ones entities cross into.
+	virtual void GetNeighbors(IBounds::BoundsID id,
+							  std::vector<IBounds::BoundsID>& out_neighbors) const = 0;
 };
 template <typename BoundType>
 struct TBoundDelta
@@ -0,0 +1,82 @@
+#include "ConnectionAdmission.hpp"
+
+#include "Interlink/Database/ServerRegistry.hpp"
+
+void ConnectionAdmission::Start(LookedUpFn onLookedUp)
+{
+	if (Thread.joinable())
+		return;
+	OnLookedUp = std::move(onLookedUp);
+	Thread = std::jthread([this](std::stop_token st) { ThreadEntry(st); });
+}
+
+void ConnectionAdmission::Stop()
+{
+	if (!Thread.joinable())
+		return;
+	Thread.request_stop();
+	Thread.join();
+	std::lock_guard lock(Mutex);
+	Jobs.clear();
+}
+
+bool ConnectionAdmission::Admit(HSteamNetConnection conn, const NetworkIdentity &ID)
+{
+	if (!ID.IsInternal() || ServerRegistry::Get().ExistsInSnapshot(ID))
+		return true;
+	Queue(
+		[this, conn, ID, requested = std::chrono::steady_clock::now()]
+		{
+			const bool known = ServerRegistry::Get().ExistsInRegistry(ID);
+			OnLookedUp(Lookup{.Connection = conn, .Known = known, .Requested = requested});
+		});
+	return false;
+}
+
+void ConnectionAdmission::Queue(std::function<void()> job)
+{
+	{
+		std::lock_guard lock(Mutex);
+		Jobs.push_back(std::move(job));
+	}
+	CV.notify_one();
+}
+
+bool ConnectionAdmission::Accept(ISteamNetworkingSockets *sockets, HSteamNetConnection conn)
+{
+	if (EResult result = sockets->AcceptConnection(conn); result != k_EResultOK)
+	{
+		logger.ErrorFormatted("Error accepting connection: reason: {}", uint64(result));
+		sockets->CloseConnection(conn, 0, nullptr, false);
+		return false;
+	}
+	return true;
+}
+
+void ConnectionAdmission::Reject(ISteamNetworkingSockets *sockets, HSteamNetConnection conn)
+{
+	sockets->CloseConnection(conn, 0, "Not in the ServerRegistry", false);
+}
+
+void ConnectionAdmission::ThreadEntry(std::stop_token st)
+{
+	while (!st.stop_requested())
+	{
+		std::function<void()> job;
+		{
+			std::unique_lock lock(Mutex);
+			if (!CV.wait(lock, st, [this] { return !Jobs.empty(); }))
+				return;
+			job = std::move(Jobs.front());
+			Jobs.pop_front();
+		}
+		try
+		{
+			job();
+		}
+		catch (const std::exception &e)
+		{
+			logger.ErrorFormatted("Admission job failed: {}", e.what());
+		}
+	}
+}
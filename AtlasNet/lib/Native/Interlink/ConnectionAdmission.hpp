@@ -0,0 +1,60 @@
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+
+#include "Debug/Log.hpp"
+#include "GameNetworkingSockets.hpp"
+#include "Network/NetworkIdentity.hpp"
+
+/**
+ * @brief Decides whether incoming connections may be accepted.
+ * @details External peers, and internal peers the ServerRegistry snapshot knows, are admitted
+ * right away. Any other internal peer may have registered since the snapshot last changed, so it
+ * is left unaccepted, GNS holds it in the connecting state, while the admission thread asks
+ * Redis. The answer goes to the OnLookedUp given to Start, on that thread, and whoever owns the
+ * connection finishes it with Accept or Reject. Redis work triggered by connection callbacks
+ * runs on the same thread, so a login storm or fleet restart does not hold up the callbacks.
+ */
+class ConnectionAdmission
+{
+   public:
+	struct Lookup
+	{
+		HSteamNetConnection Connection = k_HSteamNetConnection_Invalid;
+		bool Known = false;
+		std::chrono::steady_clock::time_point Requested;
+	};
+	using LookedUpFn = std::function<void(const Lookup &)>;
+
+	~ConnectionAdmission() { Stop(); }
+
+	void Start(LookedUpFn onLookedUp);
+	/// @brief Jobs still queued are dropped.
+	void Stop();
+
+	/// @brief Called from the Connecting status callback.
+	/// @return true when conn can be accepted now, false when a lookup was queued for it.
+	bool Admit(HSteamNetConnection conn, const NetworkIdentity &ID);
+	/// @brief Run job on the admission thread, in submission order.
+	void Queue(std::function<void()> job);
+
+	/// @brief Accept an incoming connection, closing it if GNS refuses.
+	bool Accept(ISteamNetworkingSockets *sockets, HSteamNetConnection conn);
+	/// @brief Close a connection whose peer is not in the ServerRegistry.
+	void Reject(ISteamNetworkingSockets *sockets, HSteamNetConnection conn);
+
+   private:
+	void ThreadEntry(std::stop_token st);
+
+	Log logger = Log("ConnectionAdmission");
+	LookedUpFn OnLookedUp;
+	std::jthread Thread;
+	std::mutex Mutex;
+	std::condition_variable_any CV;
+	std::deque<std::function<void()>> Jobs;
+};
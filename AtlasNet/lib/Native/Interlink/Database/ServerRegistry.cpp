@@ -7,11 +7,13 @@
 #include "Global/Serialize/ByteWriter.hpp"
 
 static const std::string kPublicSuffix = "_public";
+static const std::string kHostSuffix = "_host";
 
 void ServerRegistry::RegisterSelf(const NetworkIdentity &ID, IPAddress address)
 {
-	InternalDB::Get()->HSet(HashTableNameID_IP, GetKeyOfIdentifier(ID),
-							NukeString(address.ToString()));
+	const std::string key = GetKeyOfIdentifier(ID);
+	InternalDB::Get()->HSet(HashTableNameID_IP, key, NukeString(address.ToString()));
+	AnnounceChange(ChangeAdded, key);
 }
 
 void ServerRegistry::RegisterPublicAddress(const NetworkIdentity &ID, const IPAddress &address)
@@ -20,17 +22,25 @@ void ServerRegistry::RegisterPublicAddress(const NetworkIdentity &ID, const IPAd
 							NukeString(address.ToString()));
 }
 
+void ServerRegistry::RegisterHost(const NetworkIdentity &ID, const std::string &hostKey)
+{
+	InternalDB::Get()->HSet(HashTableNameID_IP + kHostSuffix, GetKeyOfIdentifier(ID), hostKey);
+}
+
 void ServerRegistry::DeRegisterSelf(const NetworkIdentity &ID)
 {
 	const std::string key = GetKeyOfIdentifier(ID);
 	InternalDB::Get()->HDel(HashTableNameID_IP, {key});
 	InternalDB::Get()->HDel(HashTableNameID_IP + kPublicSuffix, {key});
+	InternalDB::Get()->HDel(HashTableNameID_IP + kHostSuffix, {key});
+	AnnounceChange(ChangeRemoved, key);
 }
 
 const decltype(ServerRegistry::servers) &ServerRegistry::GetServers()
 {
 	servers.clear();
 	const auto entries = InternalDB::Get()->HGetAll(HashTableNameID_IP);
+	servers.reserve(entries.size());
 	for (const auto &rawEntry : entries)
 	{
 		ServerRegistryEntry newEntry;
@@ -75,10 +85,18 @@ std::optional<IPAddress> ServerRegistry::GetPublicAddress(const NetworkIdentity
 	return ip;
 }
 
+std::optional<std::string> ServerRegistry::GetHostOf(const NetworkIdentity &ID)
+{
+	auto ret = InternalDB::Get()->HGet(HashTableNameID_IP + kHostSuffix, GetKeyOfIdentifier(ID));
+	if (!ret.has_value() || ret->empty())
+	{
+		return std::nullopt;
+	}
+	return ret;
+}
+
 bool ServerRegistry::ExistsInRegistry(const NetworkIdentity &ID) const
 {
-	ByteWriter bw;
-	ID.Serialize(bw);
 	return InternalDB::Get()->HExists(HashTableNameID_IP, GetKeyOfIdentifier(ID));
 }
 
@@ -86,9 +104,141 @@ void ServerRegistry::ClearAll()
 {
 	InternalDB::Get()->DelKey(HashTableNameID_IP);
 	InternalDB::Get()->DelKey(HashTableNameID_IP + kPublicSuffix);
+	InternalDB::Get()->DelKey(HashTableNameID_IP + kHostSuffix);
+	(void)InternalDB::Get()->Publish(ChangedChannel, "*");
+}
+
+void ServerRegistry::AnnounceChange(char change, const std::string &key)
+{
+	(void)InternalDB::Get()->Publish(ChangedChannel, change + key);
+}
+
+void ServerRegistry::StartSnapshot()
+{
+	if (SnapshotThread.joinable())
+		return;
+	ReloadSnapshot();
+	SnapshotThread = std::jthread([this](std::stop_token st) { WatchChanges(st); });
+}
+
+void ServerRegistry::StopSnapshot()
+{
+	if (!SnapshotThread.joinable())
+		return;
+	SnapshotThread.request_stop();
+	try
+	{
+		// consume() has no timeout, an empty announcement of our own is what makes it return
+		(void)InternalDB::Get()->Publish(ChangedChannel, "");
+		SnapshotThread.join();
+	}
+	catch (const std::exception &e)
+	{
+		logger.WarningFormatted("Leaving the registry watcher blocked in Redis: {}", e.what());
+		SnapshotThread.detach();
+	}
+}
+
+void ServerRegistry::WatchChanges(std::stop_token st)
+{
+	while (!st.stop_requested())
+	{
+		try
+		{
+			sw::redis::Subscriber subscriber = InternalDB::Get()->Subscriber();
+			subscriber.on_message(
+				[this](std::string, std::string message)
+				{
+					if (!message.empty())
+						ApplyChange(message);
+				});
+			subscriber.subscribe(ChangedChannel);
+			// Whatever changed before the subscription took effect
+			ReloadSnapshot();
+			while (!st.stop_requested())
+				subscriber.consume();
+		}
+		catch (const sw::redis::Error &e)
+		{
+			// A subscriber is unusable after an error, start over with a fresh one
+			logger.WarningFormatted("Registry change feed failed, resubscribing: {}", e.what());
+			std::this_thread::sleep_for(std::chrono::seconds(1));
+		}
+	}
+}
+
+void ServerRegistry::ReloadSnapshot()
+{
+	// Held across the fetch so an older read can never replace a newer one
+	std::lock_guard reload(ReloadMutex);
+	auto next = std::make_shared<std::unordered_set<NetworkIdentity>>();
+	for (const auto &[key, address] : InternalDB::Get()->HGetAll(HashTableNameID_IP))
+	{
+		NetworkIdentity id;
+		ByteReader br(key);
+		id.Deserialize(br);
+		next->insert(id);
+	}
+	std::lock_guard lock(SnapshotMutex);
+	Snapshot = std::move(next);
+}
+
+void ServerRegistry::ApplyChange(const std::string &message)
+{
+	const char change = message.front();
+	if (change != ChangeAdded && change != ChangeRemoved)
+	{
+		ReloadSnapshot();
+		return;
+	}
+	NetworkIdentity id;
+	try
+	{
+		ByteReader br(std::span(reinterpret_cast<const uint8_t *>(message.data()) + 1,
+								message.size() - 1));
+		id.Deserialize(br);
+	}
+	catch (const std::exception &e)
+	{
+		logger.WarningFormatted("Unreadable registry change, reloading: {}", e.what());
+		ReloadSnapshot();
+		return;
+	}
+
+	// Same lock as a reload, so a change is never applied to a snapshot older than itself
+	std::lock_guard reload(ReloadMutex);
+	std::shared_ptr<const std::unordered_set<NetworkIdentity>> current;
+	{
+		std::lock_guard lock(SnapshotMutex);
+		current = Snapshot;
+	}
+	if (current && current->contains(id) == (change == ChangeAdded))
+		return;
+	auto next = current ? std::make_shared<std::unordered_set<NetworkIdentity>>(*current)
+						: std::make_shared<std::unordered_set<NetworkIdentity>>();
+	if (change == ChangeAdded)
+		next->insert(id);
+	else
+		next->erase(id);
+	std::lock_guard lock(SnapshotMutex);
+	Snapshot = std::move(next);
+}
+
+bool ServerRegistry::ExistsInSnapshot(const NetworkIdentity &ID) const
+{
+	std::shared_ptr<const std::unordered_set<NetworkIdentity>> snapshot;
+	{
+		std::lock_guard lock(SnapshotMutex);
+		snapshot = Snapshot;
+	}
+	return snapshot && snapshot->contains(ID);
 }
 
 ServerRegistry::ServerRegistry() {}
+ServerRegistry::~ServerRegistry()
+{
+	StopSnapshot();
+}
 const std::string ServerRegistry::GetKeyOfIdentifier(const NetworkIdentity &ID) {
 		ByteWriter bw;
 	ID.Serialize(bw);
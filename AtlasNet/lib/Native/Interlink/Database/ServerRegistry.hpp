@@ -1,6 +1,13 @@
 #pragma once
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <unordered_set>
+
 #include <Global/pch.hpp>
 #include <Interlink/Interlink.hpp>
+#include "Debug/Log.hpp"
 #include "InternalDB/InternalDB.hpp"
 #include "Network/NetworkIdentity.hpp"
 struct ServerRegistryEntry
@@ -14,19 +21,47 @@ class ServerRegistry:public Singleton<ServerRegistry>
     std::unordered_map<NetworkIdentity,ServerRegistryEntry> servers;
     const static inline std::string HashTableNameID_IP= "Server Registry ID_IP";
     //const static inline std::string HashTableNameIP_ID = "Server Registry IP_ID";
+    /// Every change to HashTableNameID_IP is announced here, as '+' or '-' and the key that was
+    /// set or removed, or "*" when snapshots have to reload everything.
+    const static inline std::string ChangedChannel = "Server Registry Changed";
+    static constexpr char ChangeAdded = '+';
+    static constexpr char ChangeRemoved = '-';
 	const static std::string GetKeyOfIdentifier(const NetworkIdentity& ID);
 
+    Log logger = Log("ServerRegistry");
+    std::mutex ReloadMutex;
+    mutable std::mutex SnapshotMutex;
+    std::shared_ptr<const std::unordered_set<NetworkIdentity>> Snapshot;
+    std::jthread SnapshotThread;
+    void WatchChanges(std::stop_token st);
+    void AnnounceChange(char change, const std::string& key);
+    /// @brief Apply one announcement to a copy of the snapshot, reloading on anything else.
+    void ApplyChange(const std::string& message);
+
    public:
     ServerRegistry();
+    ~ServerRegistry();
 
     void RegisterSelf(const NetworkIdentity& ID, IPAddress address);
     void DeRegisterSelf(const NetworkIdentity& ID);
     const decltype(servers)& GetServers();
     std::optional<IPAddress> GetIPOfID(const NetworkIdentity& ID);
     bool ExistsInRegistry(const NetworkIdentity& ID) const;
+    /// @brief Keep a local copy of the registered identities, updated as servers announce their
+    /// changes, so admission checks do not go to Redis.
+    void StartSnapshot();
+    void StopSnapshot();
+    /// @brief Replace the snapshot with what Redis holds now. Blocks on Redis.
+    void ReloadSnapshot();
+    /// @return whether ID was registered as of the last change seen. A miss can mean the snapshot
+    /// has not caught up yet, ExistsInRegistry is authoritative.
+    [[nodiscard]] bool ExistsInSnapshot(const NetworkIdentity& ID) const;
     void ClearAll();
     //std::optional<NetworkIdentity> GetIDOfIP(IPAddress ID,bool IgnorePort);
     void RegisterPublicAddress(const NetworkIdentity& ID, const IPAddress& address);
     std::optional<IPAddress> GetPublicAddress(const NetworkIdentity& ID);
+    /// Opaque key shared by servers on the same host that can reach each other without the network
+    void RegisterHost(const NetworkIdentity& ID, const std::string& hostKey);
+    std::optional<std::string> GetHostOf(const NetworkIdentity& ID);
 
 };
\ No newline at end of file
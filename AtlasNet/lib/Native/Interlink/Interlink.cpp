@@ -2,6 +2,7 @@
 
 #include <steam/steamtypes.h>
 
+#include <algorithm>
 #include <atomic>
 #include <boost/describe/enum_to_string.hpp>
 #include <chrono>
@@ -10,11 +11,9 @@
 
 // #include "Database/ProxyRegistry.hpp"
 #include "Client/Client.hpp"
-#include "Client/ClientManifest.hpp"
 #include "Database/ServerRegistry.hpp"
 #include "Docker/DockerIO.hpp"
-#include "Events/EventSystem.hpp"
-#include "Events/Events/Client/ClientEvents.hpp"
+#include "Entity/Packet/ClientTransferPacket.hpp"
 #include "GameNetworkingSockets.hpp"
 #include "Global/Misc/UUID.hpp"
 #include "Global/Serialize/ByteReader.hpp"
@@ -28,7 +27,11 @@
 #include "Network/NetworkIdentity.hpp"
 #include "Network/Packet/Client/ClientIDAssignPacket.hpp"
 #include "Network/Packet/Packet.hpp"
+#include "Network/Packet/PacketChannelFrame.hpp"
 #include "Network/Packet/PacketManager.hpp"
+#include "Packet/RelayPacket.hpp"
+#include "Transport/LoopbackTransport.hpp"
+#include "Transport/SharedMemoryTransport.hpp"
 #include "steam/steamclientpublic.h"
 
 // ===== Safe, single-process guard for GNS init ===============================
@@ -57,6 +60,7 @@ static void SteamNetConnectionStatusChanged(SteamNetConnectionStatusChangedCallb
 // ===== Interlink implementation =============================================
 void Interlink::OnSteamNetConnectionStatusChanged(SteamNetConnectionStatusChangedCallback_t *pInfo)
 {
+	const auto start = std::chrono::steady_clock::now();
 	switch (pInfo->m_info.m_eState)
 	{
 		case k_ESteamNetworkingConnectionState_Connecting:
@@ -88,77 +92,501 @@ void Interlink::OnSteamNetConnectionStatusChanged(SteamNetConnectionStatusChange
 			logger.ErrorFormatted(std::format("Unknown {}", (int64)pInfo->m_info.m_eState));
 			break;
 	}
+	TickTelemetry.StatusCallbackUsec.Record(std::chrono::duration_cast<std::chrono::microseconds>(
+												std::chrono::steady_clock::now() - start)
+												.count());
 }
 
-void Interlink::SendMessage(const NetworkIdentity &who, const std::shared_ptr<IPacket> &packet,
-							NetworkMessageSendFlag sendFlag)
+OutboundBufferPtr Interlink::SerializeForSend(const IPacket &packet, uint32_t recipients)
+{
+	const auto start = std::chrono::steady_clock::now();
+	OutboundBufferPtr buffer = OutboundBuffer::Create();
+	packet.Serialize(buffer->Writer);
+	PacketMetrics::RecordSend(packet.GetPacketType(), buffer->Writer.size(),
+							  std::chrono::duration_cast<std::chrono::nanoseconds>(
+								  std::chrono::steady_clock::now() - start)
+								  .count(),
+							  recipients);
+	return buffer;
+}
+
+uint16_t Interlink::LaneOf(PacketTypeID type)
+{
+	static const PacketRegistry &registry = PacketRegistry::Get();
+	const PacketTypeTraits *traits = registry.GetTraits(type);
+	return (uint16_t)(traits ? traits->Lane : PacketLane::eDefault);
+}
+
+void Interlink::ConfigureLanes(HSteamNetConnection conn)
+{
+	std::array<int, PacketLaneSpecs.size()> priorities;
+	std::array<uint16, PacketLaneSpecs.size()> weights;
+	for (size_t i = 0; i < PacketLaneSpecs.size(); i++)
+	{
+		priorities[i] = PacketLaneSpecs[i].Priority;
+		weights[i] = PacketLaneSpecs[i].Weight;
+	}
+	const EResult result = networkInterface->ConfigureConnectionLanes(
+		conn, (int)PacketLaneSpecs.size(), priorities.data(), weights.data());
+	if (result != k_EResultOK)
+		logger.ErrorFormatted("Failed to configure lanes on connection {}: {}", conn,
+							  (int)result);
+}
+
+void Interlink::ApplyLinkProfile(HSteamNetConnection conn, NetworkIdentityType peer)
+{
+	const LinkConfigProfile &profile = Properties.Links.For(peer);
+	ISteamNetworkingUtils *utils = SteamNetworkingUtils();
+	bool applied = utils->SetConnectionConfigValueInt32(
+					   conn, k_ESteamNetworkingConfig_SendBufferSize, profile.SendBufferSize) &&
+				   utils->SetConnectionConfigValueInt32(conn, k_ESteamNetworkingConfig_SendRateMin,
+														profile.SendRateMin) &&
+				   utils->SetConnectionConfigValueInt32(conn, k_ESteamNetworkingConfig_SendRateMax,
+														profile.SendRateMax) &&
+				   utils->SetConnectionConfigValueInt32(conn, k_ESteamNetworkingConfig_NagleTime,
+														profile.NagleTimeUsec);
+	if (profile.MTUPacketSize > 0)
+		applied = applied && utils->SetConnectionConfigValueInt32(
+								 conn, k_ESteamNetworkingConfig_MTU_PacketSize,
+								 profile.MTUPacketSize);
+	if (!applied)
+		logger.ErrorFormatted("Failed to apply the {} link profile on connection {}",
+							  boost::describe::enum_to_string(peer, "Unknown"), conn);
+}
+
+void Interlink::TuneLinks()
+{
+	if (!Tuner.Due(std::chrono::steady_clock::now()))
+		return;
+	ISteamNetworkingUtils *utils = SteamNetworkingUtils();
+	const auto &byState = Connections.get<IndexByState>();
+	auto [it, end] = byState.equal_range(ConnectionState::eConnected);
+	for (; it != end; ++it)
+	{
+		if (!Tuner.IsTracked(it->SteamConnection))
+			continue;
+		SteamNetConnectionRealTimeStatus_t status{};
+		if (networkInterface->GetConnectionRealTimeStatus(it->SteamConnection, &status, 0,
+														  nullptr) != k_EResultOK)
+			continue;
+		const std::optional<LinkTuner::Adjustment> adjustment = Tuner.Update(
+			it->SteamConnection,
+			LinkTuner::Sample{.QueueTimeUsec = status.m_usecQueueTime,
+							  .PendingReliableBytes = status.m_cbPendingReliable,
+							  .PendingUnreliableBytes = status.m_cbPendingUnreliable,
+							  .PingMs = status.m_nPing,
+							  .QualityLocal = status.m_flConnectionQualityLocal,
+							  .QualityRemote = status.m_flConnectionQualityRemote});
+		if (!adjustment)
+			continue;
+		utils->SetConnectionConfigValueInt32(it->SteamConnection,
+											 k_ESteamNetworkingConfig_SendRateMin,
+											 adjustment->SendRateMin);
+		utils->SetConnectionConfigValueInt32(it->SteamConnection,
+											 k_ESteamNetworkingConfig_NagleTime,
+											 adjustment->NagleTimeUsec);
+		TickTelemetry.LinkRetunes.fetch_add(1, std::memory_order_relaxed);
+		logger.DebugFormatted("Retuned link to {}: send rate floor {} B/s, Nagle {} us",
+							  it->target.ToString(), adjustment->SendRateMin,
+							  adjustment->NagleTimeUsec);
+	}
+}
+
+void Interlink::StreamIfOversized(OutboundBufferPtr &buffer, NetworkMessageSendFlag &sendFlag)
+{
+	const uint32_t chunkBytes = Properties.StreamChunkBytes;
+	if (buffer->Writer.size() <= chunkBytes)
+		return;
+	const uint32_t streamID = NextStreamID.fetch_add(1, std::memory_order_relaxed);
+	logger.DebugFormatted("Streaming {} bytes as stream {} in chunks of {}",
+						  buffer->Writer.size(), streamID, chunkBytes);
+	buffer = SplitIntoChunks(*buffer, streamID, chunkBytes);
+	if (!((int)sendFlag & k_nSteamNetworkingSend_Reliable))
+		sendFlag = NetworkMessageSendFlag::eReliableBatched;
+}
+
+InterlinkSendStatus Interlink::SendMessage(const NetworkIdentity &who, const IPacket &packet,
+										   NetworkMessageSendFlag sendFlag)
 {
 	ASSERT(IsInit, "Interlink was not initialized");
-	ASSERT(packet->Validate(), "Packet did not valite");
-	if (!packet->Validate())
+	ASSERT(packet.Validate(), "Packet did not valite");
+	if (!packet.Validate())
 	{
 		logger.ErrorFormatted(
 			"Interlink::SendMessage: Packet of type {} did not validate "
 			"successfully",
-			packet->GetPacketName());
+			packet.GetPacketName());
+		return InterlinkSendStatus::eDropped;
+	}
+	// Nothing to serialize when the destination has no room left for it anyway
+	const InterlinkSendStatus status = PendingSends.Pressure(who, sendFlag);
+	if (status == InterlinkSendStatus::eDropped)
+		return status;
+
+	// Serialize straight into the buffer GNS will send from
+	OutboundBufferPtr buffer = SerializeForSend(packet, 1);
+	buffer->Lane = LaneOf(packet);
+	// Clients do not speak the compression or stream framing
+	if (who.IsInternal())
+	{
+		Compressor.Compress(packet.GetPacketType(), buffer);
+		StreamIfOversized(buffer, sendFlag);
+	}
+	Submit(InterlinkCommands::Send{.Target = who, .Buffer = std::move(buffer), .Flag = sendFlag});
+	return status;
+}
+
+InterlinkSendStatus Interlink::SendToClient(const ClientID &client, const IPacket &packet,
+											NetworkMessageSendFlag sendFlag)
+{
+	ASSERT(IsInit, "Interlink was not initialized");
+	// The proxy is the one end clients are connected to directly
+	if (SelfID.Type == NetworkIdentityType::eProxy)
+		return SendMessage(NetworkIdentity(NetworkIdentityType::eGameClient, client), packet,
+						   sendFlag);
+	if (!packet.Validate())
+	{
+		logger.ErrorFormatted(
+			"Interlink::SendToClient: Packet of type {} did not validate successfully",
+			packet.GetPacketName());
+		return InterlinkSendStatus::eDropped;
+	}
+	const std::optional<VirtualChannelTable::Route> route = Channels.RouteOf(client);
+	if (!route)
+	{
+		logger.WarningFormatted("No channel open to client {}", UUIDGen::ToString(client));
+		return InterlinkSendStatus::eDropped;
+	}
+	const InterlinkSendStatus status = PendingSends.Pressure(route->Link, sendFlag);
+	if (status == InterlinkSendStatus::eDropped)
+		return status;
+
+	Submit(InterlinkCommands::ChannelSend{.Link = route->Link,
+										  .Channel = route->Channel,
+										  .Buffer = SerializeForSend(packet, 1),
+										  .Flag = sendFlag});
+	return status;
+}
+
+InterlinkSendStatus Interlink::SendMessageToMany(std::span<const NetworkIdentity> recipients,
+												 const IPacket &packet,
+												 NetworkMessageSendFlag sendFlag)
+{
+	ASSERT(IsInit, "Interlink was not initialized");
+	if (!packet.Validate())
+	{
+		logger.ErrorFormatted(
+			"Interlink::SendMessageToMany: Packet of type {} did not validate "
+			"successfully",
+			packet.GetPacketName());
+		return InterlinkSendStatus::eDropped;
+	}
+
+	InterlinkSendStatus worst = InterlinkSendStatus::eAccepted;
+	std::vector<NetworkIdentity> targets;
+	targets.reserve(recipients.size());
+	for (const NetworkIdentity &who : recipients)
+	{
+		const InterlinkSendStatus status = PendingSends.Pressure(who, sendFlag);
+		worst = std::max(worst, status);
+		if (status != InterlinkSendStatus::eDropped)
+			targets.push_back(who);
+	}
+	if (targets.empty())
+		return recipients.empty() ? InterlinkSendStatus::eAccepted : InterlinkSendStatus::eDropped;
+
+	OutboundBufferPtr buffer = SerializeForSend(packet, (uint32_t)targets.size());
+	buffer->Lane = LaneOf(packet);
+	logger.DebugFormatted("Multicast {} of {} bytes to {} recipients", packet.GetPacketName(),
+						  buffer->Writer.size(), targets.size());
+	if (std::ranges::all_of(targets, [](const NetworkIdentity &r) { return r.IsInternal(); }))
+	{
+		Compressor.Compress(packet.GetPacketType(), buffer);
+		StreamIfOversized(buffer, sendFlag);
+	}
+	Submit(InterlinkCommands::SendMany{
+		.Targets = std::move(targets), .Buffer = std::move(buffer), .Flag = sendFlag});
+	return worst;
+}
+
+void Interlink::Submit(InterlinkCommand &&command)
+{
+	if (OnTickThread())
+	{
+		std::visit([this](auto &c) { Execute(c); }, command);
 		return;
 	}
+	Commands.Push(std::move(command));
+	RequestWake(InterlinkWakeReason::eOutbound);
+}
+
+void Interlink::ProcessCommands()
+{
+	while (auto command = Commands.Pop())
+	{
+		std::visit([this](auto &c) { Execute(c); }, *command);
+	}
+}
+
+void Interlink::Execute(InterlinkCommands::Send &command)
+{
+	RouteToTarget(command.Target, command.Buffer, command.Flag);
+}
 
-	auto QueueMessageOnConnect = [&]()
-	{ QueuedPacketsOnConnect[who].push_back(std::make_pair(packet, sendFlag)); };
+void Interlink::Execute(InterlinkCommands::SendMany &command)
+{
+	// Every connected target gets a message referencing the same buffer
+	for (const NetworkIdentity &who : command.Targets)
+		RouteToTarget(who, command.Buffer, command.Flag);
+}
 
-	if (!Connections.get<IndexByTarget>().contains(who))
+void Interlink::Execute(InterlinkCommands::ChannelSend &command)
+{
+	const bool reliable = ((int)command.Flag & k_nSteamNetworkingSend_Reliable) != 0;
+	ChannelFrames &frames = PendingChannelFrames[command.Link];
+	PendingChannelFrame &frame = reliable ? frames.Reliable : frames.Unreliable;
+	if (!frame.Buffer)
 	{
-		logger.DebugFormatted("Connection to \"{}\" was not established, connecting...",
-							  who.ToString());
-		EstablishConnectionTo(who);
-		QueueMessageOnConnect();
+		frame.Buffer = OutboundBuffer::Create();
+		frame.Buffer->Lane = (uint16_t)PacketLane::eDefault;
+		PacketChannelFrame::Begin(frame.Buffer->Writer);
+	}
+	PacketChannelFrame::Append(frame.Buffer->Writer, command.Channel,
+							   command.Buffer->Writer.bytes());
+	frame.Messages++;
+	TickTelemetry.ChannelMessagesOut.fetch_add(1, std::memory_order_relaxed);
+	if (frame.Buffer->Writer.size() >= Properties.ChannelFrameBytes)
+		FlushChannelFrame(command.Link, frame, reliable);
+}
+
+void Interlink::FlushChannelFrames()
+{
+	for (auto &[link, frames] : PendingChannelFrames)
+	{
+		FlushChannelFrame(link, frames.Reliable, true);
+		FlushChannelFrame(link, frames.Unreliable, false);
+	}
+}
+
+void Interlink::FlushChannelFrame(const NetworkIdentity &link, PendingChannelFrame &frame,
+								  bool reliable)
+{
+	if (!frame.Buffer)
+		return;
+	TickTelemetry.MessagesPerChannelFrame.Record(frame.Messages);
+	// Already coalesced, nothing to gain from GNS holding it back as well
+	NetworkMessageSendFlag flag =
+		reliable ? NetworkMessageSendFlag::eReliableNow : NetworkMessageSendFlag::eUnreliableNow;
+	StreamIfOversized(frame.Buffer, flag);
+	RouteToTarget(link, frame.Buffer, flag);
+	frame = PendingChannelFrame();
+}
+
+void Interlink::DropPeer(const Connection &c)
+{
+	Streams.DropSender(c.target);
+	PendingSends.Forget(c.target);
+	Channels.Forget(c.target);
+	PendingChannelFrames.erase(c.target);
+	Tuner.Forget(c.SteamConnection);
+}
+
+void Interlink::Execute(InterlinkCommands::DeliverClient &command)
+{
+	Dispatcher.Dispatch(std::move(command.Packet),
+						PacketManager::PacketInfo{.sender = command.Sender});
+}
+
+void Interlink::Execute(InterlinkCommands::ActivateClient &command)
+{
+	const NetworkIdentity client(NetworkIdentityType::eGameClient, command.Client);
+	if (!Connections.get<IndexByTarget>().contains(client))
+	{
+		logger.DebugFormatted("Client {} left before its activation on {}", client.ToString(),
+							  command.Shard.ToString());
+		return;
 	}
-	else if (auto find = Connections.get<IndexByTarget>().find(who);
-			 find->state != ConnectionState::eConnected)
+	ClientTransferPacket::TransferActivateStageData activate;
+	activate.Client = command.Client;
+	// Without a channel the client's traffic stays on the proxy
+	const std::optional<ChannelID> channel = Channels.Open(command.Shard, command.Client);
+	if (!channel)
+		logger.WarningFormatted("No channel left to {} for client {}", command.Shard.ToString(),
+								client.ToString());
+	activate.Channel = channel.value_or(InvalidChannelID);
+
+	ClientTransferPacket packet;
+	packet.TransferID = UUIDGen::Gen();
+	packet.stage = ClientTransferPacket::MsgStage::eProxyTransferActivate;
+	packet.Data = std::move(activate);
+	SendMessage(command.Shard, packet, NetworkMessageSendFlag::eReliableBatched);
+}
+
+void Interlink::Execute(InterlinkCommands::Connect &command)
+{
+	ConnectTo(command.Target);
+}
+
+void Interlink::Execute(InterlinkCommands::ConnectAtIP &command)
+{
+	ConnectAtIP(command.Target, command.Address);
+}
+
+void Interlink::Execute(InterlinkCommands::Resolved &command)
+{
+	Resolving.erase(command.Target);
+	if (auto warm = WarmPeers.find(command.Target); warm != WarmPeers.end())
 	{
-		if (find->state == ConnectionState::ePreConnecting ||
-			find->state == ConnectionState::eConnecting)
+		WarmPeer &peer = warm->second;
+		if (command.Adopt || command.Address.has_value())
+			peer.Backoff = {};
+		else
 		{
-			logger.DebugFormatted(
-				"Connection to {} is {} , queuing message...", who.ToString(),
-				boost::describe::enum_to_string(Connections.get<IndexByTarget>().find(who)->state,
-												"unknown"));
-			QueueMessageOnConnect();
+			peer.Backoff = std::min(peer.Backoff.count() == 0 ? Properties.WarmPeerRetryInterval
+															  : peer.Backoff * 2,
+									Properties.WarmPeerMaxBackoff);
+			peer.NextAttempt = std::chrono::steady_clock::now() + peer.Backoff;
+			logger.DebugFormatted("Warm peer {} did not resolve, next try in {}ms",
+								  command.Target.ToString(), peer.Backoff.count());
 		}
-		else
+	}
+	if (command.Adopt)
+	{
+		// The transport's OnReachable flushes whatever queued up meanwhile
+		command.Adopt();
+		return;
+	}
+	if (!command.Address.has_value())
+	{
+		if (const size_t dropped = PendingSends.Abandon(command.Target))
 		{
-			logger.DebugFormatted(
-				"Connection to {} state is {} , connecting...", who.ToString(),
-				boost::describe::enum_to_string(Connections.get<IndexByTarget>().find(who)->state,
-												"unknown"));
-			EstablishConnectionTo(who);
-			QueueMessageOnConnect();
+			logger.ErrorFormatted("Dropping {} messages queued for unreachable {}", dropped,
+								  command.Target.ToString());
 		}
+		return;
+	}
+
+	Connection conn;
+	conn.address = command.Address.value();
+	conn.target = command.Target;
+	conn.SetNewState(ConnectionState::ePreConnecting);
+	Connections.insert(conn);
+
+	logger.DebugFormatted("Establishing internal connection to {}", command.Target.ToString());
+}
+
+void Interlink::Execute(InterlinkCommands::Close &command)
+{
+	CloseConnection(command.Target, command.Reason,
+					command.Debug.empty() ? nullptr : command.Debug.c_str());
+}
+
+void Interlink::Execute(InterlinkCommands::SetWarmPeers &command)
+{
+	// Peers that stay keep their backoff
+	std::unordered_map<NetworkIdentity, WarmPeer> peers;
+	for (const NetworkIdentity &peer : command.Peers)
+	{
+		auto it = WarmPeers.find(peer);
+		peers.emplace(peer, it != WarmPeers.end() ? it->second : WarmPeer{});
+	}
+	WarmPeers = std::move(peers);
+	logger.DebugFormatted("Keeping {} peers warm", WarmPeers.size());
+	MaintainWarmPeers(true);
+}
+
+void Interlink::MaintainWarmPeers(bool force)
+{
+	const auto now = std::chrono::steady_clock::now();
+	if (WarmPeers.empty() || (!force && now < NextWarmPeerCheck))
+		return;
+	NextWarmPeerCheck = now + Properties.WarmPeerRetryInterval;
+
+	const auto &byTarget = Connections.get<IndexByTarget>();
+	for (const auto &[peer, state] : WarmPeers)
+	{
+		if (now < state.NextAttempt || byTarget.contains(peer) || Resolving.contains(peer))
+			continue;
+		logger.DebugFormatted("Warming connection to {}", peer.ToString());
+		ConnectTo(peer);
+	}
+}
+
+void Interlink::Execute(InterlinkCommands::QueryTelemetry &command)
+{
+	std::vector<ConnectionTelemetry> out;
+	CollectConnectionTelemetry(out);
+	command.Result->set_value(std::move(out));
+}
+
+void Interlink::RouteToTarget(const NetworkIdentity &who, const OutboundBufferPtr &buffer,
+							  NetworkMessageSendFlag sendFlag)
+{
+	for (const auto &transport : Transports)
+	{
+		if (transport->Send(who, buffer, sendFlag))
+			return;
+	}
+	auto &byTarget = Connections.get<IndexByTarget>();
+	const auto find = byTarget.find(who);
+	if (find != byTarget.end() && find->state == ConnectionState::eConnected)
+	{
+		buffer->AppendMessages(PendingOutbound, find->SteamConnection, (int)sendFlag,
+							   find->IsInternal());
+		return;
+	}
+
+	if (find == byTarget.end())
+	{
+		logger.DebugFormatted("Connection to \"{}\" was not established, connecting...",
+							  who.ToString());
+		ConnectTo(who);
+	}
+	else if (find->state == ConnectionState::ePreConnecting ||
+			 find->state == ConnectionState::eConnecting)
+	{
+		logger.DebugFormatted("Connection to {} is {} , queuing message...", who.ToString(),
+							  boost::describe::enum_to_string(find->state, "unknown"));
 	}
 	else
 	{
-		const Connection &conn = *Connections.get<IndexByTarget>().find(who);
+		logger.DebugFormatted("Connection to {} state is {} , connecting...", who.ToString(),
+							  boost::describe::enum_to_string(find->state, "unknown"));
+		ConnectTo(who);
+	}
+	if (PendingSends.Push(who, buffer, sendFlag) == InterlinkSendStatus::eDropped)
+	{
+		logger.DebugFormatted("Dropped message with send flag {} to {} while connecting",
+							  (int)sendFlag, who.ToString());
+	}
+}
 
-		ByteWriter bw;
-		packet->Serialize(bw);
-		const auto data_span = bw.bytes();
-		const auto SendResult = networkInterface->SendMessageToConnection(
-			conn.SteamConnection, data_span.data(), data_span.size_bytes(), (int)sendFlag, nullptr);
+void Interlink::FlushOutbound()
+{
+	if (PendingOutbound.empty())
+		return;
+	SendResults.resize(PendingOutbound.size());
+	// GNS takes ownership of every message, sent or not
+	networkInterface->SendMessages((int)PendingOutbound.size(), PendingOutbound.data(),
+								   SendResults.data());
 
-		if (SendResult != k_EResultOK)
+	uint64_t failures = 0;
+	for (int64 result : SendResults)
+	{
+		if (result < 0)
 		{
+			failures++;
 			logger.ErrorFormatted(
 				"Unable to send message. SteamNetworkingSockets returned "
 				"result code {}",
-				(int)SendResult);
-		}
-		else
-		{
-			logger.DebugFormatted("Message of size {} bytes sent to {}", data_span.size_bytes(),
-								  who.ToString());
+				-result);
 		}
 	}
+	TickTelemetry.MessagesSent.fetch_add(PendingOutbound.size() - failures,
+										 std::memory_order_relaxed);
+	TickTelemetry.SendFailures.fetch_add(failures, std::memory_order_relaxed);
+	TickTelemetry.MessagesPerFlush.Record(PendingOutbound.size());
+	PendingOutbound.clear();
 }
 
 void Interlink::GenerateNewConnections()
@@ -185,6 +613,7 @@ void Interlink::GenerateNewConnections()
 		}
 		else
 		{
+			ApplyLinkProfile(conn, connection.target.Type);
 			IndiciesByState.modify(it, [conn = conn](Connection &c) { c.SteamConnection = conn; });
 		}
 	}
@@ -235,31 +664,27 @@ void Interlink::CallbackOnConnecting(SteamCBInfo info)
 		ID.Deserialize(br);
 	}
 
-	// If connection is internal?
+	// Internal peers the registry snapshot does not know are left connecting while Admission
+	// asks Redis, the answer comes back as an Admit command
+	const bool admitNow = Admission.Admit(info->m_hConn, ID);
 	if (ID.IsInternal())
 	{
-		bool known = false;
-
-		known = ServerRegistry::Get().ExistsInRegistry(ID);
-
-		logger.DebugFormatted(
-			"Incoming Internal Connection from: {} at {} (In Server Registry? "
-			"{})",
-			ID.ToString(), address.ToString(), known ? "yes" : "no");
+		logger.DebugFormatted("Incoming Internal Connection from: {} at {} (In Server Registry? {})",
+							  ID.ToString(), address.ToString(), admitNow ? "yes" : "checking");
 	}
 	else
 	{
 		logger.DebugFormatted("Incoming External Connection from: {} at {} ", ID.ToString(),
 							  address.ToString());
 	}
-	// Accept the connection
-	if (EResult result = networkInterface->AcceptConnection(info->m_hConn); result != k_EResultOK)
+	ApplyLinkProfile(info->m_hConn, ID.Type);
+	if (admitNow)
 	{
-		logger.ErrorFormatted("Error accepting connection: reason: {}", uint64(result));
-		networkInterface->CloseConnection(info->m_hConn, 0, nullptr, false);
-		return;
+		if (!Admission.Accept(networkInterface, info->m_hConn))
+			return;
+		if (ID.IsInternal())
+			TickTelemetry.AdmittedFromSnapshot.fetch_add(1, std::memory_order_relaxed);
 	}
-	// Register new connection (mark external if not registry-known)
 	Connection newCon;
 	newCon.SteamConnection = info->m_hConn;
 	newCon.SetNewState(ConnectionState::eConnecting);
@@ -269,6 +694,34 @@ void Interlink::CallbackOnConnecting(SteamCBInfo info)
 	Connections.insert(newCon);
 }
 
+void Interlink::Execute(InterlinkCommands::Admit &command)
+{
+	auto &bySteam = Connections.get<IndexByHSteamNetConnection>();
+	auto it = bySteam.find(command.Connection);
+	// Gave up or was closed while we were asking
+	if (it == bySteam.end())
+		return;
+	TickTelemetry.AdmissionLookupUsec.Record(
+		std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() -
+															  command.Requested)
+			.count());
+	if (!command.Known)
+	{
+		logger.WarningFormatted("Rejecting {} at {}, it is not in the ServerRegistry",
+								it->target.ToString(), it->address.ToString());
+		TickTelemetry.AdmissionRejected.fetch_add(1, std::memory_order_relaxed);
+		Admission.Reject(networkInterface, command.Connection);
+		bySteam.erase(it);
+		return;
+	}
+	if (!Admission.Accept(networkInterface, command.Connection))
+	{
+		bySteam.erase(it);
+		return;
+	}
+	TickTelemetry.AdmittedAfterLookup.fetch_add(1, std::memory_order_relaxed);
+}
+
 void Interlink::CallbackOnClosedByPear(SteamCBInfo info)
 {
 	auto &bySteam = Connections.get<IndexByHSteamNetConnection>();
@@ -289,6 +742,8 @@ void Interlink::CallbackOnClosedByPear(SteamCBInfo info)
 	networkInterface->CloseConnection(info->m_hConn, 0, "Connection closed by peer. aka you", true);
 
 	// Remove from internal table BEFORE notifying callbacks.
+	LeavePollGroup(*it);
+	DropPeer(*it);
 	bySteam.erase(it);
 }
 
@@ -308,6 +763,8 @@ void Interlink::CallbackOnProblemDetectedLocally(SteamCBInfo info)
 	logger.DebugFormatted("Connection closed by peer: {}", closedID.ToString());
 
 	// Remove from internal table BEFORE notifying callbacks.
+	LeavePollGroup(*it);
+	DropPeer(*it);
 	bySteam.erase(it);
 }
 
@@ -320,13 +777,6 @@ void Interlink::CallbackOnConnected(SteamCBInfo info)
 	{
 		indiciesBySteamConn.modify(
 			v, [](Connection &c) { c.SetNewState(ConnectionState::eConnected); });
-		bool result =
-			networkInterface->SetConnectionPollGroup(v->SteamConnection, PollGroup.value());
-		if (!result)
-		{
-			logger.ErrorFormatted("Failed to assign connection from {} to pollgroup",
-								  v->target.ToString());
-		}
 
 		if (!v->IsInternal())
 		{
@@ -334,17 +784,20 @@ void Interlink::CallbackOnConnected(SteamCBInfo info)
 			OnClientConnected(*v);
 		}
 		else
-			logger.DebugFormatted(" - {} Connected", v->target.ToString());
-
-		if (QueuedPacketsOnConnect.contains(v->target) &&
-			!QueuedPacketsOnConnect.at(v->target).empty())
 		{
-			for (const auto &[msg, sendflag] : QueuedPacketsOnConnect.at(v->target))
-			{
-				SendMessage(v->target, msg, sendflag);
-			}
-			QueuedPacketsOnConnect.erase(v->target);
+			logger.DebugFormatted(" - {} Connected", v->target.ToString());
+			ConfigureLanes(v->SteamConnection);
 		}
+		// After OnClientConnected, a client's messages are attributed to the ID assigned there
+		JoinPollGroup(*v);
+		Tuner.Track(v->SteamConnection, Properties.Links.For(v->target.Type));
+
+		PendingSends.Flush(v->target,
+						   [&](const OutboundBufferPtr &buffer, NetworkMessageSendFlag sendflag)
+						   {
+							   buffer->AppendMessages(PendingOutbound, v->SteamConnection,
+													  (int)sendflag, v->IsInternal());
+						   });
 	}
 	else
 	{
@@ -387,46 +840,333 @@ void Interlink::OpenListenSocket(PortType port)
 	logger.DebugFormatted("Opened listen socket on port {}", port);
 }
 
-void Interlink::ReceiveMessages()
+uint32_t Interlink::ReceiveMessages()
 {
-	ISteamNetworkingMessage *pIncomingMessages[32];
-	int numMsgs =
-		networkInterface->ReceiveMessagesOnPollGroup(PollGroup.value(), pIncomingMessages, 32);
+	const ReceiveDrainStats stats = Receiver.Drain(
+		networkInterface, InternalPollGroup.value(),
+		[&](ISteamNetworkingMessage *msg)
+		{
+			const Connection &sender =
+				*Connections.get<IndexByHSteamNetConnection>().find(msg->m_conn);
+
+			const void *data = msg->m_pData;
+			size_t size = msg->m_cbSize;
 
-	for (int i = 0; i < numMsgs; ++i)
+			std::span<const uint8_t> span = std::span<const uint8_t>((uint8_t *)data, size);
+			logger.DebugFormatted(
+				"Message from ({}{}) of {} bytes", !sender.IsInternal() ? "External " : "",
+				!sender.IsInternal() ? sender.address.ToString() : sender.target.ToString(),
+				span.size());
+			Deliver(sender.target, span,
+					(msg->m_nFlags & k_nSteamNetworkingSend_Reliable)
+						? NetworkMessageSendFlag::eReliableBatched
+						: NetworkMessageSendFlag::eUnreliableBatched);
+			msg->Release();
+		});
+	TickTelemetry.Receive.Record(stats, Receiver.GetBatchSize());
+	return stats.Messages;
+}
+
+void Interlink::JoinPollGroup(const Connection &c)
+{
+	HSteamNetPollGroup group = InternalPollGroup.value();
+	if (!c.IsInternal())
+	{
+		{
+			std::lock_guard lock(ClientSendersMutex);
+			ClientSenders[c.SteamConnection] = c.target;
+		}
+		ClientSendersCV.notify_one();
+		group = ClientPollGroup.value();
+	}
+	if (!networkInterface->SetConnectionPollGroup(c.SteamConnection, group))
 	{
-		ISteamNetworkingMessage *msg = pIncomingMessages[i];
+		logger.ErrorFormatted("Failed to assign connection from {} to pollgroup",
+							  c.target.ToString());
+	}
+}
 
-		const Connection &sender = *Connections.get<IndexByHSteamNetConnection>().find(msg->m_conn);
+void Interlink::LeavePollGroup(const Connection &c)
+{
+	if (c.IsInternal())
+		return;
+	std::lock_guard lock(ClientSendersMutex);
+	ClientSenders.erase(c.SteamConnection);
+}
 
-		const void *data = msg->m_pData;
-		size_t size = msg->m_cbSize;
+void Interlink::ClientReceiveThreadEntry(std::stop_token st)
+{
+	while (!st.stop_requested())
+	{
+		{
+			// Nothing to poll until the first client connects, which on most servers is never
+			std::unique_lock lock(ClientSendersMutex);
+			ClientSendersCV.wait(lock, st, [this] { return !ClientSenders.empty(); });
+		}
+		if (st.stop_requested())
+			break;
+		if (ReceiveClientMessages() == 0)
+		{
+			// Same as the tick thread, GNS cannot tell us when the poll group has data
+			std::unique_lock lock(ClientSendersMutex);
+			ClientSendersCV.wait_for(lock, st, Properties.IdleWakeDeadline, [] { return false; });
+		}
+	}
+}
 
-		// Normal internal dispatch
-		std::span<const uint8_t> span = std::span<const uint8_t>((uint8_t *)data, size);
-		const auto packet = PacketRegistry::Get().CreateFromBytes(span);
-		logger.DebugFormatted("Arrived Packet of type {}. Dispatching...", packet->GetPacketName());
-		packet_manager.Dispatch(*packet, packet->GetPacketType(),
-								PacketManager::PacketInfo{.sender = sender.target});
+uint32_t Interlink::ReceiveClientMessages()
+{
+	const ReceiveDrainStats stats = ClientReceiver.Drain(
+		networkInterface, ClientPollGroup.value(),
+		[&](ISteamNetworkingMessage *msg)
+		{
+			NetworkIdentity sender;
+			{
+				std::lock_guard lock(ClientSendersMutex);
+				if (auto it = ClientSenders.find(msg->m_conn); it != ClientSenders.end())
+					sender = it->second;
+			}
+			const std::span<const uint8_t> bytes((const uint8_t *)msg->m_pData,
+												 (size_t)msg->m_cbSize);
+			const NetworkMessageSendFlag flag = (msg->m_nFlags & k_nSteamNetworkingSend_Reliable)
+													? NetworkMessageSendFlag::eReliableBatched
+													: NetworkMessageSendFlag::eUnreliableBatched;
+			// Still queued from a connection closed since
+			if (sender.Type != NetworkIdentityType::eInvalid &&
+				!ForwardFromClient(sender, bytes, flag))
+				DeliverFromClient(sender, bytes);
+			msg->Release();
+		});
+	TickTelemetry.ClientReceive.Record(stats, ClientReceiver.GetBatchSize());
+	return stats.Messages;
+}
 
-		logger.DebugFormatted(
-			"Message from ({}{}) of {} bytes", !sender.IsInternal() ? "External " : "",
-			!sender.IsInternal() ? sender.address.ToString() : sender.target.ToString(),
-			span.size());
+void Interlink::DeliverFromClient(const NetworkIdentity &sender, std::span<const uint8_t> span)
+{
+	static const PacketRegistry &registry = PacketRegistry::Get();
+	const auto decodeStart = std::chrono::steady_clock::now();
+	const PacketTypeID type = PacketRegistry::PeekPacketType(span);
+	if (type == PacketStreamChunkHeader::TypeID || type == RelayPacket::TypeID ||
+		type == PacketCompressedHeader::TypeID || type == PacketChannelFrame::TypeID)
+	{
+		logger.WarningFormatted("Dropping internal frame of {} bytes from client {}", span.size(),
+								sender.ToString());
+		return;
+	}
+	PooledPacket packet = registry.AcquireFromBytes(span);
+	if (!packet)
+		return;
+	PacketMetrics::RecordReceive(type, span.size(),
+								 std::chrono::duration_cast<std::chrono::nanoseconds>(
+									 std::chrono::steady_clock::now() - decodeStart)
+									 .count());
+	// eNetworkThread handlers only ever run on the tick thread, never concurrently with each other
+	Submit(InterlinkCommands::DeliverClient{.Sender = sender, .Packet = std::move(packet)});
+}
 
-		msg->Release();
+bool Interlink::ForwardFromClient(const NetworkIdentity &sender, std::span<const uint8_t> bytes,
+								  NetworkMessageSendFlag sendFlag)
+{
+	if (SelfID.Type != NetworkIdentityType::eProxy)
+		return false;
+	const std::optional<VirtualChannelTable::Route> route = Channels.RouteOf(sender.ID);
+	if (!route)
+		return false;
+
+	// The receive buffer goes back to GNS once this returns
+	OutboundBufferPtr buffer = OutboundBuffer::Create();
+	buffer->Writer = ByteWriter(bytes.size());
+	buffer->Writer.write(bytes.data(), bytes.size());
+	Submit(InterlinkCommands::ChannelSend{.Link = route->Link,
+										  .Channel = route->Channel,
+										  .Buffer = std::move(buffer),
+										  .Flag = sendFlag});
+	return true;
+}
+
+void Interlink::DeliverChannelFrame(const NetworkIdentity &sender, std::span<const uint8_t> frame,
+									NetworkMessageSendFlag sendFlag)
+{
+	const bool toClients = SelfID.Type == NetworkIdentityType::eProxy;
+	uint64_t messages = 0;
+	const bool intact = PacketChannelFrame::ForEach(
+		frame,
+		[&](ChannelID channel, std::span<const uint8_t> bytes)
+		{
+			messages++;
+			const std::optional<ClientID> client = Channels.ClientOn(sender, channel);
+			if (!client)
+			{
+				TickTelemetry.ChannelDropped.fetch_add(1, std::memory_order_relaxed);
+				return;
+			}
+			const NetworkIdentity clientIdentity(NetworkIdentityType::eGameClient, *client);
+			if (!toClients)
+			{
+				DeliverFromClient(clientIdentity, bytes);
+				return;
+			}
+			OutboundBufferPtr buffer = OutboundBuffer::Create();
+			buffer->Writer = ByteWriter(bytes.size());
+			buffer->Writer.write(bytes.data(), bytes.size());
+			RouteToTarget(clientIdentity, buffer, sendFlag);
+		});
+	TickTelemetry.ChannelMessagesIn.fetch_add(messages, std::memory_order_relaxed);
+	if (!intact)
+	{
+		logger.ErrorFormatted("Malformed channel frame of {} bytes from {}", frame.size(),
+							  sender.ToString());
+		TickTelemetry.ChannelDropped.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+void Interlink::OnChannelActivation(const ClientTransferPacket &packet,
+									const NetworkIdentity &proxy)
+{
+	if (packet.stage != ClientTransferPacket::MsgStage::eProxyTransferActivate ||
+		proxy.Type != NetworkIdentityType::eProxy)
+		return;
+	const auto *activate =
+		std::get_if<ClientTransferPacket::TransferActivateStageData>(&packet.Data);
+	if (!activate || activate->Channel == InvalidChannelID)
+		return;
+	Channels.Adopt(proxy, activate->Channel, activate->Client);
+}
+
+uint32_t Interlink::PollTransports()
+{
+	uint32_t received = 0;
+	for (const auto &transport : Transports)
+		received += transport->Poll(DeliverFromTransport);
+	return received;
+}
+
+void Interlink::Deliver(const NetworkIdentity &sender, std::span<const uint8_t> span,
+						NetworkMessageSendFlag sendFlag)
+{
+	const auto decodeStart = std::chrono::steady_clock::now();
+	std::optional<PacketStreamAssembler::Completed> completed;
+	if (PacketRegistry::PeekPacketType(span) == PacketStreamChunkHeader::TypeID)
+	{
+		// Copied into the stream's buffer, nothing to dispatch until the last chunk
+		completed = Streams.Accept(sender, span);
+		if (!completed)
+			return;
+		span = completed->Bytes();
 	}
+	if (PacketRegistry::PeekPacketType(span) == PacketChannelFrame::TypeID)
+	{
+		DeliverChannelFrame(sender, span, sendFlag);
+		return;
+	}
+	const size_t packetBytes = span.size();
+	PooledPacket packet;
+	if (PacketRegistry::PeekPacketType(span) != RelayPacket::TypeID ||
+		UnwrapRelay(sender, span, sendFlag))
+		packet = Compressor.Decode(span);
+	if (!packet)
+		return;
+	PacketMetrics::RecordReceive(packet->GetPacketType(), packetBytes,
+								 std::chrono::duration_cast<std::chrono::nanoseconds>(
+									 std::chrono::steady_clock::now() - decodeStart)
+									 .count());
+	logger.DebugFormatted("Arrived Packet of type {}. Dispatching...", packet->GetPacketName());
+	Dispatcher.Dispatch(std::move(packet), PacketManager::PacketInfo{.sender = sender});
 }
 
-void Interlink::Init()
+bool Interlink::UnwrapRelay(const NetworkIdentity &sender, std::span<const uint8_t> &bytes,
+							NetworkMessageSendFlag sendFlag)
+{
+	const std::optional<RelayPacket::View> relay = RelayPacket::Peek(bytes);
+	if (!relay)
+	{
+		logger.ErrorFormatted("Dropping malformed relay of {} bytes from {}", bytes.size(),
+							  sender.ToString());
+		return false;
+	}
+	if (relay->FinalTarget == SelfID)
+	{
+		bytes = relay->Inner;
+		return true;
+	}
+
+	// The one copy a hop makes, the receive buffer goes back to GNS once this returns
+	OutboundBufferPtr buffer = OutboundBuffer::Create();
+	buffer->Writer = ByteWriter(relay->Inner.size());
+	buffer->Writer.write(relay->Inner.data(), relay->Inner.size());
+	buffer->Lane = LaneOf(relay->InnerType);
+	if (relay->FinalTarget.IsInternal())
+	{
+		Compressor.Compress(relay->InnerType, buffer);
+		StreamIfOversized(buffer, sendFlag);
+	}
+	logger.DebugFormatted("Relaying {} bytes from {} to {}", relay->Inner.size(),
+						  sender.ToString(), relay->FinalTarget.ToString());
+	RouteToTarget(relay->FinalTarget, buffer, sendFlag);
+	return false;
+}
+
+void Interlink::Init(const InterlinkProperties &properties)
 {
 	logger.Debug("Interlink init");
-	ASSERT(NetworkCredentials::Get().GetID().Type != NetworkIdentityType::eInvalid, "Invalid Interlink Type");
-	ASSERT(NetworkCredentials::Get().GetID().IsInternal(), "Interlink is for internal only");
+	Properties = properties;
+	Receiver.Configure(Properties.Receive);
+	ClientReceiver.Configure(Properties.ClientReceive);
+	PendingSends.Configure(Properties.PendingSends);
+	Tuner.Configure(Properties.Tuning);
+	if (!Properties.CompressionDictionaryDir.empty())
+		Compressor.LoadDictionaries(Properties.CompressionDictionaryDir);
+	SelfID = Properties.ThisID.Type != NetworkIdentityType::eInvalid
+				 ? Properties.ThisID
+				 : NetworkCredentials::Get().GetID();
+	ASSERT(SelfID.Type != NetworkIdentityType::eInvalid, "Invalid Interlink Type");
+	ASSERT(SelfID.IsInternal(), "Interlink is for internal only");
+
+	DeliverFromTransport = [this](const NetworkIdentity &sender, std::span<const uint8_t> bytes,
+								  NetworkMessageSendFlag sendFlag)
+	{ Deliver(sender, bytes, sendFlag); };
+	Transports.push_back(std::make_unique<LoopbackTransport>(
+		SelfID, [this] { RequestWake(InterlinkWakeReason::eTransport); }));
+	if (Properties.Transport == InterlinkTransportMode::eNetwork && !InitNetwork())
+		return;
+	for (const auto &transport : Transports)
+	{
+		transport->OnReachable = [this](const NetworkIdentity &who)
+		{
+			PendingSends.Flush(who, [&](const OutboundBufferPtr &buffer, NetworkMessageSendFlag flag)
+							   { RouteToTarget(who, buffer, flag); });
+		};
+	}
+
+	if (Properties.DispatchWorkers > 0)
+		Dispatcher.Start(Properties.DispatchWorkers);
+	ResolverThread = std::jthread([this](std::stop_token st) { ResolverThreadEntry(st); });
+	Admission.Start(
+		[this](const ConnectionAdmission::Lookup &lookup)
+		{
+			Commands.Push(InterlinkCommands::Admit{.Connection = lookup.Connection,
+												   .Known = lookup.Known,
+												   .Requested = lookup.Requested});
+			RequestWake(InterlinkWakeReason::eOutbound);
+		});
+	if (ClientPollGroup)
+		ClientReceiveThread =
+			std::jthread([this](std::stop_token st) { ClientReceiveThreadEntry(st); });
+	if (SelfID.Type == NetworkIdentityType::eProxy)
+		HandshakeService::Get().Start(SelfID);
+	else
+		ChannelActivation = packet_manager.Subscribe<ClientTransferPacket>(
+			[this](const ClientTransferPacket &packet, const PacketManager::PacketInfo &info)
+			{ OnChannelActivation(packet, info.sender); });
+	TickThread = std::jthread([this](std::stop_token st) { TickThreadEntry(st); });
+	IsInit = true;
+}
 
+bool Interlink::InitNetwork()
+{
 	// Single init per process (no repeated warnings)
 	if (!EnsureGNSInitialized())
-		return;
+		return false;
 
 	SteamNetworkingUtils()->SetDebugOutputFunction(
 		k_ESteamNetworkingSocketsDebugOutputType_Warning,
@@ -437,7 +1177,7 @@ void Interlink::Init()
 
 	// Identity setup (unchanged)
 	ByteWriter bw;
-	NetworkCredentials::Get().GetID().Serialize(bw);
+	SelfID.Serialize(bw);
 	const auto IdentityByteStream = std::string(bw.as_string_view());
 	logger.Debug("Settings Networking Identity");
 	SteamNetworkingIdentity identity;
@@ -445,52 +1185,67 @@ void Interlink::Init()
 		identity.SetGenericBytes(IdentityByteStream.data(), IdentityByteStream.size());
 	ASSERT(SetIdentity, "Failed Identity set");
 	networkInterface->ResetIdentity(&identity);
-	// Create poll group
-	PollGroup = networkInterface->CreatePollGroup();
+	// One poll group per connection class, so each is drained at its own pace
+	InternalPollGroup = networkInterface->CreatePollGroup();
+	ClientPollGroup = networkInterface->CreatePollGroup();
 
 	// grab public address
 	std::optional<std::string> pubIP;
 	std::optional<uint32_t> pubPort;
 	IPAddress pub;
-	OpenListenSocket(_PORT_INTERLINK);
+	OpenListenSocket(Properties.ListenPort);
+	if (!Properties.SharedMemory.Directory.empty())
+	{
+		auto sharedMemory = std::make_unique<SharedMemoryTransport>(
+			SelfID, Properties.SharedMemory,
+			[this] { RequestWake(InterlinkWakeReason::eTransport); });
+		if (sharedMemory->Listen())
+		{
+			HostKey = SharedMemoryTransport::HostKey(Properties.SharedMemory.Directory);
+			Transports.push_back(std::move(sharedMemory));
+		}
+	}
 
 	// registering to database + opening listen sockets
 	IPAddress ipAddress;
-	if (NetworkCredentials::Get().GetID().Type == NetworkIdentityType::eProxy)
+	if (Properties.AdvertiseAddress)
+		ipAddress = *Properties.AdvertiseAddress;
+	else
+		ipAddress.Parse(DockerIO::Get().GetSelfContainerIP() + ":" +
+						std::to_string(Properties.ListenPort));
+	if (SelfID.Type == NetworkIdentityType::eProxy)
 	{
 		// Register Demigod in ProxyRegistry
-		ipAddress.Parse(DockerIO::Get().GetSelfContainerIP() + ":" +
-						std::to_string(_PORT_INTERLINK));
-		// ProxyRegistry::Get().RegisterSelf(NetworkCredentials::Get().GetID(), ipAddress);
-		ServerRegistry::Get().RegisterSelf(NetworkCredentials::Get().GetID(), ipAddress);
+		// ProxyRegistry::Get().RegisterSelf(SelfID, ipAddress);
+		ServerRegistry::Get().RegisterSelf(SelfID, ipAddress);
 
 		// Register public address
 		// pubIP =
 		// DockerIO::Get().GetServiceNodePublicIP(_PROXY_SERVICE_NAME);
 		// pubPort = _PORT_PROXY;
 		// pub.Parse(*pubIP + ":" + std::to_string(*pubPort));
-		// ProxyRegistry::Get().RegisterPublicAddress(NetworkCredentials::Get().GetID(), pub);
-		ServerRegistry::Get().RegisterPublicAddress(NetworkCredentials::Get().GetID(), pub);
+		// ProxyRegistry::Get().RegisterPublicAddress(SelfID, pub);
+		ServerRegistry::Get().RegisterPublicAddress(SelfID, pub);
 
 		logger.DebugFormatted("[Demigod] Public Swarm address = {}", pub.ToString());
 
 		// logger.DebugFormatted("[Interlink]Registered in ProxyRegistry as
 		// {}:{}",
-		//					   NetworkCredentials::Get().GetID().ToString(), ipAddress.ToString());
+		//					   SelfID.ToString(), ipAddress.ToString());
 	}
 	else
 	{
 		// Register internal (container) address
-		IPAddress ipAddress;
-		ipAddress.Parse(DockerIO::Get().GetSelfContainerIP() + ":" +
-						std::to_string(_PORT_INTERLINK));
-		ServerRegistry::Get().RegisterSelf(NetworkCredentials::Get().GetID(), ipAddress);
+		ServerRegistry::Get().RegisterSelf(SelfID, ipAddress);
 		logger.DebugFormatted("[Interlink]Registered in ServerRegistry as {}:{}",
-							  NetworkCredentials::Get().GetID().ToString(), ipAddress.ToString());
+							  SelfID.ToString(), ipAddress.ToString());
 	}
+	if (!HostKey.empty())
+		ServerRegistry::Get().RegisterHost(SelfID, HostKey);
+	ServerRegistry::Get().StartSnapshot();
 
 	// Existing post-init behavior (unchanged)
-	switch (NetworkCredentials::Get().GetID().Type)
+	switch (SelfID.Type)
 	{
 		case NetworkIdentityType::eShard:
 		{
@@ -513,37 +1268,143 @@ void Interlink::Init()
 		default:
 			break;
 	}
+	return true;
+}
 
-	TickThread = std::jthread(
-		[this](std::stop_token st)
+void Interlink::TickThreadEntry(std::stop_token st)
+{
+	using clock = std::chrono::steady_clock;
+	bool lastTickReceived = false;
+	TickThreadId.store(std::this_thread::get_id(), std::memory_order_relaxed);
+
+	while (!st.stop_requested())
+	{
+		const InterlinkWakeReason reason = WaitForWork(st, lastTickReceived);
+		if (reason == InterlinkWakeReason::eShutdown)
+			break;
+		TickTelemetry.CountWakeup(reason);
+
+		const auto tickStart = clock::now();
+		if (const int64_t requestedAt = WakeRequestedAt.exchange(0, std::memory_order_acq_rel);
+			requestedAt != 0)
 		{
-			using clock = std::chrono::steady_clock;
-			auto last = clock::now();
+			const auto waited = tickStart.time_since_epoch().count() - requestedAt;
+			TickTelemetry.WakeLatencyUsec.Record(
+				std::chrono::duration_cast<std::chrono::microseconds>(clock::duration(waited))
+					.count());
+		}
 
-			while (!st.stop_requested())
-			{
-				Tick();
+		lastTickReceived = Tick() > 0;
 
-				auto now = clock::now();
-				if (now - last < std::chrono::milliseconds(2))
-				{
-					std::this_thread::sleep_for(std::chrono::milliseconds(50));
-				}
-				last = now;
-			}
-		});
-	IsInit = true;
+		TickTelemetry.Ticks.fetch_add(1, std::memory_order_relaxed);
+		TickTelemetry.TickDurationUsec.Record(
+			std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - tickStart)
+				.count());
+	}
+	TickThreadId.store(std::thread::id(), std::memory_order_relaxed);
+}
+
+void Interlink::RequestWake(InterlinkWakeReason reason)
+{
+	int64_t expected = 0;
+	WakeRequestedAt.compare_exchange_strong(
+		expected, std::chrono::steady_clock::now().time_since_epoch().count(),
+		std::memory_order_acq_rel);
+
+	PendingWakeMask.fetch_or(1u << (uint32_t)reason, std::memory_order_release);
+	{
+		// Empty critical section orders the mask update against a waiter checking its predicate,
+		// otherwise the notify could land between the check and the wait and get lost.
+		std::lock_guard lock(WakeMutex);
+	}
+	WakeCV.notify_one();
+}
+
+InterlinkWakeReason Interlink::WaitForWork(std::stop_token st, bool lastTickReceived)
+{
+	// Poll group had data last tick, chances are more is waiting. Go again without blocking.
+	if (!lastTickReceived)
+	{
+		std::unique_lock lock(WakeMutex);
+		WakeCV.wait_for(lock, st, Properties.IdleWakeDeadline,
+						[this] { return PendingWakeMask.load(std::memory_order_acquire) != 0; });
+	}
+	if (st.stop_requested())
+		return InterlinkWakeReason::eShutdown;
+
+	const uint32_t mask = PendingWakeMask.exchange(0, std::memory_order_acq_rel);
+	if (mask & (1u << (uint32_t)InterlinkWakeReason::eOutbound))
+		return InterlinkWakeReason::eOutbound;
+	if (mask & (1u << (uint32_t)InterlinkWakeReason::eTransport))
+		return InterlinkWakeReason::eTransport;
+	if (lastTickReceived)
+		return InterlinkWakeReason::eInbound;
+	return InterlinkWakeReason::eDeadline;
 }
 
 void Interlink::Shutdown()
 {
 	CloseAllConnections();
+	// Its worker sends through us
+	HandshakeService::Get().Stop();
+	ChannelActivation.Reset();
 	TickThread.request_stop();
+	WakeCV.notify_all();
 	TickThread.join();
+	if (ClientReceiveThread.joinable())
+	{
+		ClientReceiveThread.request_stop();
+		ClientReceiveThread.join();
+	}
+	Admission.Stop();
+	if (networkInterface)
+		ServerRegistry::Get().StopSnapshot();
+	ResolverThread.request_stop();
+	ResolverThread.join();
+	for (const auto &transport : Transports)
+		transport->Shutdown();
+	Dispatcher.Stop();
+	for (ISteamNetworkingMessage *msg : PendingOutbound)
+		msg->Release();
+	PendingOutbound.clear();
 	logger.Debug("Interlink Shutdown");
 }
 
 bool Interlink::EstablishConnectionAtIP(const NetworkIdentity &id, const IPAddress &address)
+{
+	Submit(InterlinkCommands::ConnectAtIP{.Target = id, .Address = address});
+	return true;
+}
+
+bool Interlink::EstablishConnectionTo(const NetworkIdentity &id)
+{
+	ASSERT(SelfID.Type != NetworkIdentityType::eGameClient, "Game client must use the ip one");
+	if (!id.IsInternal() && id.Type != NetworkIdentityType::eGameClient)
+	{
+		logger.WarningFormatted("Unknown interlink type for {} - skipping connection",
+								SelfID.ToString());
+		return false;
+	}
+	Submit(InterlinkCommands::Connect{.Target = id});
+	return true;
+}
+
+void Interlink::ActivateClient(const NetworkIdentity &shard, const ClientID &client)
+{
+	Submit(InterlinkCommands::ActivateClient{.Shard = shard, .Client = client});
+}
+
+void Interlink::SetWarmPeers(std::vector<NetworkIdentity> peers)
+{
+	Submit(InterlinkCommands::SetWarmPeers{.Peers = std::move(peers)});
+}
+
+void Interlink::CloseConnectionTo(const NetworkIdentity &id, int reason, const char *debug)
+{
+	Submit(InterlinkCommands::Close{.Target = id, .Reason = reason, .Debug = debug ? debug : ""});
+}
+
+void Interlink::ConnectAtIP(const NetworkIdentity &id, const IPAddress &address)
 {
 	// return EstablishConnectionTo(InterLinkIdentifier::MakeIDGod());
 	if (Connections.get<IndexByTarget>().contains(id))
@@ -552,13 +1413,13 @@ bool Interlink::EstablishConnectionAtIP(const NetworkIdentity &id, const IPAddre
 		if (existing.state == ConnectionState::eConnected)
 		{
 			logger.WarningFormatted("Connection to {} already established", id.ToString());
-			return true;
+			return;
 		}
 		else if (existing.state == ConnectionState::eConnecting ||
 				 existing.state == ConnectionState::ePreConnecting)
 		{
 			logger.WarningFormatted("Already connecting to {}", id.ToString());
-			return true;
+			return;
 		}
 	}
 
@@ -592,12 +1453,10 @@ bool Interlink::EstablishConnectionAtIP(const NetworkIdentity &id, const IPAddre
 
 	logger.DebugFormatted("Establishing direct connection to {} at {}", id.ToString(),
 						  address.ToString());
-	return true;
 }
 
-bool Interlink::EstablishConnectionTo(const NetworkIdentity &id)
+void Interlink::ConnectTo(const NetworkIdentity &id)
 {
-	ASSERT(NetworkCredentials::Get().GetID().Type != NetworkIdentityType::eGameClient, "Game client must use the ip one");
 	// Prevent duplicate attempts
 	if (Connections.get<IndexByTarget>().contains(id))
 	{
@@ -605,23 +1464,70 @@ bool Interlink::EstablishConnectionTo(const NetworkIdentity &id)
 		if (existing.state == ConnectionState::eConnected)
 		{
 			logger.WarningFormatted("Connection to {} already established", id.ToString());
-			return true;
+			return;
 		}
 		if (existing.state == ConnectionState::eConnecting ||
 			existing.state == ConnectionState::ePreConnecting)
 		{
 			logger.WarningFormatted("Already connecting to {}", id.ToString());
-			return true;
+			return;
 		}
 	}
+	if (Resolving.contains(id))
+	{
+		logger.WarningFormatted("Already resolving {}", id.ToString());
+		return;
+	}
+	for (const auto &transport : Transports)
+	{
+		if (transport->Reaches(id))
+			return;
+	}
+	if (!networkInterface)
+	{
+		logger.WarningFormatted("{} is not reachable without the network transport",
+								id.ToString());
+		return;
+	}
 	// ---------------------------------------------------------------
-	// INTERNAL: must exist in ServerRegistry
+	// INTERNAL: must exist in ServerRegistry, looked up off the tick thread
 	// ---------------------------------------------------------------
 	if (id.IsInternal())
 	{
+		Resolving.insert(id);
+		{
+			std::lock_guard lock(ResolveMutex);
+			ResolveRequests.push_back(id);
+		}
+		ResolveCV.notify_one();
+		return;
+	}
+
+	// ---------------------------------------------------------------
+	// EXTERNAL: skip registry (for now, nothing directly connects to clients)
+	// ---------------------------------------------------------------
+	// For now, external clients are expected to connect INBOUND to God.
+	// Outbound from inside to a GameClient is not required.
+	logger.WarningFormatted("Skipping registry lookup for external client {}",
+							NetworkCredentials::Get().GetID().ToString());
+}
+
+void Interlink::ResolverThreadEntry(std::stop_token st)
+{
+	while (!st.stop_requested())
+	{
+		NetworkIdentity id;
+		{
+			std::unique_lock lock(ResolveMutex);
+			if (!ResolveCV.wait(lock, st, [this] { return !ResolveRequests.empty(); }))
+				return;
+			id = ResolveRequests.front();
+			ResolveRequests.pop_front();
+		}
+
 		auto IP = ServerRegistry::Get().GetIPOfID(id);
 
-		for (int i = 0; i < 5 && !IP.has_value(); i++)
+		for (int i = 0; i < 5 && !IP.has_value() && !st.stop_requested(); i++)
 		{
 			logger.ErrorFormatted(
 				"IP not found for {} in Server Registry. Trying again in 1 "
@@ -643,46 +1549,34 @@ bool Interlink::EstablishConnectionTo(const NetworkIdentity &id)
 				logger.DebugFormatted(" - {} at {}", Entry.identifier.ToString(),
 									  Entry.address.ToString());
 			}
-
-			return false;  // no assert crash, just graceful fail
 		}
-
-		Connection conn;
-		conn.address = IP.value();
-		conn.target = id;
-		conn.SetNewState(ConnectionState::ePreConnecting);
-		Connections.insert(conn);
-
-		logger.DebugFormatted("Establishing internal connection to {}", id.ToString());
-		return true;
-	}
-
-	// ---------------------------------------------------------------
-	// EXTERNAL: skip registry (for now, nothing directly connects to clients)
-	// ---------------------------------------------------------------
-	if (id.Type == NetworkIdentityType::eGameClient)
-	{
-		// For now, external clients are expected to connect INBOUND to God.
-		// Outbound from inside to a GameClient is not required.
-		logger.WarningFormatted("Skipping registry lookup for external client {}",
-								NetworkCredentials::Get().GetID().ToString());
-		return true;
+		InterlinkCommands::Resolved resolved{.Target = id, .Address = IP};
+		// Same host, try the transports that avoid the network stack before GNS
+		if (IP.has_value() && !HostKey.empty() && ServerRegistry::Get().GetHostOf(id) == HostKey)
+		{
+			for (const auto &transport : Transports)
+			{
+				if ((resolved.Adopt = transport->Negotiate(id)))
+				{
+					logger.DebugFormatted("Reaching {} over {}", id.ToString(),
+										  transport->GetName());
+					break;
+				}
+			}
+		}
+		Commands.Push(std::move(resolved));
+		RequestWake(InterlinkWakeReason::eOutbound);
 	}
-
-	// Default case (unknown type)
-	logger.WarningFormatted("Unknown interlink type for {} - skipping connection",
-							NetworkCredentials::Get().GetID().ToString());
-	return false;
 }
 
-void Interlink::CloseConnectionTo(const NetworkIdentity &id, int reason, const char *debug)
+void Interlink::CloseConnection(const NetworkIdentity &id, int reason, const char *debug)
 {
 	auto &byTarget = Connections.get<IndexByTarget>();
 
 	auto it = byTarget.find(id);
 	if (it == byTarget.end())
 	{
-		logger.WarningFormatted("CloseConnectionTo: No active connection found for {}",
+		logger.WarningFormatted("CloseConnection: No active connection found for {}",
 								id.ToString());
 		return;
 	}
@@ -695,6 +1589,8 @@ void Interlink::CloseConnectionTo(const NetworkIdentity &id, int reason, const c
 	networkInterface->CloseConnection(conn, reason, debug, false);
 
 	// Remove from table
+	LeavePollGroup(*it);
+	DropPeer(*it);
 	byTarget.erase(it);
 }
 /*
@@ -706,25 +1602,54 @@ void Interlink::DebugPrint()
 	}
 }*/
 
-void Interlink::Tick()
+uint32_t Interlink::Tick()
 {
-	GenerateNewConnections();
-	ReceiveMessages();
-	networkInterface->RunCallbacks();  // process events
+	ProcessCommands();
+	MaintainWarmPeers(false);
+	PendingSends.Sweep();
+	if (networkInterface)
+		TuneLinks();
+	uint32_t received = PollTransports();
+	if (networkInterface)
+	{
+		GenerateNewConnections();
+		received += ReceiveMessages();
+		networkInterface->RunCallbacks();  // process events
+	}
+	FlushChannelFrames();
+	FlushOutbound();
+	return received;
 }
 
 void Interlink::GetConnectionTelemetry(std::vector<ConnectionTelemetry> &out)
 {
+	if (OnTickThread())
+	{
+		CollectConnectionTelemetry(out);
+		return;
+	}
 	out.clear();
-
-	ISteamNetworkingSockets *sockets = SteamNetworkingSockets();
-	if (!sockets)
+	if (TickThreadId.load(std::memory_order_relaxed) == std::thread::id())
 		return;
 
+	auto result = std::make_shared<std::promise<std::vector<ConnectionTelemetry>>>();
+	auto future = result->get_future();
+	Submit(InterlinkCommands::QueryTelemetry{.Result = std::move(result)});
+	if (future.wait_for(std::chrono::seconds(1)) == std::future_status::ready)
+		out = future.get();
+}
+
+void Interlink::CollectConnectionTelemetry(std::vector<ConnectionTelemetry> &out)
+{
+	out.clear();
+	for (const auto &transport : Transports)
+		transport->CollectTelemetry(out);
+
+	ISteamNetworkingSockets *sockets = networkInterface;
 	const auto &byState = Connections.get<IndexByState>();
 
 	auto [it, end] = byState.equal_range(ConnectionState::eConnected);
-	for (; it != end; ++it)
+	for (; sockets && it != end; ++it)
 	{
 		const Connection &conn = *it;
 
@@ -747,11 +1672,45 @@ void Interlink::GetConnectionTelemetry(std::vector<ConnectionTelemetry> &out)
 		t.qualityRemote = status.m_flConnectionQualityRemote;
 		t.state = status.m_eState;
 
-		t.IdentityId = NetworkCredentials::Get().GetID().ToString();
+		t.IdentityId = SelfID.ToString();
 		t.targetId = conn.target.ToString();
 
+		const PendingSendQueue::Depth depth = PendingSends.GetDepth(conn.target);
+		t.pendingQueueMessages = depth.Messages;
+		t.pendingQueueBytes = depth.Bytes;
+		t.pendingQueueDropped = depth.Dropped;
+
+		if (const std::optional<LinkTuner::Adjustment> tuned = Tuner.Current(conn.SteamConnection))
+		{
+			t.sendRateMin = tuned->SendRateMin;
+			t.nagleTimeUsec = tuned->NagleTimeUsec;
+		}
+		else
+		{
+			// Untracked connections stay on their profile
+			const LinkConfigProfile &profile = Properties.Links.For(conn.target.Type);
+			t.sendRateMin = profile.SendRateMin;
+			t.nagleTimeUsec = profile.NagleTimeUsec;
+		}
+
 		out.push_back(std::move(t));
 	}
+
+	// Destinations still waiting for their connection have no GNS status yet
+	PendingSends.ForEachDepth(
+		[&](const NetworkIdentity &who, const PendingSendQueue::Depth &depth)
+		{
+			if (depth.Messages == 0)
+				return;
+			ConnectionTelemetry t{};
+			t.state = k_ESteamNetworkingConnectionState_Connecting;
+			t.IdentityId = SelfID.ToString();
+			t.targetId = who.ToString();
+			t.pendingQueueMessages = depth.Messages;
+			t.pendingQueueBytes = depth.Bytes;
+			t.pendingQueueDropped = depth.Dropped;
+			out.push_back(std::move(t));
+		});
 }
 void Interlink::OnClientConnected(const Connection &c)
 {
@@ -773,14 +1732,6 @@ void Interlink::OnClientConnected(const Connection &c)
 		Client client;
 		client.ID = newIdentity.ID;
 		client.ip = c.address;
-		ClientManifest::Get().RegisterClient(client);
-		ClientManifest::Get().AssignProxyClient(client.ID, NetworkCredentials::Get().GetID());
-
-		ClientConnectEvent cce;
-		cce.client = client;
-		cce.ConnectedProxy = NetworkCredentials::Get().GetID();
-		EventSystem::Get().Dispatch(cce);
-
 		HandshakeService::Get().OnClientConnect(client);
 	}
 }
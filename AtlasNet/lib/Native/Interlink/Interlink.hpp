@@ -1,31 +1,95 @@
 #pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <memory>
+#include <stop_token>
+#include <string>
 #include <thread>
 #include <type_traits>
 #include <unordered_map>
+#include <unordered_set>
 
 #include "Debug/Log.hpp"
+#include "ConnectionAdmission.hpp"
 #include "Docker/DockerIO.hpp"
 #include "GameNetworkingSockets.hpp"
+#include "Global/Misc/MPSCQueue.hpp"
 #include "Global/Misc/Singleton.hpp"
 #include "Global/pch.hpp"
+#include "InterlinkCommand.hpp"
 #include "InterlinkEnums.hpp"
 #include "Network/Connection.hpp"
 #include "Network/ConnectionTelemetry.hpp"
+#include "Network/LinkConfigProfile.hpp"
 #include "Network/NetworkEnums.hpp"
 #include "Network/NetworkIdentity.hpp"
+#include "Network/OutboundBuffer.hpp"
+#include "Network/PendingSendQueue.hpp"
 #include "Network/Packet/Packet.hpp"
+#include "Network/Packet/PacketCompression.hpp"
+#include "Network/Packet/PacketDispatchExecutor.hpp"
 #include "Network/Packet/PacketManager.hpp"
+#include "Network/Packet/PacketStream.hpp"
+#include "Network/ReceiveDrain.hpp"
+#include "Network/VirtualChannelTable.hpp"
+#include "Telemetry/InterlinkTickTelemetry.hpp"
+#include "Transport/IInterlinkTransport.hpp"
+#include "Transport/SharedMemoryTransport.hpp"
 
 struct InterlinkProperties
 {
+	/// Identity of this endpoint. Left invalid it comes from NetworkCredentials, eLoopbackOnly
+	/// endpoints sharing a process each need their own.
 	NetworkIdentity ThisID;
+	InterlinkTransportMode Transport = InterlinkTransportMode::eNetwork;
+	/// How long an idle tick thread blocks before polling GNS anyway. GNS has no readiness
+	/// notification for poll groups so this bounds the receive latency of an idle Interlink. The
+	/// client receive thread polls on the same deadline once a client is connected, so at 1ms an
+	/// idle server wakes about 1000 times a second on each.
+	std::chrono::microseconds IdleWakeDeadline = std::chrono::milliseconds(1);
+	/// Internal connections, drained on the tick thread.
+	ReceiveDrainSettings Receive;
+	/// Game client connections, drained on their own thread so no amount of client traffic delays
+	/// handoff and health traffic between servers.
+	ReceiveDrainSettings ClientReceive;
+	/// Worker lanes for packet types that opt into PacketDispatchPolicy::eWorkerPool. 0 keeps
+	/// every handler on the tick thread.
+	uint32_t DispatchWorkers = 0;
+	/// Packets serializing to more than this go out as a stream of chunks this size, so no
+	/// single message hits the GNS size limit or holds up its lane for long.
+	uint32_t StreamChunkBytes = 64 * 1024;
+	/// Where trained zstd dictionaries live, as <PacketName>.zdict. Empty compresses without.
+	std::string CompressionDictionaryDir;
+	/// Limits on what may queue up for a destination that is not connected yet.
+	PendingSendSettings PendingSends;
+	/// How often warm peers without a connection are redialed.
+	std::chrono::milliseconds WarmPeerRetryInterval = std::chrono::seconds(1);
+	/// A warm peer the ServerRegistry does not know waits twice as long after each failed
+	/// lookup, starting at WarmPeerRetryInterval and capped here.
+	std::chrono::milliseconds WarmPeerMaxBackoff = std::chrono::seconds(60);
+	/// Client messages on a proxy<->shard link are coalesced into frames flushed every tick, or
+	/// early once they grow past this.
+	uint32_t ChannelFrameBytes = 16 * 1024;
+	/// GNS settings for each connection, by the type of peer on the other end.
+	LinkConfigProfiles Links;
+	/// Adjusts connections on their queue once they are up, off unless enabled.
+	LinkTunerSettings Tuning;
+	/// Links to peers on the same host, eNetwork only.
+	SharedMemoryTransportSettings SharedMemory;
+	/// Port of the GNS listen socket, eNetwork only.
+	PortType ListenPort = _PORT_INTERLINK;
+	/// Where peers dial us, as registered in the ServerRegistry. Left empty it is the container's
+	/// address on ListenPort. Set it to run outside Docker, e.g. several endpoints on 127.0.0.1.
+	std::optional<IPAddress> AdvertiseAddress;
 };
 inline NetworkIdentityType GetTargetType(const Connection &c)
 {
 	return c.target.Type;
 }
 using InterlinkContainereID = DockerContainerID;
+class ClientTransferPacket;
 class Interlink : public Singleton<Interlink>
 {
 	struct IndexByState
@@ -60,32 +124,113 @@ class Interlink : public Singleton<Interlink>
 											   GetTargetType>>,
 			// non-unique, the reason its non unique is because GameClient on
 			// connection dont have an ID
-			boost::multi_index::ordered_non_unique<
+			boost::multi_index::hashed_non_unique<
 				boost::multi_index::tag<IndexByTarget>,
 				boost::multi_index::member<Connection, NetworkIdentity, &Connection::target>>,
-			// Unique By HConnection
-			boost::multi_index::ordered_non_unique<
+			// Unique By HConnection once connected, pre-connecting entries share the invalid handle
+			boost::multi_index::hashed_non_unique<
 				boost::multi_index::tag<IndexByHSteamNetConnection>,
 				boost::multi_index::member<Connection, HSteamNetConnection,
 										   &Connection::SteamConnection>>>>
 		Connections;
 
-	std::unordered_map<NetworkIdentity,
-					   std::vector<std::pair<std::shared_ptr<IPacket>, NetworkMessageSendFlag>>>
-		QueuedPacketsOnConnect;
+	// Messages waiting for a connection, owned by the tick thread
+	PendingSendQueue PendingSends;
+	NetworkIdentity SelfID;
+	// Tried in order before GNS, owned by the tick thread
+	std::vector<std::unique_ptr<IInterlinkTransport>> Transports;
+	IInterlinkTransport::DeliverFn DeliverFromTransport;
+	// Published in the ServerRegistry, empty when no transport cares which host peers are on
+	std::string HostKey;
 	Log logger = Log("Interlink");
-	ISteamNetworkingSockets *networkInterface;
+	ISteamNetworkingSockets *networkInterface = nullptr;
 	std::optional<HSteamListenSocket> ListeningSocket;
-	std::optional<HSteamNetPollGroup> PollGroup;
+	std::optional<HSteamNetPollGroup> InternalPollGroup;
 	PacketManager packet_manager;
+	PacketDispatchExecutor Dispatcher{packet_manager};
 	bool b_InDockerNetwork = true;
 	std::atomic_bool IsInit = false;
+	InterlinkProperties Properties;
+
+	// Tick loop wakeup state
+	std::mutex WakeMutex;
+	std::condition_variable_any WakeCV;
+	std::atomic<uint32_t> PendingWakeMask = 0;
+	std::atomic<int64_t> WakeRequestedAt = 0;
+	InterlinkTickTelemetry TickTelemetry;
+	ReceiveDrain Receiver;
+	PacketStreamAssembler Streams;
+	PacketCompressor Compressor;
+	std::atomic<uint32_t> NextStreamID = 1;
+
+	// Outbound messages built this tick, flushed with one SendMessages call
+	std::vector<ISteamNetworkingMessage *> PendingOutbound;
+	std::vector<int64> SendResults;
+
+	// Everything above is owned by the tick thread. Other threads only talk to it through here.
+	MPSCQueue<InterlinkCommand> Commands;
+	std::atomic<std::thread::id> TickThreadId;
+
+	// ServerRegistry lookups can take seconds while a peer registers, so they run on their own
+	// thread and come back to the tick thread as a Resolved command.
+	std::jthread ResolverThread;
+	std::mutex ResolveMutex;
+	std::condition_variable_any ResolveCV;
+	std::deque<NetworkIdentity> ResolveRequests;
+	std::unordered_set<NetworkIdentity> Resolving;
+
+	// Client connections sit in their own poll group drained by ClientReceiveThread. It only
+	// reads ClientSenders, which the tick thread fills before a connection joins the group.
+	// It decodes and forwards, the packets it decodes are dispatched on the tick thread.
+	std::optional<HSteamNetPollGroup> ClientPollGroup;
+	std::jthread ClientReceiveThread;
+	ReceiveDrain ClientReceiver;
+	std::mutex ClientSendersMutex;
+	std::condition_variable_any ClientSendersCV;
+	std::unordered_map<HSteamNetConnection, NetworkIdentity> ClientSenders;
+
+	// Redis work triggered by connection callbacks runs on its thread, so a login storm or fleet
+	// restart does not hold up every other connection's traffic on the tick thread
+	ConnectionAdmission Admission;
+
+	// Client traffic multiplexed over proxy<->shard links. The table is shared, the frames being
+	// built this tick belong to the tick thread.
+	VirtualChannelTable Channels;
+	struct PendingChannelFrame
+	{
+		OutboundBufferPtr Buffer;
+		uint32_t Messages = 0;
+	};
+	struct ChannelFrames
+	{
+		PendingChannelFrame Reliable;
+		PendingChannelFrame Unreliable;
+	};
+	std::unordered_map<NetworkIdentity, ChannelFrames> PendingChannelFrames;
+	PacketManager::Subscription ChannelActivation;
+
+	// Peers connected ahead of the first packet and redialed whenever their connection drops.
+	// Each lookup that fails ties up the resolver thread for its retries, hence the backoff.
+	struct WarmPeer
+	{
+		std::chrono::milliseconds Backoff{0};
+		std::chrono::steady_clock::time_point NextAttempt;
+	};
+	std::unordered_map<NetworkIdentity, WarmPeer> WarmPeers;
+	std::chrono::steady_clock::time_point NextWarmPeerCheck;
+
+	// Tick thread only
+	LinkTuner Tuner;
 
    public:
+	// Safe from any thread, the work itself happens on the tick thread.
 	bool EstablishConnectionAtIP(const NetworkIdentity &who, const IPAddress &ip);
 	void CloseConnectionTo(const NetworkIdentity &id, int reason = 0, const char *debug = nullptr);
 	void CloseAllConnections(int reason = 0);
 	bool EstablishConnectionTo(const NetworkIdentity &who);
+	/// @brief Keep a connection open to every peer in the set, replacing the previous set.
+	/// @details Peers that leave the set are not disconnected, other traffic may still use them.
+	void SetWarmPeers(std::vector<NetworkIdentity> peers);
 
    private:
 	void GenerateNewConnections();
@@ -104,32 +249,160 @@ class Interlink : public Singleton<Interlink>
 	void CallbackOnProblemDetectedLocally(SteamCBInfo info);
 	void CallbackOnConnected(SteamCBInfo info);
 	void OpenListenSocket(PortType port);
-	void ReceiveMessages();
+	uint32_t ReceiveMessages();
+	void FlushOutbound();
+	/// @brief Put a connection that just came up in the poll group of its class.
+	void JoinPollGroup(const Connection &c);
+	/// @brief Stop attributing messages still queued on a closing connection to its peer.
+	void LeavePollGroup(const Connection &c);
+
+	[[nodiscard]] bool OnTickThread() const
+	{
+		return std::this_thread::get_id() == TickThreadId.load(std::memory_order_relaxed);
+	}
+	/// @brief Run the command right away on the tick thread, otherwise queue it for the next tick.
+	void Submit(InterlinkCommand &&command);
+	void ProcessCommands();
+	void Execute(InterlinkCommands::Send &command);
+	void Execute(InterlinkCommands::SendMany &command);
+	void Execute(InterlinkCommands::ChannelSend &command);
+	void Execute(InterlinkCommands::DeliverClient &command);
+	void Execute(InterlinkCommands::ActivateClient &command);
+	void Execute(InterlinkCommands::Connect &command);
+	void Execute(InterlinkCommands::ConnectAtIP &command);
+	void Execute(InterlinkCommands::Resolved &command);
+	void Execute(InterlinkCommands::Admit &command);
+	void Execute(InterlinkCommands::Close &command);
+	void Execute(InterlinkCommands::SetWarmPeers &command);
+	void Execute(InterlinkCommands::QueryTelemetry &command);
+
+	// Tick thread only
+	void RouteToTarget(const NetworkIdentity &who, const OutboundBufferPtr &buffer,
+					   NetworkMessageSendFlag sendFlag);
+	void ConnectTo(const NetworkIdentity &who);
+	/// @brief Send every channel frame built this tick.
+	void FlushChannelFrames();
+	void FlushChannelFrame(const NetworkIdentity &link, PendingChannelFrame &frame, bool reliable);
+	/// @brief Forget everything about a peer whose connection is gone.
+	void DropPeer(const Connection &c);
+	void MaintainWarmPeers(bool force);
+	void ConnectAtIP(const NetworkIdentity &who, const IPAddress &address);
+	void CloseConnection(const NetworkIdentity &id, int reason, const char *debug);
+	void CollectConnectionTelemetry(std::vector<ConnectionTelemetry> &out);
+	/// @brief Set up the PacketLaneSpecs lanes, internal connections only.
+	void ConfigureLanes(HSteamNetConnection conn);
+	/// @brief Apply the LinkConfigProfile for peers of this type, before the handshake is done.
+	void ApplyLinkProfile(HSteamNetConnection conn, NetworkIdentityType peer);
+	/// @brief Let the LinkTuner look at every connection it tracks, once per interval.
+	void TuneLinks();
+	static uint16_t LaneOf(PacketTypeID type);
+	static uint16_t LaneOf(const IPacket &packet) { return LaneOf(packet.GetPacketType()); }
+	/// @brief Serialize into a fresh OutboundBuffer, recording the cost in PacketMetrics.
+	static OutboundBufferPtr SerializeForSend(const IPacket &packet, uint32_t recipients);
+	/// @brief Reframe buffer as a stream when it exceeds StreamChunkBytes. Streams are always
+	/// sent reliably since a lost chunk would lose the whole packet.
+	void StreamIfOversized(OutboundBufferPtr &buffer, NetworkMessageSendFlag &sendFlag);
+	/// @brief Bring up GNS, open the listen socket and register in the ServerRegistry.
+	bool InitNetwork();
+	/// @brief Decode and dispatch one received message, whichever transport it came in on.
+	void Deliver(const NetworkIdentity &sender, std::span<const uint8_t> bytes,
+				 NetworkMessageSendFlag sendFlag);
+	uint32_t PollTransports();
+	/// @brief Look inside a RelayPacket before anything is decoded.
+	/// @return true when FinalTarget is us, with bytes narrowed to the inner packet. A relay for
+	/// anyone else is forwarded as is and false returned.
+	bool UnwrapRelay(const NetworkIdentity &sender, std::span<const uint8_t> &bytes,
+					 NetworkMessageSendFlag sendFlag);
+	void ResolverThreadEntry(std::stop_token st);
+	void ClientReceiveThreadEntry(std::stop_token st);
+	uint32_t ReceiveClientMessages();
+	/// @brief Deliver for messages from game clients, whether straight from the client or out of
+	/// a channel frame. Clients only send plain packets, streams, relays and compressed or channel
+	/// frames are internal and dropped.
+	void DeliverFromClient(const NetworkIdentity &sender, std::span<const uint8_t> bytes);
+	/// @brief Proxy side, pass a client's message on to its shard when it has a channel there.
+	/// @return false when it has none and the message is for us.
+	bool ForwardFromClient(const NetworkIdentity &sender, std::span<const uint8_t> bytes,
+						   NetworkMessageSendFlag sendFlag);
+	/// @brief Unpack a channel frame. A proxy passes every message on to its client, anyone else
+	/// dispatches it as coming from the client.
+	void DeliverChannelFrame(const NetworkIdentity &sender, std::span<const uint8_t> frame,
+							 NetworkMessageSendFlag sendFlag);
+	/// @brief Shard side, adopt the channel a proxy picked in a ClientTransferPacket activation.
+	void OnChannelActivation(const ClientTransferPacket &packet, const NetworkIdentity &proxy);
 
 	// void DebugPrint();
 	void OnClientConnected(const Connection &c);
 
-	void Tick();
+	/// @return number of messages received
+	uint32_t Tick();
+	void TickThreadEntry(std::stop_token st);
+	/// @brief Wake the tick thread so queued work is serviced right away instead of at the next
+	/// idle deadline.
+	void RequestWake(InterlinkWakeReason reason);
+	InterlinkWakeReason WaitForWork(std::stop_token st, bool lastTickReceived);
 	std::jthread TickThread;
 
    public:
-	void Init();
+	void Init(const InterlinkProperties &properties = InterlinkProperties());
 	void Shutdown();
+	[[nodiscard]] const InterlinkTickTelemetry &GetTickTelemetry() const { return TickTelemetry; }
+	[[nodiscard]] const PacketDispatchExecutor &GetDispatchExecutor() const { return Dispatcher; }
+	[[nodiscard]] const PacketStreamStats &GetStreamStats() const { return Streams.GetStats(); }
+	[[nodiscard]] const NetworkIdentity &GetID() const { return SelfID; }
+	[[nodiscard]] const PendingSendStats &GetPendingSendStats() const
+	{
+		return PendingSends.GetStats();
+	}
 
 	void OnSteamNetConnectionStatusChanged(SteamNetConnectionStatusChangedCallback_t *pInfo);
 
+	/// @brief Snapshot of every connected peer. Blocks until the tick thread has answered when
+	/// called from another thread.
 	void GetConnectionTelemetry(std::vector<ConnectionTelemetry> &out);
 	// void SendMessageRaw(const InterLinkIdentifier &who, std::span<const
 	// std::byte> data, InterlinkMessageSendFlag sendFlag =
 	// InterlinkMessageSendFlag::eReliableBatched);
+	/// @brief Safe from any thread. The packet is serialized on the calling thread.
+	/// @return eBackpressured once the destination's pending queue is filling up, so producers can
+	/// throttle. Reflects the queue when the call was made, the tick thread may still drop the
+	/// packet if the queue fills before it gets there.
 	template <typename T>
-	void SendMessage(const NetworkIdentity &who, const T &packet, NetworkMessageSendFlag sendFlag)
+	InterlinkSendStatus SendMessage(const NetworkIdentity &who, const T &packet,
+									NetworkMessageSendFlag sendFlag)
 	{
-		std::shared_ptr<IPacket> packet_ptr = std::make_shared<T>(packet);
-		SendMessage(who, packet_ptr, sendFlag);
+		return SendMessage(who, static_cast<const IPacket &>(packet), sendFlag);
 	}
-	void SendMessage(const NetworkIdentity &who, const std::shared_ptr<IPacket> &packet,
-					 NetworkMessageSendFlag sendFlag);
+	InterlinkSendStatus SendMessage(const NetworkIdentity &who, const IPacket &packet,
+									NetworkMessageSendFlag sendFlag);
+	InterlinkSendStatus SendMessage(const NetworkIdentity &who,
+									const std::shared_ptr<IPacket> &packet,
+									NetworkMessageSendFlag sendFlag)
+	{
+		return SendMessage(who, *packet, sendFlag);
+	}
+	/// @brief Send the same packet to every recipient, serializing it only once.
+	/// @details Connected recipients share one refcounted buffer. Recipients without an
+	/// established connection are connected and queued exactly like SendMessage does.
+	/// @return the worst status of any recipient. Recipients with no room are skipped.
+	template <typename T>
+	InterlinkSendStatus SendMessageToMany(std::span<const NetworkIdentity> recipients,
+										  const T &packet, NetworkMessageSendFlag sendFlag)
+	{
+		return SendMessageToMany(recipients, static_cast<const IPacket &>(packet), sendFlag);
+	}
+	InterlinkSendStatus SendMessageToMany(std::span<const NetworkIdentity> recipients,
+										  const IPacket &packet, NetworkMessageSendFlag sendFlag);
+	/// @brief Send to a client through its virtual channel, coalesced with other clients'
+	/// messages on the same link until the tick ends. Safe from any thread.
+	/// @return eDropped when the client has no channel open.
+	InterlinkSendStatus SendToClient(const ClientID &client, const IPacket &packet,
+									 NetworkMessageSendFlag sendFlag);
+	/// @brief Proxy side. Open a channel for client on the link to shard and send the shard the
+	/// activation. Done on the tick thread, and skipped once the client has disconnected, so its
+	/// channel is never opened after DropPeer forgot it. Safe from any thread.
+	void ActivateClient(const NetworkIdentity &shard, const ClientID &client);
+	[[nodiscard]] VirtualChannelTable &GetChannels() { return Channels; }
 	PacketManager &GetPacketManager()
 	{
 		ASSERT(IsInit, "Interlink was not initialized");
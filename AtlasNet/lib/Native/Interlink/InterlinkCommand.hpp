@@ -0,0 +1,105 @@
+#pragma once
+#include <steam/steamnetworkingtypes.h>
+
+#include <chrono>
+#include <functional>
+#include <future>
+#include <memory>
+#include <optional>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "Client/Client.hpp"
+#include "Network/ConnectionTelemetry.hpp"
+#include "Network/IPAddress.hpp"
+#include "Network/NetworkEnums.hpp"
+#include "Network/NetworkIdentity.hpp"
+#include "Network/OutboundBuffer.hpp"
+#include "Network/Packet/Packet.hpp"
+#include "Network/Packet/PacketChannelFrame.hpp"
+
+/// @brief Work other threads hand to the Interlink tick thread, the only owner of the connection
+/// table. Packets are serialized by the producer so the tick thread only routes bytes.
+namespace InterlinkCommands
+{
+struct Send
+{
+	NetworkIdentity Target;
+	OutboundBufferPtr Buffer;
+	NetworkMessageSendFlag Flag;
+};
+/// One client's message for the virtual channel frame of Link, coalesced until the tick ends.
+struct ChannelSend
+{
+	NetworkIdentity Link;
+	ChannelID Channel;
+	OutboundBufferPtr Buffer;
+	NetworkMessageSendFlag Flag;
+};
+struct SendMany
+{
+	std::vector<NetworkIdentity> Targets;
+	OutboundBufferPtr Buffer;
+	NetworkMessageSendFlag Flag;
+};
+/// Packet decoded on the client receive thread, dispatched on the tick thread like any other.
+struct DeliverClient
+{
+	NetworkIdentity Sender;
+	PooledPacket Packet;
+};
+/// Handshake placed Client on Shard. Open its channel and tell the shard, unless it left since.
+struct ActivateClient
+{
+	NetworkIdentity Shard;
+	ClientID Client;
+};
+struct Connect
+{
+	NetworkIdentity Target;
+};
+struct ConnectAtIP
+{
+	NetworkIdentity Target;
+	IPAddress Address;
+};
+/// Result of a ServerRegistry lookup done off the tick thread.
+struct Resolved
+{
+	NetworkIdentity Target;
+	std::optional<IPAddress> Address;
+	/// Set when a transport other than GNS negotiated a link, starts using it.
+	std::function<void()> Adopt;
+};
+/// Outcome of the registry lookup for an incoming internal connection the snapshot did not know.
+struct Admit
+{
+	HSteamNetConnection Connection;
+	bool Known = false;
+	std::chrono::steady_clock::time_point Requested;
+};
+struct Close
+{
+	NetworkIdentity Target;
+	int Reason = 0;
+	std::string Debug;
+};
+/// Replaces the set of peers the tick thread keeps connected.
+struct SetWarmPeers
+{
+	std::vector<NetworkIdentity> Peers;
+};
+struct QueryTelemetry
+{
+	std::shared_ptr<std::promise<std::vector<ConnectionTelemetry>>> Result;
+};
+}  // namespace InterlinkCommands
+
+using InterlinkCommand =
+	std::variant<InterlinkCommands::Send, InterlinkCommands::SendMany,
+				 InterlinkCommands::ChannelSend, InterlinkCommands::DeliverClient,
+				 InterlinkCommands::ActivateClient, InterlinkCommands::Connect,
+				 InterlinkCommands::ConnectAtIP, InterlinkCommands::Resolved,
+				 InterlinkCommands::Admit, InterlinkCommands::Close, InterlinkCommands::SetWarmPeers,
+				 InterlinkCommands::QueryTelemetry>;
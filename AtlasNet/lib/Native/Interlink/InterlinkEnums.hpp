@@ -2,4 +2,32 @@
 #include "GameNetworkingSockets.hpp"
 #include <Global/pch.hpp>
 
+/// @brief Why the Interlink tick thread woke up.
+enum class InterlinkWakeReason : uint8_t
+{
+	eDeadline,	/// Idle deadline expired, polled just in case
+	eInbound,	/// Last tick received messages, more are likely waiting
+	eOutbound,	/// SendMessage/EstablishConnection or the client receive thread queued work
+	eTransport, /// A transport other than GNS received something
+	eShutdown,	/// Stop was requested
+	eCount
+};
+BOOST_DESCRIBE_ENUM(InterlinkWakeReason, eDeadline, eInbound, eOutbound, eTransport, eShutdown,
+					eCount)
 
+/// @brief Which transports an Interlink brings up.
+enum class InterlinkTransportMode : uint8_t
+{
+	eNetwork,	   /// GNS, with loopback to Interlinks in the same process
+	eLoopbackOnly  /// Loopback alone, no GNS or registry. Several can share a process
+};
+BOOST_DESCRIBE_ENUM(InterlinkTransportMode, eNetwork, eLoopbackOnly)
+
+/// @brief What SendMessage did with a packet.
+enum class InterlinkSendStatus : uint8_t
+{
+	eAccepted,		/// Handed to the tick thread, sent or queued until the connection is up
+	eBackpressured, /// Accepted, but the destination's pending queue is nearly full. Slow down
+	eDropped		/// Not sent, the packet was invalid or there was no room for it
+};
+BOOST_DESCRIBE_ENUM(InterlinkSendStatus, eAccepted, eBackpressured, eDropped)
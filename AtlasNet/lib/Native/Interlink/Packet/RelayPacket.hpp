@@ -1,60 +1,99 @@
 #pragma once
-#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
 
-#include "InterlinkEnums.hpp"
 #include "Network/NetworkIdentity.hpp"
 #include "Network/Packet/Packet.hpp"
-#include "Packet/CommandPacket.hpp"
-#include "Serialize/ByteWriter.hpp"
+#include "Global/Serialize/ByteReader.hpp"
+#include "Global/Serialize/ByteWriter.hpp"
+
+/**
+ * @brief Envelope carrying an already serialized packet to FinalTarget through another node.
+ * @details Laid out as [type][FinalTarget][InnerType][blob]. The blob is the inner packet exactly
+ * as it serializes, its own type ID first, so a hop reads the header with Peek and forwards the
+ * blob to FinalTarget untouched. Only FinalTarget decodes it, as if it had been sent directly.
+ */
 class RelayPacket : public TPacket<RelayPacket, "RelayPacket">
 {
+   public:
+	/// @brief Header of a relay read in place, Inner points into the bytes it was peeked from.
+	struct View
+	{
+		NetworkIdentity FinalTarget;
+		PacketTypeID InnerType;
+		std::span<const uint8_t> Inner;
+	};
+
 	NetworkIdentity FinalTarget;
-	std::shared_ptr<IPacket> sub_Packet;
+	PacketTypeID InnerType = 0;
+	std::vector<uint8_t> Inner;
 
-   public:
 	RelayPacket() : TPacket() {}
 	RelayPacket& SetFinalTarget(const NetworkIdentity& id)
 	{
 		FinalTarget = id;
 		return *this;
 	}
-	template <typename T>
-	RelayPacket& SetSubPacket(const T& packet)
+	/// @brief Serialize packet into the envelope, the only time it is encoded on its way.
+	RelayPacket& SetSubPacket(const IPacket& packet)
 	{
-		sub_Packet = std::make_shared<T>(packet);
+		ByteWriter bw;
+		packet.Serialize(bw);
+		const auto bytes = bw.bytes();
+		Inner.assign(bytes.begin(), bytes.end());
+		InnerType = packet.GetPacketType();
 		return *this;
 	}
+	/// @brief Decode the inner packet, for the final recipient.
+	[[nodiscard]] PooledPacket DecodeSubPacket() const
+	{
+		return PacketRegistry::Get().AcquireFromBytes(Inner);
+	}
+
+	/// @brief Read the header of a serialized relay without copying the inner packet.
+	/// @return nullopt when bytes are not a well formed relay.
+	static std::optional<View> Peek(std::span<const uint8_t> bytes)
+	{
+		try
+		{
+			ByteReader br(bytes);
+			if (br.read_scalar<PacketTypeID>() != TypeID)
+				return std::nullopt;
+			View view;
+			view.FinalTarget.Deserialize(br);
+			view.InnerType = br.read_scalar<PacketTypeID>();
+			view.Inner = br.blob();
+			if (view.FinalTarget.Type == NetworkIdentityType::eInvalid ||
+				view.Inner.size() < sizeof(PacketTypeID) ||
+				PacketRegistry::PeekPacketType(view.Inner) != view.InnerType)
+				return std::nullopt;
+			return view;
+		}
+		catch (const std::exception&)
+		{
+			return std::nullopt;
+		}
+	}
 
    private:
 	void SerializeData(ByteWriter& bw) const override
 	{
 		FinalTarget.Serialize(bw);
-		sub_Packet->Serialize(bw);
+		bw.write_scalar(InnerType);
+		bw.blob(std::span(Inner));
 	}
 	void DeserializeData(ByteReader& br) override
 	{
 		FinalTarget.Deserialize(br);
-		sub_Packet->Deserialize(br);
+		InnerType = br.read_scalar<PacketTypeID>();
+		const auto blob = br.blob();
+		Inner.assign(blob.begin(), blob.end());
 	}
 	bool ValidateData() const override
 	{
-		return (FinalTarget.Type != NetworkIdentityType::eInvalid) && sub_Packet &&
-			   sub_Packet->Validate();
+		return FinalTarget.Type != NetworkIdentityType::eInvalid &&
+			   Inner.size() >= sizeof(PacketTypeID) &&
+			   PacketRegistry::PeekPacketType(Inner) == InnerType;
 	}
 };
-
-void Test()
-{
-	uint32 BoundId = 52;
-	CommandPacket cmdPacket;
-	cmdPacket
-    .SetCommandType(CommandPacket::Type::eFetchNewBounds)
-		.WriteArgs(
-            [BoundId = BoundId](ByteWriter& bw)
-             { bw.write_scalar(BoundId); });
-
-	RelayPacket relayPacket;
-	relayPacket
-    .SetFinalTarget(NetworkIdentity::MakeIDWatchDog())
-    .SetSubPacket(cmdPacket);
-}
\ No newline at end of file
@@ -0,0 +1,155 @@
+#pragma once
+#include <string>
+#include <vector>
+
+#include "Global/Serialize/ByteReader.hpp"
+#include "Global/Serialize/ByteWriter.hpp"
+
+/// @brief Cumulative InterlinkTickTelemetry of one node, as published to the NetworkManifest.
+/// Times are in microseconds.
+struct InterlinkTickSummary
+{
+	uint64_t Ticks = 0;
+
+	/// Wakeups by InterlinkWakeReason.
+	uint64_t WakeDeadline = 0;
+	uint64_t WakeInbound = 0;
+	uint64_t WakeOutbound = 0;
+	uint64_t WakeTransport = 0;
+
+	uint64_t TickP50 = 0;
+	uint64_t TickP99 = 0;
+	uint64_t WakeLatencyP50 = 0;
+	uint64_t WakeLatencyP99 = 0;
+
+	/// Internal connections drained on the tick, then game clients on their own thread.
+	/// LeftMessages counts drains that most likely left messages in the poll group.
+	uint64_t ReceivedMessages = 0;
+	uint64_t ReceivedBytes = 0;
+	uint64_t ReceiveBudgetExhausted = 0;
+	uint64_t ReceiveLeftMessages = 0;
+	uint64_t ReceiveBatchSize = 0;
+	uint64_t ClientReceivedMessages = 0;
+	uint64_t ClientReceivedBytes = 0;
+	uint64_t ClientReceiveBudgetExhausted = 0;
+	uint64_t ClientReceiveLeftMessages = 0;
+	uint64_t ClientReceiveBatchSize = 0;
+
+	/// Incoming internal connections, by what decided their admission. The lookup time covers
+	/// peers the ServerRegistry snapshot did not know.
+	uint64_t AdmittedFromSnapshot = 0;
+	uint64_t AdmittedAfterLookup = 0;
+	uint64_t AdmissionRejected = 0;
+	uint64_t AdmissionLookupP50 = 0;
+	uint64_t AdmissionLookupP99 = 0;
+
+	/// Send rate or Nagle changes made by the LinkTuner.
+	uint64_t LinkRetunes = 0;
+
+	/// Packets received as a stream of chunks, from PacketStreamStats. Filled in by the
+	/// NetworkManifest, the streams are not part of the tick telemetry.
+	uint64_t StreamsCompleted = 0;
+	uint64_t StreamsDropped = 0;
+	uint64_t StreamChunksReceived = 0;
+	uint64_t StreamBytesPending = 0;
+
+	static constexpr size_t ColumnCount = 29;
+
+	void Serialize(ByteWriter& bw) const
+	{
+		bw.u64(Ticks);
+		bw.u64(WakeDeadline);
+		bw.u64(WakeInbound);
+		bw.u64(WakeOutbound);
+		bw.u64(WakeTransport);
+		bw.u64(TickP50);
+		bw.u64(TickP99);
+		bw.u64(WakeLatencyP50);
+		bw.u64(WakeLatencyP99);
+		bw.u64(ReceivedMessages);
+		bw.u64(ReceivedBytes);
+		bw.u64(ReceiveBudgetExhausted);
+		bw.u64(ReceiveLeftMessages);
+		bw.u64(ReceiveBatchSize);
+		bw.u64(ClientReceivedMessages);
+		bw.u64(ClientReceivedBytes);
+		bw.u64(ClientReceiveBudgetExhausted);
+		bw.u64(ClientReceiveLeftMessages);
+		bw.u64(ClientReceiveBatchSize);
+		bw.u64(AdmittedFromSnapshot);
+		bw.u64(AdmittedAfterLookup);
+		bw.u64(AdmissionRejected);
+		bw.u64(AdmissionLookupP50);
+		bw.u64(AdmissionLookupP99);
+		bw.u64(LinkRetunes);
+		bw.u64(StreamsCompleted);
+		bw.u64(StreamsDropped);
+		bw.u64(StreamChunksReceived);
+		bw.u64(StreamBytesPending);
+	}
+	void Deserialize(ByteReader& br)
+	{
+		Ticks = br.u64();
+		WakeDeadline = br.u64();
+		WakeInbound = br.u64();
+		WakeOutbound = br.u64();
+		WakeTransport = br.u64();
+		TickP50 = br.u64();
+		TickP99 = br.u64();
+		WakeLatencyP50 = br.u64();
+		WakeLatencyP99 = br.u64();
+		ReceivedMessages = br.u64();
+		ReceivedBytes = br.u64();
+		ReceiveBudgetExhausted = br.u64();
+		ReceiveLeftMessages = br.u64();
+		ReceiveBatchSize = br.u64();
+		ClientReceivedMessages = br.u64();
+		ClientReceivedBytes = br.u64();
+		ClientReceiveBudgetExhausted = br.u64();
+		ClientReceiveLeftMessages = br.u64();
+		ClientReceiveBatchSize = br.u64();
+		AdmittedFromSnapshot = br.u64();
+		AdmittedAfterLookup = br.u64();
+		AdmissionRejected = br.u64();
+		AdmissionLookupP50 = br.u64();
+		AdmissionLookupP99 = br.u64();
+		LinkRetunes = br.u64();
+		StreamsCompleted = br.u64();
+		StreamsDropped = br.u64();
+		StreamChunksReceived = br.u64();
+		StreamBytesPending = br.u64();
+	}
+	/// @brief Column order used by the plain string manifest and the Cartograph.
+	std::vector<std::string> ToRow() const
+	{
+		return {std::to_string(Ticks),
+				std::to_string(WakeDeadline),
+				std::to_string(WakeInbound),
+				std::to_string(WakeOutbound),
+				std::to_string(WakeTransport),
+				std::to_string(TickP50),
+				std::to_string(TickP99),
+				std::to_string(WakeLatencyP50),
+				std::to_string(WakeLatencyP99),
+				std::to_string(ReceivedMessages),
+				std::to_string(ReceivedBytes),
+				std::to_string(ReceiveBudgetExhausted),
+				std::to_string(ReceiveLeftMessages),
+				std::to_string(ReceiveBatchSize),
+				std::to_string(ClientReceivedMessages),
+				std::to_string(ClientReceivedBytes),
+				std::to_string(ClientReceiveBudgetExhausted),
+				std::to_string(ClientReceiveLeftMessages),
+				std::to_string(ClientReceiveBatchSize),
+				std::to_string(AdmittedFromSnapshot),
+				std::to_string(AdmittedAfterLookup),
+				std::to_string(AdmissionRejected),
+				std::to_string(AdmissionLookupP50),
+				std::to_string(AdmissionLookupP99),
+				std::to_string(LinkRetunes),
+				std::to_string(StreamsCompleted),
+				std::to_string(StreamsDropped),
+				std::to_string(StreamChunksReceived),
+				std::to_string(StreamBytesPending)};
+	}
+};
@@ -0,0 +1,89 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+#include "Global/Misc/LatencyHistogram.hpp"
+#include "Interlink/InterlinkEnums.hpp"
+#include "Interlink/Telemetry/InterlinkTickSummary.hpp"
+#include "Network/ReceiveDrain.hpp"
+
+/**
+ * @brief Counters for the Interlink tick loop.
+ * @details WakeLatencyUsec is the time from a wakeup being requested (ie SendMessage) until the
+ * tick actually started. That is the delay the tick loop adds on top of GNS for every packet.
+ */
+struct InterlinkTickTelemetry
+{
+	std::atomic<uint64_t> Ticks{0};
+	std::array<std::atomic<uint64_t>, (size_t)InterlinkWakeReason::eCount> Wakeups{};
+
+	LatencyHistogram TickDurationUsec;
+	LatencyHistogram WakeLatencyUsec;
+	ReceiveTelemetry Receive;
+	/// Client poll group, drained on its own thread rather than by the tick.
+	ReceiveTelemetry ClientReceive;
+
+	/// Time GNS connection status callbacks held the tick thread.
+	LatencyHistogram StatusCallbackUsec;
+	/// Incoming internal connections, by what decided their admission.
+	std::atomic<uint64_t> AdmittedFromSnapshot{0};
+	std::atomic<uint64_t> AdmittedAfterLookup{0};
+	std::atomic<uint64_t> AdmissionRejected{0};
+	/// From the connecting callback to the decision, for peers the snapshot did not know.
+	LatencyHistogram AdmissionLookupUsec;
+
+	/// Client messages carried in virtual channel frames, both directions.
+	std::atomic<uint64_t> ChannelMessagesOut{0};
+	std::atomic<uint64_t> ChannelMessagesIn{0};
+	LatencyHistogram MessagesPerChannelFrame;
+	/// Arrived on a channel no client is bound to, or malformed frames.
+	std::atomic<uint64_t> ChannelDropped{0};
+	/// Send rate or Nagle changes made by the LinkTuner.
+	std::atomic<uint64_t> LinkRetunes{0};
+
+	std::atomic<uint64_t> MessagesSent{0};
+	std::atomic<uint64_t> SendFailures{0};
+	LatencyHistogram MessagesPerFlush;
+
+	void CountWakeup(InterlinkWakeReason reason) noexcept
+	{
+		Wakeups[(size_t)reason].fetch_add(1, std::memory_order_relaxed);
+	}
+	[[nodiscard]] uint64_t GetWakeups(InterlinkWakeReason reason) const noexcept
+	{
+		return Wakeups[(size_t)reason].load(std::memory_order_relaxed);
+	}
+
+	[[nodiscard]] InterlinkTickSummary Summarize() const
+	{
+		return InterlinkTickSummary{
+			.Ticks = Ticks.load(std::memory_order_relaxed),
+			.WakeDeadline = GetWakeups(InterlinkWakeReason::eDeadline),
+			.WakeInbound = GetWakeups(InterlinkWakeReason::eInbound),
+			.WakeOutbound = GetWakeups(InterlinkWakeReason::eOutbound),
+			.WakeTransport = GetWakeups(InterlinkWakeReason::eTransport),
+			.TickP50 = TickDurationUsec.Percentile(0.5),
+			.TickP99 = TickDurationUsec.Percentile(0.99),
+			.WakeLatencyP50 = WakeLatencyUsec.Percentile(0.5),
+			.WakeLatencyP99 = WakeLatencyUsec.Percentile(0.99),
+			.ReceivedMessages = Receive.TotalMessages.load(std::memory_order_relaxed),
+			.ReceivedBytes = Receive.TotalBytes.load(std::memory_order_relaxed),
+			.ReceiveBudgetExhausted = Receive.BudgetExhaustedTicks.load(std::memory_order_relaxed),
+			.ReceiveLeftMessages = Receive.LeftMessagesTicks.load(std::memory_order_relaxed),
+			.ReceiveBatchSize = Receive.CurrentBatchSize.load(std::memory_order_relaxed),
+			.ClientReceivedMessages = ClientReceive.TotalMessages.load(std::memory_order_relaxed),
+			.ClientReceivedBytes = ClientReceive.TotalBytes.load(std::memory_order_relaxed),
+			.ClientReceiveBudgetExhausted =
+				ClientReceive.BudgetExhaustedTicks.load(std::memory_order_relaxed),
+			.ClientReceiveLeftMessages =
+				ClientReceive.LeftMessagesTicks.load(std::memory_order_relaxed),
+			.ClientReceiveBatchSize = ClientReceive.CurrentBatchSize.load(std::memory_order_relaxed),
+			.AdmittedFromSnapshot = AdmittedFromSnapshot.load(std::memory_order_relaxed),
+			.AdmittedAfterLookup = AdmittedAfterLookup.load(std::memory_order_relaxed),
+			.AdmissionRejected = AdmissionRejected.load(std::memory_order_relaxed),
+			.AdmissionLookupP50 = AdmissionLookupUsec.Percentile(0.5),
+			.AdmissionLookupP99 = AdmissionLookupUsec.Percentile(0.99),
+			.LinkRetunes = LinkRetunes.load(std::memory_order_relaxed)};
+	}
+};
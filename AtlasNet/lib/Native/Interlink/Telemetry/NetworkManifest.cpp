@@ -1,5 +1,7 @@
 #include "NetworkManifest.hpp"
+#include "Handshake/HandshakeService.hpp"
 #include "Network/NetworkCredentials.hpp"
+#include "Network/Packet/PacketMetrics.hpp"
 void NetworkManifest::ScheduleNetworkPings()
 {
 	//
@@ -9,6 +11,9 @@ void NetworkManifest::ScheduleNetworkPings()
 			while (!st.stop_requested())
 			{
 				NetworkManifest::Get().TelemetryUpdate(NetworkCredentials::Get().GetID());
+				NetworkManifest::Get().PacketTelemetryUpdate(NetworkCredentials::Get().GetID());
+				NetworkManifest::Get().HandshakeTelemetryUpdate(NetworkCredentials::Get().GetID());
+				NetworkManifest::Get().TickTelemetryUpdate(NetworkCredentials::Get().GetID());
 				std::this_thread::sleep_for(
 					std::chrono::milliseconds(_NETWORK_TELEMETRY_PING_INTERVAL_MS));
 			}
@@ -38,7 +43,10 @@ void NetworkManifest::TelemetryUpdate(const NetworkIdentity& identifier)
 				<< telemetry.inPacketsPerSec << '\t' << telemetry.pendingReliableBytes << '\t'
 				<< telemetry.pendingUnreliableBytes << '\t' << telemetry.sentUnackedReliableBytes
 				<< '\t' << telemetry.queueTimeUsec << '\t' << telemetry.qualityLocal << '\t'
-				<< telemetry.qualityRemote << '\t' << telemetry.state << '\n';
+				<< telemetry.qualityRemote << '\t' << telemetry.state << '\t'
+				<< telemetry.pendingQueueMessages << '\t' << telemetry.pendingQueueBytes << '\t'
+				<< telemetry.pendingQueueDropped << '\t' << telemetry.sendRateMin << '\t'
+				<< telemetry.nagleTimeUsec << '\n';
 	}
 
 	writeResult = InternalDB::Get()->HSet(NetworkTelemetryTable, shardId, valueSS.str());
@@ -87,7 +95,7 @@ void NetworkManifest::GetAllTelemetry(std::vector<std::vector<std::string>>& out
 			}
 
 			std::vector<std::string> columns;
-			columns.reserve(13);
+			columns.reserve(18);
 			std::string column;
 			std::istringstream rowStream(line);
 			while (std::getline(rowStream, column, '\t'))
@@ -95,13 +103,13 @@ void NetworkManifest::GetAllTelemetry(std::vector<std::vector<std::string>>& out
 				columns.push_back(column);
 			}
 
-			if (columns.size() != 13)
+			if (columns.size() != 18)
 			{
 				continue;
 			}
 
 			std::vector<std::string> row;
-			row.reserve(14);
+			row.reserve(19);
 			row.push_back(shardId);
 			row.insert(row.end(), columns.begin(), columns.end());
 			out_telemetry.push_back(std::move(row));
@@ -143,7 +151,7 @@ void NetworkManifest::GetAllTelemetry(std::vector<std::vector<std::string>>& out
 			t.Deserialize(valueBR);
 
 			std::vector<std::string> row;
-			row.reserve(14);
+			row.reserve(19);
 
 			row.push_back(shardId);
 			row.push_back(t.IdentityId);
@@ -159,6 +167,11 @@ void NetworkManifest::GetAllTelemetry(std::vector<std::vector<std::string>>& out
 			row.push_back(std::to_string(t.qualityLocal));
 			row.push_back(std::to_string(t.qualityRemote));
 			row.push_back(std::to_string(t.state));
+			row.push_back(std::to_string(t.pendingQueueMessages));
+			row.push_back(std::to_string(t.pendingQueueBytes));
+			row.push_back(std::to_string(t.pendingQueueDropped));
+			row.push_back(std::to_string(t.sendRateMin));
+			row.push_back(std::to_string(t.nagleTimeUsec));
 
 			// for (auto& field : row) {
 			//     std::cerr << "  " << field << std::endl;
@@ -168,4 +181,288 @@ void NetworkManifest::GetAllTelemetry(std::vector<std::vector<std::string>>& out
 		}
 #endif
 	}
-}
\ No newline at end of file
+}
+
+void NetworkManifest::PacketTelemetryUpdate(const NetworkIdentity& identifier)
+{
+	const std::vector<PacketTypeTelemetry> packetTypes =
+		PacketMetrics::Collect(&Interlink::Get().GetDispatchExecutor());
+	if (packetTypes.empty())
+	{
+		return;
+	}
+
+	auto writeResult = int64_t(0);
+#if NETWORK_MANIFEST_USE_PLAIN_STRING_DB
+	std::ostringstream valueSS;
+	for (const auto& telemetry : packetTypes)
+	{
+		const std::vector<std::string> columns = telemetry.ToRow();
+		for (size_t i = 0; i < columns.size(); ++i)
+		{
+			valueSS << (i == 0 ? "" : "\t") << columns[i];
+		}
+		valueSS << '\n';
+	}
+
+	writeResult =
+		InternalDB::Get()->HSet(PacketTelemetryTable, identifier.ToString(), valueSS.str());
+#else
+	ByteWriter valueBW;
+	valueBW.u32(static_cast<uint32_t>(packetTypes.size()));
+	for (const auto& telemetry : packetTypes)
+	{
+		telemetry.Serialize(valueBW);
+	}
+
+	ByteWriter fieldBW;
+	fieldBW.uuid(identifier.ID);
+
+	writeResult = InternalDB::Get()->HSet(PacketTelemetryTable, fieldBW.as_string_view(),
+										  valueBW.as_string_view());
+#endif
+
+	if (writeResult != 0)
+	{
+		std::printf("Failed to update packet telemetry. HSET result: %lli\n",
+					static_cast<long long>(writeResult));
+	}
+}
+
+void NetworkManifest::GetAllPacketTelemetry(std::vector<std::vector<std::string>>& out_telemetry)
+{
+	out_telemetry.clear();
+
+	const auto all = InternalDB::Get()->HGetAll(PacketTelemetryTable);
+
+	for (const auto& pair : all)
+	{
+#if NETWORK_MANIFEST_USE_PLAIN_STRING_DB
+		std::istringstream lines(pair.second);
+		std::string line;
+		while (std::getline(lines, line))
+		{
+			if (line.empty())
+			{
+				continue;
+			}
+
+			std::vector<std::string> row;
+			row.reserve(PacketTypeTelemetry::ColumnCount + 1);
+			row.push_back(pair.first);
+			std::string column;
+			std::istringstream rowStream(line);
+			while (std::getline(rowStream, column, '\t'))
+			{
+				row.push_back(column);
+			}
+
+			if (row.size() != PacketTypeTelemetry::ColumnCount + 1)
+			{
+				continue;
+			}
+			out_telemetry.push_back(std::move(row));
+		}
+#else
+		std::string nodeId;
+		std::vector<PacketTypeTelemetry> packetTypes;
+		try
+		{
+			ByteReader fieldBR(pair.first);
+			nodeId = NetworkIdentity::MakeIDShard(fieldBR.uuid()).ToString();
+
+			ByteReader valueBR(pair.second);
+			const uint32_t count = valueBR.u32();
+			packetTypes.resize(count);
+			for (auto& telemetry : packetTypes)
+			{
+				telemetry.Deserialize(valueBR);
+			}
+		}
+		catch (const std::exception&)
+		{
+			continue;
+		}
+
+		for (const auto& telemetry : packetTypes)
+		{
+			std::vector<std::string> row = telemetry.ToRow();
+			row.insert(row.begin(), nodeId);
+			out_telemetry.push_back(std::move(row));
+		}
+#endif
+	}
+}
+
+void NetworkManifest::HandshakeTelemetryUpdate(const NetworkIdentity& identifier)
+{
+	const HandshakeTelemetrySummary summary = HandshakeService::Get().GetTelemetry().Summarize();
+	if (summary.Batches == 0)
+	{
+		return;
+	}
+
+	auto writeResult = int64_t(0);
+#if NETWORK_MANIFEST_USE_PLAIN_STRING_DB
+	std::ostringstream valueSS;
+	const std::vector<std::string> columns = summary.ToRow();
+	for (size_t i = 0; i < columns.size(); ++i)
+	{
+		valueSS << (i == 0 ? "" : "\t") << columns[i];
+	}
+
+	writeResult =
+		InternalDB::Get()->HSet(HandshakeTelemetryTable, identifier.ToString(), valueSS.str());
+#else
+	ByteWriter valueBW;
+	summary.Serialize(valueBW);
+
+	ByteWriter fieldBW;
+	fieldBW.uuid(identifier.ID);
+
+	writeResult = InternalDB::Get()->HSet(HandshakeTelemetryTable, fieldBW.as_string_view(),
+										  valueBW.as_string_view());
+#endif
+
+	if (writeResult != 0)
+	{
+		std::printf("Failed to update handshake telemetry. HSET result: %lli\n",
+					static_cast<long long>(writeResult));
+	}
+}
+
+void NetworkManifest::GetAllHandshakeTelemetry(
+	std::vector<std::vector<std::string>>& out_telemetry)
+{
+	out_telemetry.clear();
+
+	const auto all = InternalDB::Get()->HGetAll(HandshakeTelemetryTable);
+
+	for (const auto& pair : all)
+	{
+#if NETWORK_MANIFEST_USE_PLAIN_STRING_DB
+		std::vector<std::string> row;
+		row.reserve(HandshakeTelemetrySummary::ColumnCount + 1);
+		row.push_back(pair.first);
+		std::string column;
+		std::istringstream rowStream(pair.second);
+		while (std::getline(rowStream, column, '\t'))
+		{
+			row.push_back(column);
+		}
+
+		if (row.size() != HandshakeTelemetrySummary::ColumnCount + 1)
+		{
+			continue;
+		}
+		out_telemetry.push_back(std::move(row));
+#else
+		std::vector<std::string> row;
+		try
+		{
+			ByteReader fieldBR(pair.first);
+			const std::string nodeId =
+				NetworkIdentity(NetworkIdentityType::eProxy, fieldBR.uuid()).ToString();
+
+			ByteReader valueBR(pair.second);
+			HandshakeTelemetrySummary summary;
+			summary.Deserialize(valueBR);
+			row = summary.ToRow();
+			row.insert(row.begin(), nodeId);
+		}
+		catch (const std::exception&)
+		{
+			continue;
+		}
+		out_telemetry.push_back(std::move(row));
+#endif
+	}
+}
+
+void NetworkManifest::TickTelemetryUpdate(const NetworkIdentity& identifier)
+{
+	const Interlink& interlink = Interlink::Get();
+	InterlinkTickSummary summary = interlink.GetTickTelemetry().Summarize();
+	if (summary.Ticks == 0)
+	{
+		return;
+	}
+	const PacketStreamStats& streams = interlink.GetStreamStats();
+	summary.StreamsCompleted = streams.Completed.load(std::memory_order_relaxed);
+	summary.StreamsDropped = streams.Dropped.load(std::memory_order_relaxed);
+	summary.StreamChunksReceived = streams.ChunksReceived.load(std::memory_order_relaxed);
+	summary.StreamBytesPending = streams.BytesPending.load(std::memory_order_relaxed);
+
+	auto writeResult = int64_t(0);
+#if NETWORK_MANIFEST_USE_PLAIN_STRING_DB
+	std::ostringstream valueSS;
+	const std::vector<std::string> columns = summary.ToRow();
+	for (size_t i = 0; i < columns.size(); ++i)
+	{
+		valueSS << (i == 0 ? "" : "\t") << columns[i];
+	}
+
+	writeResult = InternalDB::Get()->HSet(TickTelemetryTable, identifier.ToString(), valueSS.str());
+#else
+	ByteWriter valueBW;
+	summary.Serialize(valueBW);
+
+	ByteWriter fieldBW;
+	fieldBW.uuid(identifier.ID);
+
+	writeResult = InternalDB::Get()->HSet(TickTelemetryTable, fieldBW.as_string_view(),
+										  valueBW.as_string_view());
+#endif
+
+	if (writeResult != 0)
+	{
+		std::printf("Failed to update tick telemetry. HSET result: %lli\n",
+					static_cast<long long>(writeResult));
+	}
+}
+
+void NetworkManifest::GetAllTickTelemetry(std::vector<std::vector<std::string>>& out_telemetry)
+{
+	out_telemetry.clear();
+
+	const auto all = InternalDB::Get()->HGetAll(TickTelemetryTable);
+
+	for (const auto& pair : all)
+	{
+#if NETWORK_MANIFEST_USE_PLAIN_STRING_DB
+		std::vector<std::string> row;
+		row.reserve(InterlinkTickSummary::ColumnCount + 1);
+		row.push_back(pair.first);
+		std::string column;
+		std::istringstream rowStream(pair.second);
+		while (std::getline(rowStream, column, '\t'))
+		{
+			row.push_back(column);
+		}
+
+		if (row.size() != InterlinkTickSummary::ColumnCount + 1)
+		{
+			continue;
+		}
+		out_telemetry.push_back(std::move(row));
+#else
+		std::vector<std::string> row;
+		try
+		{
+			ByteReader fieldBR(pair.first);
+			const std::string nodeId = NetworkIdentity::MakeIDShard(fieldBR.uuid()).ToString();
+
+			ByteReader valueBR(pair.second);
+			InterlinkTickSummary summary;
+			summary.Deserialize(valueBR);
+			row = summary.ToRow();
+			row.insert(row.begin(), nodeId);
+		}
+		catch (const std::exception&)
+		{
+			continue;
+		}
+		out_telemetry.push_back(std::move(row));
+#endif
+	}
+}
@@ -19,6 +19,9 @@ class NetworkManifest : public Singleton<NetworkManifest> {
 public:
 
     const std::string NetworkTelemetryTable = "Network_Telemetry";
+    const std::string PacketTelemetryTable = "Network_PacketTelemetry";
+    const std::string HandshakeTelemetryTable = "Network_HandshakeTelemetry";
+    const std::string TickTelemetryTable = "Network_TickTelemetry";
 
 	std::optional<NetworkIdentity> identifier;
 	std::jthread HealthPingIntervalFunc;
@@ -29,11 +32,23 @@ public:
  void ScheduleNetworkPings();
 
  void TelemetryUpdate(const NetworkIdentity& identifier);
+ /// @brief Publish this node's PacketMetrics, one row per packet type.
+ void PacketTelemetryUpdate(const NetworkIdentity& identifier);
+ /// @brief Publish this proxy's HandshakeService stage timings, once it has handled a batch.
+ void HandshakeTelemetryUpdate(const NetworkIdentity& identifier);
+ /// @brief Publish this node's InterlinkTickTelemetry.
+ void TickTelemetryUpdate(const NetworkIdentity& identifier);
 
  //=================================
  //===          GET              ===
  //=================================
  void GetAllTelemetry(std::vector<std::vector<std::string>>& out_telemetry);
+ // Column 0 is the node id, then PacketTypeTelemetry::ToRow() columns.
+ void GetAllPacketTelemetry(std::vector<std::vector<std::string>>& out_telemetry);
+ // Column 0 is the proxy id, then HandshakeTelemetrySummary::ToRow() columns.
+ void GetAllHandshakeTelemetry(std::vector<std::vector<std::string>>& out_telemetry);
+ // Column 0 is the node id, then InterlinkTickSummary::ToRow() columns.
+ void GetAllTickTelemetry(std::vector<std::vector<std::string>>& out_telemetry);
 };
 
 
@@ -0,0 +1,50 @@
+#pragma once
+#include <functional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "Network/ConnectionTelemetry.hpp"
+#include "Network/NetworkEnums.hpp"
+#include "Network/NetworkIdentity.hpp"
+#include "Network/OutboundBuffer.hpp"
+
+/**
+ * @brief A way to reach peers that bypasses GNS, tried by the Interlink before it falls back to a
+ * GNS connection.
+ * @details Owned and driven by the Interlink tick thread, nothing here needs to be thread safe
+ * unless the transport itself is fed from elsewhere. Messages arrive as the same serialized bytes
+ * GNS would carry, so streaming, compression, relays and dispatch behave exactly alike.
+ */
+class IInterlinkTransport
+{
+   public:
+	using DeliverFn = std::function<void(const NetworkIdentity &sender,
+										 std::span<const uint8_t> bytes,
+										 NetworkMessageSendFlag sendFlag)>;
+	using ReachableFn = std::function<void(const NetworkIdentity &who)>;
+
+	virtual ~IInterlinkTransport() = default;
+	[[nodiscard]] virtual std::string_view GetName() const = 0;
+
+	/// @brief Whether who can be reached right now, in which case no GNS connection is opened.
+	[[nodiscard]] virtual bool Reaches(const NetworkIdentity &who) = 0;
+	/// @return false when who is not reachable through this transport.
+	virtual bool Send(const NetworkIdentity &who, const OutboundBufferPtr &buffer,
+					  NetworkMessageSendFlag sendFlag) = 0;
+	/// @brief Hand everything received since the last poll to deliver.
+	/// @return number of messages delivered
+	virtual uint32_t Poll(const DeliverFn &deliver) = 0;
+	/// @brief Try to open a link to who, a peer found in the ServerRegistry on this host.
+	/// @details Runs on the resolver thread where blocking is fine, so it must not touch anything
+	/// the tick thread owns.
+	/// @return what the tick thread runs to start using the link, empty when who cannot be reached
+	/// this way and GNS should be used.
+	virtual std::function<void()> Negotiate(const NetworkIdentity &who) { return {}; }
+	/// @brief Append one row per peer reached through this transport.
+	virtual void CollectTelemetry(std::vector<ConnectionTelemetry> &out) {}
+	virtual void Shutdown() {}
+
+	/// Called on the tick thread whenever a peer becomes reachable through this transport.
+	ReachableFn OnReachable;
+};
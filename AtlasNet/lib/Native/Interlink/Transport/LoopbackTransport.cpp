@@ -0,0 +1,115 @@
+#include "LoopbackTransport.hpp"
+
+void LoopbackHub::Attach(const NetworkIdentity &who, std::shared_ptr<LoopbackEndpoint> endpoint)
+{
+	std::lock_guard lock(Mutex);
+	Endpoints[who] = std::move(endpoint);
+	Generation.fetch_add(1, std::memory_order_acq_rel);
+}
+
+void LoopbackHub::Detach(const NetworkIdentity &who)
+{
+	std::lock_guard lock(Mutex);
+	Endpoints.erase(who);
+	Generation.fetch_add(1, std::memory_order_acq_rel);
+}
+
+void LoopbackHub::Snapshot(
+	std::unordered_map<NetworkIdentity, std::shared_ptr<LoopbackEndpoint>> &out) const
+{
+	std::lock_guard lock(Mutex);
+	out = Endpoints;
+}
+
+LoopbackTransport::LoopbackTransport(const NetworkIdentity &self, std::function<void()> wake)
+	: Self(self), Hub(LoopbackHub::Get()), Inbox(std::make_shared<LoopbackEndpoint>())
+{
+	Inbox->Wake = std::move(wake);
+	Hub.Attach(Self, Inbox);
+	Attached = true;
+}
+
+LoopbackTransport::~LoopbackTransport()
+{
+	Shutdown();
+}
+
+void LoopbackTransport::Shutdown()
+{
+	if (!Attached)
+		return;
+	Hub.Detach(Self);
+	Inbox->Close();
+	Attached = false;
+	Peers.clear();
+}
+
+LoopbackEndpoint *LoopbackTransport::FindPeer(const NetworkIdentity &who)
+{
+	if (!Attached)
+		return nullptr;
+	if (const uint64_t generation = Hub.GetGeneration(); generation != PeersGeneration)
+	{
+		Hub.Snapshot(Peers);
+		PeersGeneration = generation;
+	}
+	auto it = Peers.find(who);
+	return it == Peers.end() ? nullptr : it->second.get();
+}
+
+bool LoopbackTransport::Reaches(const NetworkIdentity &who)
+{
+	return FindPeer(who) != nullptr;
+}
+
+bool LoopbackTransport::Send(const NetworkIdentity &who, const OutboundBufferPtr &buffer,
+							 NetworkMessageSendFlag sendFlag)
+{
+	LoopbackEndpoint *peer = FindPeer(who);
+	if (!peer)
+		return false;
+	peer->Inbox.Push(LoopbackMessage{.Sender = Self, .Buffer = buffer, .Flag = sendFlag});
+	Contacted.insert(who);
+	peer->Notify();
+	return true;
+}
+
+uint32_t LoopbackTransport::Poll(const DeliverFn &deliver)
+{
+	uint32_t delivered = 0;
+	while (delivered < MaxPerPoll)
+	{
+		std::optional<LoopbackMessage> message = Inbox->Inbox.Pop();
+		if (!message)
+			break;
+		const OutboundBuffer &buffer = *message->Buffer;
+		const std::span<const uint8_t> bytes = buffer.Writer.bytes();
+		// Streamed packets keep their framing, every frame is a message of its own
+		uint32_t begin = 0;
+		if (buffer.FrameEnds.empty())
+			deliver(message->Sender, bytes, message->Flag);
+		for (uint32_t end : buffer.FrameEnds)
+		{
+			deliver(message->Sender, bytes.subspan(begin, end - begin), message->Flag);
+			begin = end;
+		}
+		delivered++;
+	}
+	return delivered;
+}
+
+void LoopbackTransport::CollectTelemetry(std::vector<ConnectionTelemetry> &out)
+{
+	for (const NetworkIdentity &who : Contacted)
+	{
+		if (!FindPeer(who))
+			continue;
+		ConnectionTelemetry t{};
+		t.IdentityId = Self.ToString();
+		t.targetId = who.ToString();
+		t.state = k_ESteamNetworkingConnectionState_Connected;
+		t.qualityLocal = 1;
+		t.qualityRemote = 1;
+		out.push_back(std::move(t));
+	}
+}
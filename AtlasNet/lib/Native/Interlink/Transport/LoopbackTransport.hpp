@@ -0,0 +1,101 @@
+#pragma once
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "Global/Misc/MPSCQueue.hpp"
+#include "Global/Misc/Singleton.hpp"
+#include "IInterlinkTransport.hpp"
+
+/// @brief Serialized packet handed from one Interlink to another in the same process.
+struct LoopbackMessage
+{
+	NetworkIdentity Sender;
+	OutboundBufferPtr Buffer;
+	NetworkMessageSendFlag Flag;
+};
+
+/// @brief Inbox of one Interlink for messages from endpoints in the same process.
+/// @details Senders may still hold the endpoint after its owner shut down, so the wakeup goes
+/// through Notify, which does nothing once Close ran.
+struct LoopbackEndpoint
+{
+	MPSCQueue<LoopbackMessage> Inbox;
+
+	void Notify()
+	{
+		std::lock_guard lock(WakeMutex);
+		if (Wake)
+			Wake();
+	}
+	void Close()
+	{
+		std::lock_guard lock(WakeMutex);
+		Wake = nullptr;
+	}
+
+	std::mutex WakeMutex;
+	/// Wakes the owning tick thread, set before the endpoint is attached.
+	std::function<void()> Wake;
+};
+
+/// @brief Every Interlink endpoint of this process, by identity.
+class LoopbackHub : public Singleton<LoopbackHub>
+{
+   public:
+	void Attach(const NetworkIdentity &who, std::shared_ptr<LoopbackEndpoint> endpoint);
+	void Detach(const NetworkIdentity &who);
+	/// @brief Bumped on every attach and detach, so readers only copy the table when it changed.
+	[[nodiscard]] uint64_t GetGeneration() const
+	{
+		return Generation.load(std::memory_order_acquire);
+	}
+	void Snapshot(std::unordered_map<NetworkIdentity, std::shared_ptr<LoopbackEndpoint>> &out) const;
+
+   private:
+	mutable std::mutex Mutex;
+	std::unordered_map<NetworkIdentity, std::shared_ptr<LoopbackEndpoint>> Endpoints;
+	std::atomic<uint64_t> Generation{0};
+};
+
+/**
+ * @brief Transport between Interlink endpoints that live in the same process.
+ * @details Sending pushes the refcounted OutboundBuffer straight into the peer's lock free inbox,
+ * with no copy, encryption or socket in between. The peer's tick thread decodes it like any other
+ * message. Ordering per sender is preserved and nothing is ever dropped, so unreliable sends
+ * behave like reliable ones.
+ */
+class LoopbackTransport : public IInterlinkTransport
+{
+   public:
+	/// @param wake called from the sending thread whenever something lands in our inbox
+	LoopbackTransport(const NetworkIdentity &self, std::function<void()> wake);
+	~LoopbackTransport() override;
+
+	[[nodiscard]] std::string_view GetName() const override { return "Loopback"; }
+	[[nodiscard]] bool Reaches(const NetworkIdentity &who) override;
+	bool Send(const NetworkIdentity &who, const OutboundBufferPtr &buffer,
+			  NetworkMessageSendFlag sendFlag) override;
+	uint32_t Poll(const DeliverFn &deliver) override;
+	void CollectTelemetry(std::vector<ConnectionTelemetry> &out) override;
+	void Shutdown() override;
+
+	/// Messages handled per Poll, the rest waits for the next tick so GNS is not starved.
+	uint32_t MaxPerPoll = 4096;
+
+   private:
+	LoopbackEndpoint *FindPeer(const NetworkIdentity &who);
+
+	NetworkIdentity Self;
+	// Singleton::Get locks, so the hub is looked up once
+	LoopbackHub &Hub;
+	std::shared_ptr<LoopbackEndpoint> Inbox;
+	bool Attached = false;
+	std::unordered_map<NetworkIdentity, std::shared_ptr<LoopbackEndpoint>> Peers;
+	uint64_t PeersGeneration = ~0ull;
+	/// Peers sent to at least once, reported in telemetry like a connection would be
+	std::unordered_set<NetworkIdentity> Contacted;
+};
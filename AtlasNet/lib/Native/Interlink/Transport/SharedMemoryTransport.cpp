@@ -0,0 +1,547 @@
+#include "SharedMemoryTransport.hpp"
+
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <boost/uuid/uuid_io.hpp>
+#include <cerrno>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <new>
+#include <utility>
+
+#include "Global/Serialize/ByteReader.hpp"
+#include "Global/Serialize/ByteWriter.hpp"
+
+namespace
+{
+constexpr uint32_t LinkMagic = 0x4154534d;	// "ATSM"
+constexpr uint32_t LinkVersion = 1;
+/// Ring headers live in the first page, the rings' data follows page aligned.
+constexpr size_t LinkHeaderBytes = 4096;
+constexpr uint8_t HandshakeAccept = 1;
+
+struct LinkHeader
+{
+	uint32_t Magic;
+	uint32_t Version;
+	uint32_t RingBytes;
+	uint32_t Reserved;
+	ShmRingHeader DialerToAcceptor;
+	ShmRingHeader AcceptorToDialer;
+};
+static_assert(sizeof(LinkHeader) <= LinkHeaderBytes);
+
+/// Closes the descriptor unless it was released.
+struct FileDescriptor
+{
+	int Fd = -1;
+	explicit FileDescriptor(int fd) : Fd(fd) {}
+	FileDescriptor(const FileDescriptor &) = delete;
+	FileDescriptor &operator=(const FileDescriptor &) = delete;
+	~FileDescriptor()
+	{
+		if (Fd >= 0)
+			close(Fd);
+	}
+	int Release() { return std::exchange(Fd, -1); }
+};
+
+bool MakeAddress(const std::string &path, sockaddr_un &addr)
+{
+	addr = {};
+	addr.sun_family = AF_UNIX;
+	if (path.size() >= sizeof(addr.sun_path))
+		return false;
+	std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+	return true;
+}
+
+size_t LinkBytes(uint32_t ringBytes)
+{
+	return LinkHeaderBytes + 2 * (size_t)ringBytes;
+}
+
+bool FramesFit(const OutboundBuffer &buffer, uint32_t maxFrame)
+{
+	if (buffer.FrameEnds.empty())
+		return buffer.Writer.size() <= maxFrame;
+	uint32_t begin = 0;
+	for (uint32_t end : buffer.FrameEnds)
+	{
+		if (end - begin > maxFrame)
+			return false;
+		begin = end;
+	}
+	return true;
+}
+}  // namespace
+
+struct SharedMemoryLink
+{
+	struct Pending
+	{
+		OutboundBufferPtr Buffer;
+		NetworkMessageSendFlag Flag;
+		/// First frame of Buffer not written yet
+		uint32_t Frame;
+	};
+
+	NetworkIdentity Peer;
+	/// Control socket, only read to notice the peer going away.
+	int Socket;
+	void *Mapping;
+	size_t MappingBytes;
+	ShmRing Outbound;
+	ShmRing Inbound;
+	std::deque<Pending> Backlog;
+	uint64_t BacklogBytes = 0;
+	bool Broken = false;
+	std::jthread Waker;
+
+	SharedMemoryLink(const NetworkIdentity &peer, int socket, void *mapping, size_t bytes,
+					 bool dialer)
+		: Peer(peer), Socket(socket), Mapping(mapping), MappingBytes(bytes)
+	{
+		auto *header = static_cast<LinkHeader *>(mapping);
+		uint8_t *data = static_cast<uint8_t *>(mapping) + LinkHeaderBytes;
+		ShmRing forward(&header->DialerToAcceptor, data, header->RingBytes);
+		ShmRing backward(&header->AcceptorToDialer, data + header->RingBytes, header->RingBytes);
+		Outbound = dialer ? forward : backward;
+		Inbound = dialer ? backward : forward;
+	}
+	~SharedMemoryLink()
+	{
+		Outbound.Close();
+		Inbound.Close();
+		if (Waker.joinable())
+		{
+			Waker.request_stop();
+			Waker.join();
+		}
+		munmap(Mapping, MappingBytes);
+		close(Socket);
+	}
+
+	void StartWaker(const std::function<void()> &wake)
+	{
+		Waker = std::jthread(
+			[this, wake](std::stop_token st)
+			{
+				uint32_t seen = Inbound.GetDoorbell();
+				while (!st.stop_requested())
+				{
+					// Timeout only bounds how long a stop request goes unnoticed
+					const uint32_t now =
+						Inbound.WaitForDoorbell(seen, std::chrono::milliseconds(100));
+					if (now == seen)
+						continue;
+					seen = now;
+					wake();
+				}
+			});
+	}
+};
+
+SharedMemoryTransport::SharedMemoryTransport(const NetworkIdentity &self,
+											 const SharedMemoryTransportSettings &settings,
+											 std::function<void()> wake)
+	: Self(self), Settings(settings), Wake(std::move(wake))
+{
+}
+
+SharedMemoryTransport::~SharedMemoryTransport()
+{
+	Shutdown();
+}
+
+std::string SharedMemoryTransport::HostKey(const std::string &directory)
+{
+	// Containers share the kernel's boot id with their host. The directory's inode tells apart
+	// containers that do not have the same directory mounted.
+	std::string bootID;
+	std::ifstream("/proc/sys/kernel/random/boot_id") >> bootID;
+	if (bootID.empty())
+		return {};
+	struct stat st{};
+	if (stat(directory.c_str(), &st) != 0)
+		return {};
+	return bootID + ":" + std::to_string(st.st_dev) + ":" + std::to_string(st.st_ino);
+}
+
+std::string SharedMemoryTransport::SocketPath(const NetworkIdentity &who) const
+{
+	return Settings.Directory + "/atlasnet-" + std::to_string((int)who.Type) + "-" +
+		   boost::uuids::to_string(who.ID) + ".sock";
+}
+
+bool SharedMemoryTransport::Listen()
+{
+	if (Settings.RingBytes < 4096 || (Settings.RingBytes & (Settings.RingBytes - 1)) != 0)
+	{
+		logger.ErrorFormatted("RingBytes {} is not a power of two of at least 4096",
+							  Settings.RingBytes);
+		return false;
+	}
+	std::error_code ec;
+	std::filesystem::create_directories(Settings.Directory, ec);
+
+	ListenPath = SocketPath(Self);
+	sockaddr_un addr;
+	if (!MakeAddress(ListenPath, addr))
+	{
+		logger.ErrorFormatted("Socket path {} is too long", ListenPath);
+		return false;
+	}
+	FileDescriptor sock(socket(AF_UNIX, SOCK_SEQPACKET | SOCK_NONBLOCK | SOCK_CLOEXEC, 0));
+	// Left behind by a previous process with our identity
+	unlink(ListenPath.c_str());
+	if (sock.Fd < 0 || bind(sock.Fd, (sockaddr *)&addr, sizeof(addr)) != 0 ||
+		listen(sock.Fd, 64) != 0)
+	{
+		logger.WarningFormatted("Cannot listen on {}: {}. Shared memory links disabled",
+								ListenPath, std::strerror(errno));
+		return false;
+	}
+	ListenSocket = sock.Release();
+	logger.DebugFormatted("Accepting shared memory links on {}", ListenPath);
+	return true;
+}
+
+void SharedMemoryTransport::Shutdown()
+{
+	Links.clear();
+	for (const Handshake &handshake : Handshakes)
+		close(handshake.Socket);
+	Handshakes.clear();
+	if (ListenSocket >= 0)
+	{
+		close(ListenSocket);
+		unlink(ListenPath.c_str());
+		ListenSocket = -1;
+	}
+}
+
+std::function<void()> SharedMemoryTransport::Negotiate(const NetworkIdentity &who)
+{
+	if (ListenSocket < 0)
+		return {};
+	auto failed = [&](std::string_view step)
+	{
+		Stats.DialsFailed.fetch_add(1, std::memory_order_relaxed);
+		logger.DebugFormatted("No shared memory link to {}, {} failed: {}", who.ToString(), step,
+							  std::strerror(errno));
+		return std::function<void()>();
+	};
+
+	sockaddr_un addr;
+	if (!MakeAddress(SocketPath(who), addr))
+		return failed("address");
+	FileDescriptor sock(socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0));
+	if (sock.Fd < 0 || connect(sock.Fd, (sockaddr *)&addr, sizeof(addr)) != 0)
+		return failed("connect");
+
+	const size_t bytes = LinkBytes(Settings.RingBytes);
+	FileDescriptor memory(memfd_create("atlasnet-interlink", MFD_CLOEXEC));
+	if (memory.Fd < 0 || ftruncate(memory.Fd, (off_t)bytes) != 0)
+		return failed("memfd");
+	void *mapping = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, memory.Fd, 0);
+	if (mapping == MAP_FAILED)
+		return failed("mmap");
+	new (mapping) LinkHeader{.Magic = LinkMagic,
+							 .Version = LinkVersion,
+							 .RingBytes = Settings.RingBytes,
+							 .Reserved = 0};
+	// Owns the socket and the mapping from here on, also when the handshake fails
+	auto link = std::make_shared<SharedMemoryLink>(who, sock.Release(), mapping, bytes, true);
+
+	ByteWriter hello;
+	Self.Serialize(hello);
+	const auto helloBytes = hello.bytes();
+	iovec iov{.iov_base = const_cast<uint8_t *>(helloBytes.data()), .iov_len = helloBytes.size()};
+	alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))] = {};
+	msghdr msg{};
+	msg.msg_iov = &iov;
+	msg.msg_iovlen = 1;
+	msg.msg_control = control;
+	msg.msg_controllen = sizeof(control);
+	cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+	cmsg->cmsg_level = SOL_SOCKET;
+	cmsg->cmsg_type = SCM_RIGHTS;
+	cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+	std::memcpy(CMSG_DATA(cmsg), &memory.Fd, sizeof(int));
+	if (sendmsg(link->Socket, &msg, MSG_NOSIGNAL) < 0)
+		return failed("sendmsg");
+
+	pollfd reply{.fd = link->Socket, .events = POLLIN, .revents = 0};
+	uint8_t answer = 0;
+	if (poll(&reply, 1, (int)Settings.DialTimeout.count()) != 1 ||
+		recv(link->Socket, &answer, 1, 0) != 1 || answer != HandshakeAccept)
+		return failed("handshake");
+
+	return [this, link]() mutable { Adopt(std::move(link)); };
+}
+
+void SharedMemoryTransport::AcceptHandshakes()
+{
+	const auto now = std::chrono::steady_clock::now();
+	for (int sock; (sock = accept4(ListenSocket, nullptr, nullptr,
+								   SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0;)
+		Handshakes.push_back(Handshake{.Socket = sock, .Deadline = now + Settings.DialTimeout});
+
+	for (size_t i = 0; i < Handshakes.size();)
+	{
+		FileDescriptor sock(Handshakes[i].Socket);
+		uint8_t payload[256];
+		iovec iov{.iov_base = payload, .iov_len = sizeof(payload)};
+		alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))] = {};
+		msghdr msg{};
+		msg.msg_iov = &iov;
+		msg.msg_iovlen = 1;
+		msg.msg_control = control;
+		msg.msg_controllen = sizeof(control);
+		const ssize_t received = recvmsg(sock.Fd, &msg, MSG_DONTWAIT | MSG_CMSG_CLOEXEC);
+		if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK) &&
+			now < Handshakes[i].Deadline)
+		{
+			sock.Release();
+			i++;
+			continue;
+		}
+		Handshakes[i] = Handshakes.back();
+		Handshakes.pop_back();
+
+		cmsghdr *cmsg = received > 0 ? CMSG_FIRSTHDR(&msg) : nullptr;
+		if (!cmsg || cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS)
+		{
+			logger.Warning("Dropped a shared memory handshake without a memory descriptor");
+			continue;
+		}
+		int fd;
+		std::memcpy(&fd, CMSG_DATA(cmsg), sizeof(int));
+		FileDescriptor memory(fd);
+
+		NetworkIdentity peer;
+		try
+		{
+			ByteReader br(std::span<const uint8_t>(payload, (size_t)received));
+			peer.Deserialize(br);
+		}
+		catch (const std::exception &e)
+		{
+			logger.WarningFormatted("Dropped a shared memory handshake: {}", e.what());
+			continue;
+		}
+
+		struct stat st{};
+		if (fstat(memory.Fd, &st) != 0 || (size_t)st.st_size <= LinkHeaderBytes)
+			continue;
+		const size_t bytes = (size_t)st.st_size;
+		void *mapping = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, memory.Fd, 0);
+		if (mapping == MAP_FAILED)
+			continue;
+		const auto *header = static_cast<const LinkHeader *>(mapping);
+		const uint32_t ringBytes = header->RingBytes;
+		if (header->Magic != LinkMagic || header->Version != LinkVersion || ringBytes < 4096 ||
+			(ringBytes & (ringBytes - 1)) != 0 || bytes != LinkBytes(ringBytes))
+		{
+			logger.WarningFormatted("Rejected shared memory link from {}, layout mismatch",
+									peer.ToString());
+			munmap(mapping, bytes);
+			continue;
+		}
+		if (send(sock.Fd, &HandshakeAccept, 1, MSG_NOSIGNAL) != 1)
+		{
+			munmap(mapping, bytes);
+			continue;
+		}
+		Adopt(std::make_shared<SharedMemoryLink>(peer, sock.Release(), mapping, bytes, false));
+	}
+}
+
+void SharedMemoryTransport::Adopt(std::shared_ptr<SharedMemoryLink> link)
+{
+	link->StartWaker(Wake);
+	const NetworkIdentity peer = link->Peer;
+	auto &links = Links[peer];
+	links.push_back(std::move(link));
+	logger.DebugFormatted("Shared memory link to {} is up", peer.ToString());
+	if (links.size() == 1 && OnReachable)
+		OnReachable(peer);
+}
+
+bool SharedMemoryTransport::Reaches(const NetworkIdentity &who)
+{
+	return Links.contains(who);
+}
+
+bool SharedMemoryTransport::WriteFrames(SharedMemoryLink &link, const OutboundBuffer &buffer,
+										uint32_t &frame, NetworkMessageSendFlag sendFlag)
+{
+	const std::span<const uint8_t> bytes = buffer.Writer.bytes();
+	if (buffer.FrameEnds.empty())
+	{
+		if (frame == 0 && !link.Outbound.TryWrite(bytes, (uint8_t)sendFlag))
+			return false;
+		frame = 1;
+		return true;
+	}
+	for (; frame < buffer.FrameEnds.size(); frame++)
+	{
+		const uint32_t begin = frame == 0 ? 0 : buffer.FrameEnds[frame - 1];
+		const uint32_t end = buffer.FrameEnds[frame];
+		if (!link.Outbound.TryWrite(bytes.subspan(begin, end - begin), (uint8_t)sendFlag))
+			return false;
+	}
+	return true;
+}
+
+bool SharedMemoryTransport::DrainBacklog(SharedMemoryLink &link)
+{
+	while (!link.Backlog.empty())
+	{
+		SharedMemoryLink::Pending &pending = link.Backlog.front();
+		const bool done = WriteFrames(link, *pending.Buffer, pending.Frame, pending.Flag);
+		link.Outbound.Publish();
+		if (!done)
+			return !link.Outbound.IsClosed();
+		link.BacklogBytes -= pending.Buffer->Writer.size();
+		link.Backlog.pop_front();
+	}
+	return true;
+}
+
+bool SharedMemoryTransport::Send(const NetworkIdentity &who, const OutboundBufferPtr &buffer,
+								 NetworkMessageSendFlag sendFlag)
+{
+	auto it = Links.find(who);
+	if (it == Links.end())
+		return false;
+	SharedMemoryLink &link = *it->second.front();
+	const uint64_t size = buffer->Writer.size();
+
+	// Nothing overtakes the backlog, that would reorder a stream
+	uint32_t frame = 0;
+	if (DrainBacklog(link) && link.Backlog.empty() && WriteFrames(link, *buffer, frame, sendFlag))
+	{
+		link.Outbound.Publish();
+		Stats.Sent.fetch_add(1, std::memory_order_relaxed);
+		return true;
+	}
+	link.Outbound.Publish();
+	// A frame the ring can never hold only happens when StreamChunkBytes exceeds half a ring
+	const bool reliable = (int)sendFlag & k_nSteamNetworkingSend_Reliable;
+	const bool fits = FramesFit(*buffer, link.Outbound.MaxFrame());
+	if (!reliable || !fits || link.BacklogBytes + size > Settings.MaxBacklogBytes)
+	{
+		if (!fits || reliable)
+			logger.ErrorFormatted("Dropping {} bytes for {}, {}", size, who.ToString(),
+								  fits ? "backlog is full" : "larger than the ring allows");
+		Stats.Dropped.fetch_add(1, std::memory_order_relaxed);
+		return true;
+	}
+	link.Backlog.push_back(
+		SharedMemoryLink::Pending{.Buffer = buffer, .Flag = sendFlag, .Frame = frame});
+	link.BacklogBytes += size;
+	Stats.Backlogged.fetch_add(1, std::memory_order_relaxed);
+	return true;
+}
+
+void SharedMemoryTransport::CheckLiveness()
+{
+	const auto now = std::chrono::steady_clock::now();
+	if (now < NextLivenessCheck)
+		return;
+	NextLivenessCheck = now + Settings.LivenessInterval;
+	for (auto &[who, links] : Links)
+	{
+		for (const auto &link : links)
+		{
+			uint8_t probe;
+			const ssize_t n = recv(link->Socket, &probe, 1, MSG_DONTWAIT | MSG_PEEK);
+			if (n == 0 || (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK) ||
+				link->Inbound.IsClosed())
+				link->Broken = true;
+		}
+	}
+}
+
+void SharedMemoryTransport::Drop(const NetworkIdentity &who)
+{
+	auto it = Links.find(who);
+	if (it == Links.end())
+		return;
+	std::erase_if(it->second,
+				  [&](const std::shared_ptr<SharedMemoryLink> &link)
+				  {
+					  if (!link->Broken)
+						  return false;
+					  logger.WarningFormatted("Shared memory link to {} is gone, {} messages lost",
+											  who.ToString(), link->Backlog.size());
+					  return true;
+				  });
+	if (it->second.empty())
+		Links.erase(it);
+}
+
+uint32_t SharedMemoryTransport::Poll(const DeliverFn &deliver)
+{
+	if (ListenSocket < 0)
+		return 0;
+	AcceptHandshakes();
+	CheckLiveness();
+
+	uint32_t received = 0;
+	std::vector<NetworkIdentity> broken;
+	for (auto &[who, links] : Links)
+	{
+		for (const auto &link : links)
+		{
+			if (!link->Broken && !DrainBacklog(*link))
+				link->Broken = true;
+			if (link->Broken)
+			{
+				broken.push_back(who);
+				continue;
+			}
+			const int32_t read = link->Inbound.Read(
+				MaxPerPoll, [&](std::span<const uint8_t> frame, uint8_t flag)
+				{ deliver(who, frame, (NetworkMessageSendFlag)flag); });
+			if (read < 0)
+			{
+				logger.ErrorFormatted("Corrupt shared memory ring from {}", who.ToString());
+				link->Broken = true;
+				broken.push_back(who);
+				continue;
+			}
+			received += (uint32_t)read;
+		}
+	}
+	for (const NetworkIdentity &who : broken)
+		Drop(who);
+	Stats.Received.fetch_add(received, std::memory_order_relaxed);
+	return received;
+}
+
+void SharedMemoryTransport::CollectTelemetry(std::vector<ConnectionTelemetry> &out)
+{
+	for (const auto &[who, links] : Links)
+	{
+		const SharedMemoryLink &link = *links.front();
+		ConnectionTelemetry t{};
+		t.IdentityId = Self.ToString();
+		t.targetId = who.ToString();
+		t.state = k_ESteamNetworkingConnectionState_Connected;
+		t.qualityLocal = 1;
+		t.qualityRemote = 1;
+		t.pendingReliableBytes = (uint32_t)std::min<uint64_t>(link.BacklogBytes, UINT32_MAX);
+		out.push_back(std::move(t));
+	}
+}
@@ -0,0 +1,113 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "Debug/Log.hpp"
+#include "IInterlinkTransport.hpp"
+#include "ShmRing.hpp"
+
+struct SharedMemoryTransportSettings
+{
+	/// Where endpoints put the sockets links are negotiated over. Every container on a host that
+	/// should use this transport needs the same directory mounted, empty disables the transport.
+	std::string Directory = "/run/atlasnet";
+	/// Size of each direction's ring, a power of two. Keep StreamChunkBytes below half of it.
+	uint32_t RingBytes = 4 * 1024 * 1024;
+	/// How long a dial waits for the peer to map the rings before falling back to GNS.
+	std::chrono::milliseconds DialTimeout = std::chrono::milliseconds(500);
+	/// Reliable messages that find the ring full wait here. Beyond this they are dropped.
+	uint64_t MaxBacklogBytes = 16 * 1024 * 1024;
+	/// How often links are checked for a peer that went away without closing them.
+	std::chrono::milliseconds LivenessInterval = std::chrono::milliseconds(100);
+};
+
+struct SharedMemoryStats
+{
+	std::atomic<uint64_t> Sent{0};
+	std::atomic<uint64_t> Received{0};
+	/// Frames that waited in the backlog because the ring was full.
+	std::atomic<uint64_t> Backlogged{0};
+	/// Unreliable frames that found the ring full, and reliable ones over MaxBacklogBytes.
+	std::atomic<uint64_t> Dropped{0};
+	std::atomic<uint64_t> DialsFailed{0};
+};
+
+/// @brief One negotiated pair of rings to a peer on the same host.
+struct SharedMemoryLink;
+
+/**
+ * @brief Transport between Interlink endpoints in different processes on the same host.
+ * @details A link is a memfd holding one single producer single consumer ring per direction. The
+ * dialing side creates it and passes the descriptor over a unix socket in Directory, the other side
+ * maps it and acknowledges. That socket then stays open only so either side notices the other one
+ * exiting. Producers copy frames straight into the ring and ring a futex doorbell. A small waker
+ * thread per link sleeps on it and wakes the tick thread, which reads the frames in place.
+ *
+ * Links are only dialed for peers the ServerRegistry places on the same host. A dial that fails for
+ * any reason, such as the directory not being shared, leaves the peer to GNS.
+ */
+class SharedMemoryTransport : public IInterlinkTransport
+{
+   public:
+	/// @param wake called from a waker thread whenever a link has something for us
+	SharedMemoryTransport(const NetworkIdentity &self, const SharedMemoryTransportSettings &settings,
+						  std::function<void()> wake);
+	~SharedMemoryTransport() override;
+
+	/// @brief Open the listen socket. Leaves the transport unusable when that fails.
+	bool Listen();
+	/// @brief Identifies this host to peers, published in the ServerRegistry. Two endpoints with
+	/// the same key share a kernel and can see each other's Directory.
+	[[nodiscard]] static std::string HostKey(const std::string &directory);
+
+	[[nodiscard]] std::string_view GetName() const override { return "SharedMemory"; }
+	[[nodiscard]] bool Reaches(const NetworkIdentity &who) override;
+	bool Send(const NetworkIdentity &who, const OutboundBufferPtr &buffer,
+			  NetworkMessageSendFlag sendFlag) override;
+	uint32_t Poll(const DeliverFn &deliver) override;
+	std::function<void()> Negotiate(const NetworkIdentity &who) override;
+	void CollectTelemetry(std::vector<ConnectionTelemetry> &out) override;
+	void Shutdown() override;
+
+	[[nodiscard]] const SharedMemoryStats &GetStats() const { return Stats; }
+
+	/// Frames read per link per Poll, the rest waits for the next tick so GNS is not starved.
+	uint32_t MaxPerPoll = 4096;
+
+   private:
+	struct Handshake
+	{
+		int Socket;
+		std::chrono::steady_clock::time_point Deadline;
+	};
+	[[nodiscard]] std::string SocketPath(const NetworkIdentity &who) const;
+	void Adopt(std::shared_ptr<SharedMemoryLink> link);
+	void AcceptHandshakes();
+	/// @brief Write what is waiting in the backlog.
+	/// @return false when the link is broken
+	bool DrainBacklog(SharedMemoryLink &link);
+	/// @brief Write buffer's frames starting at frame, recording where it stopped.
+	bool WriteFrames(SharedMemoryLink &link, const OutboundBuffer &buffer, uint32_t &frame,
+					 NetworkMessageSendFlag sendFlag);
+	void CheckLiveness();
+	void Drop(const NetworkIdentity &who);
+
+	NetworkIdentity Self;
+	SharedMemoryTransportSettings Settings;
+	std::function<void()> Wake;
+	Log logger = Log("SharedMemoryTransport");
+	int ListenSocket = -1;
+	std::string ListenPath;
+	std::vector<Handshake> Handshakes;
+	/// Every link to a peer is read, the first one is written. Two links exist when both sides
+	/// dialed at the same time.
+	std::unordered_map<NetworkIdentity, std::vector<std::shared_ptr<SharedMemoryLink>>> Links;
+	std::chrono::steady_clock::time_point NextLivenessCheck;
+	SharedMemoryStats Stats;
+};
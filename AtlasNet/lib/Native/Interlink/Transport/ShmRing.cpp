@@ -0,0 +1,77 @@
+#include "ShmRing.hpp"
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <ctime>
+
+namespace
+{
+// Not FUTEX_PRIVATE, the word is shared with another process
+long Futex(std::atomic<uint32_t> *word, int op, uint32_t value, const timespec *timeout)
+{
+	return syscall(SYS_futex, reinterpret_cast<uint32_t *>(word), op, value, timeout, nullptr, 0);
+}
+}  // namespace
+
+bool ShmRing::TryWrite(std::span<const uint8_t> frame, uint8_t flag)
+{
+	if (frame.size() > MaxFrame())
+		return false;
+	const uint32_t need = RecordHeaderBytes + Align((uint32_t)frame.size());
+	const uint32_t pos = (uint32_t)(Written & (Capacity - 1));
+	const uint32_t contiguous = Capacity - pos;
+	const uint64_t total = need <= contiguous ? need : (uint64_t)contiguous + need;
+	const uint64_t tail = Header->Tail.load(std::memory_order_acquire);
+	if (Capacity - (Written - tail) < total)
+		return false;
+
+	uint32_t at = pos;
+	if (need > contiguous)
+	{
+		const Record wrap{.Size = 0, .Flag = 0, .Kind = RecordKind::eWrap, .Reserved = 0};
+		std::memcpy(Data + pos, &wrap, sizeof(wrap));
+		at = 0;
+	}
+	const Record record{
+		.Size = (uint32_t)frame.size(), .Flag = flag, .Kind = RecordKind::eFrame, .Reserved = 0};
+	std::memcpy(Data + at, &record, sizeof(record));
+	std::memcpy(Data + at + RecordHeaderBytes, frame.data(), frame.size());
+	Written += total;
+	return true;
+}
+
+void ShmRing::Publish()
+{
+	if (Header->Head.load(std::memory_order_relaxed) == Written)
+		return;
+	Header->Head.store(Written, std::memory_order_release);
+	Ring();
+}
+
+void ShmRing::Ring()
+{
+	// Pairs with the Sleeping store in WaitForDoorbell, either the consumer sees the new doorbell
+	// before sleeping or we see it is about to sleep
+	Header->Doorbell.fetch_add(1, std::memory_order_seq_cst);
+	if (Header->Sleeping.load(std::memory_order_seq_cst))
+		Futex(&Header->Doorbell, FUTEX_WAKE, 1, nullptr);
+}
+
+uint32_t ShmRing::WaitForDoorbell(uint32_t seen, std::chrono::milliseconds timeout)
+{
+	Header->Sleeping.store(1, std::memory_order_seq_cst);
+	if (Header->Doorbell.load(std::memory_order_seq_cst) == seen && !IsClosed())
+	{
+		const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(timeout);
+		const timespec ts{.tv_sec = (time_t)seconds.count(),
+						  .tv_nsec = (long)std::chrono::duration_cast<std::chrono::nanoseconds>(
+										 timeout - seconds)
+										 .count()};
+		// Returns right away when the doorbell already moved, spurious wakeups are fine
+		Futex(&Header->Doorbell, FUTEX_WAIT, seen, &ts);
+	}
+	Header->Sleeping.store(0, std::memory_order_relaxed);
+	return Header->Doorbell.load(std::memory_order_acquire);
+}
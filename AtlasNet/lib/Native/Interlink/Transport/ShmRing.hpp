@@ -0,0 +1,130 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <span>
+
+/// @brief Control block of one ring, lives in memory mapped by both processes.
+struct ShmRingHeader
+{
+	/// Bytes ever published by the producer.
+	alignas(64) std::atomic<uint64_t> Head{0};
+	/// Bytes ever consumed, the producer may reuse everything before it.
+	alignas(64) std::atomic<uint64_t> Tail{0};
+	/// Futex word, bumped after every publish.
+	alignas(64) std::atomic<uint32_t> Doorbell{0};
+	/// Set while the consumer is about to sleep on Doorbell, so producers only pay for a wake
+	/// syscall when somebody is actually waiting.
+	std::atomic<uint32_t> Sleeping{0};
+	/// Set by either side once it stops using the ring.
+	std::atomic<uint32_t> Closed{0};
+};
+static_assert(std::atomic<uint64_t>::is_always_lock_free &&
+				  std::atomic<uint32_t>::is_always_lock_free,
+			  "Shared memory rings need address free atomics");
+
+/**
+ * @brief Single producer single consumer ring of frames over shared memory.
+ * @details Frames are stored as an 8 byte record header followed by the payload, padded to 8 bytes.
+ * A frame never wraps: when it does not fit before the end, a wrap record skips the remainder and
+ * it is written at the start instead. That keeps every frame contiguous so the consumer reads it in
+ * place. Capacity must be a power of two.
+ */
+class ShmRing
+{
+   public:
+	static constexpr uint32_t RecordHeaderBytes = 8;
+
+	ShmRing() = default;
+	ShmRing(ShmRingHeader *header, uint8_t *data, uint32_t capacity)
+		: Header(header),
+		  Data(data),
+		  Capacity(capacity),
+		  Written(header->Head.load(std::memory_order_relaxed))
+	{
+	}
+
+	/// @brief Largest frame that is guaranteed to fit once the consumer caught up.
+	[[nodiscard]] uint32_t MaxFrame() const { return Capacity / 2 - RecordHeaderBytes; }
+	[[nodiscard]] bool IsClosed() const
+	{
+		return Header->Closed.load(std::memory_order_acquire) != 0;
+	}
+	void Close()
+	{
+		Header->Closed.store(1, std::memory_order_release);
+		Ring();
+	}
+
+	/// @brief Producer side. Copy frame into the ring without publishing it.
+	/// @return false when there is no room right now.
+	bool TryWrite(std::span<const uint8_t> frame, uint8_t flag);
+	/// @brief Producer side. Make everything written so far visible and wake the consumer if it
+	/// sleeps.
+	void Publish();
+
+	/// @brief Consumer side. Hand up to max frames to fn, in place.
+	/// @details Frames are released to the producer when this returns, fn must copy what it keeps.
+	/// @return frames read, or -1 when the ring holds something that is not a valid record.
+	template <typename Fn>
+	int32_t Read(uint32_t max, Fn &&fn)
+	{
+		uint64_t tail = Header->Tail.load(std::memory_order_relaxed);
+		const uint64_t head = Header->Head.load(std::memory_order_acquire);
+		int32_t read = 0;
+		while (tail != head && (uint32_t)read < max)
+		{
+			const uint32_t pos = (uint32_t)(tail & (Capacity - 1));
+			Record record;
+			std::memcpy(&record, Data + pos, sizeof(record));
+			if (record.Kind == RecordKind::eWrap)
+			{
+				tail += Capacity - pos;
+				continue;
+			}
+			if (record.Kind != RecordKind::eFrame || record.Size > MaxFrame() ||
+				pos + RecordHeaderBytes + record.Size > Capacity)
+				return -1;
+			fn(std::span<const uint8_t>(Data + pos + RecordHeaderBytes, record.Size), record.Flag);
+			tail += RecordHeaderBytes + Align(record.Size);
+			read++;
+		}
+		Header->Tail.store(tail, std::memory_order_release);
+		return read;
+	}
+
+	/// @brief Consumer side. Sleep until the doorbell moves away from seen, the ring is closed
+	/// or timeout passes.
+	/// @return the current doorbell value
+	uint32_t WaitForDoorbell(uint32_t seen, std::chrono::milliseconds timeout);
+	[[nodiscard]] uint32_t GetDoorbell() const
+	{
+		return Header->Doorbell.load(std::memory_order_acquire);
+	}
+
+   private:
+	enum class RecordKind : uint8_t
+	{
+		eFrame = 1,
+		eWrap = 2,
+	};
+	struct Record
+	{
+		uint32_t Size;
+		uint8_t Flag;
+		RecordKind Kind;
+		uint16_t Reserved;
+	};
+	static_assert(sizeof(Record) == RecordHeaderBytes);
+
+	static constexpr uint32_t Align(uint32_t bytes) { return (bytes + 7u) & ~7u; }
+	/// Wake the consumer if it is parked on the doorbell.
+	void Ring();
+
+	ShmRingHeader *Header = nullptr;
+	uint8_t *Data = nullptr;
+	uint32_t Capacity = 0;
+	/// Producer's write position, ahead of Head until Publish.
+	uint64_t Written = 0;
+};
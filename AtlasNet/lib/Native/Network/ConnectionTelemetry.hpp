@@ -27,6 +27,15 @@ struct ConnectionTelemetry
 
     int state;
 
+    // Interlink's own queue of messages waiting for this connection to come up
+    uint32_t pendingQueueMessages = 0;
+    uint64_t pendingQueueBytes = 0;
+    uint64_t pendingQueueDropped = 0;
+
+    // GNS send rate floor and Nagle time in effect, as the LinkTuner left them
+    int32_t sendRateMin = 0;
+    int32_t nagleTimeUsec = 0;
+
     void Serialize(ByteWriter& bw) const
 	{
         bw.str(IdentityId);
@@ -42,6 +51,11 @@ struct ConnectionTelemetry
         bw.f32(qualityLocal);
         bw.f32(qualityRemote);
         bw.i32(state);
+        bw.u32(pendingQueueMessages);
+        bw.u64(pendingQueueBytes);
+        bw.u64(pendingQueueDropped);
+        bw.i32(sendRateMin);
+        bw.i32(nagleTimeUsec);
 	}
 	void Deserialize(ByteReader& br)
 	{
@@ -58,6 +72,11 @@ struct ConnectionTelemetry
         qualityLocal = br.f32();
         qualityRemote = br.f32();
         state = br.i32();
+        pendingQueueMessages = br.u32();
+        pendingQueueBytes = br.u64();
+        pendingQueueDropped = br.u64();
+        sendRateMin = br.i32();
+        nagleTimeUsec = br.i32();
 	}
 
         void DebugLogs() const
@@ -76,5 +95,10 @@ struct ConnectionTelemetry
                 std::cerr << "  qualityLocal: " << qualityLocal << std::endl;
                 std::cerr << "  qualityRemote: " << qualityRemote << std::endl;
                 std::cerr << "  state: " << state << std::endl;
+                std::cerr << "  pendingQueueMessages: " << pendingQueueMessages << std::endl;
+                std::cerr << "  pendingQueueBytes: " << pendingQueueBytes << std::endl;
+                std::cerr << "  pendingQueueDropped: " << pendingQueueDropped << std::endl;
+                std::cerr << "  sendRateMin: " << sendRateMin << std::endl;
+                std::cerr << "  nagleTimeUsec: " << nagleTimeUsec << std::endl;
         }
 };
\ No newline at end of file
@@ -0,0 +1,72 @@
+#include "LinkConfigProfile.hpp"
+
+#include <algorithm>
+
+bool LinkTuner::Due(std::chrono::steady_clock::time_point now)
+{
+	if (!Settings.Enabled || Links.empty() || now < NextSample)
+		return false;
+	NextSample = now + Settings.Interval;
+	return true;
+}
+
+void LinkTuner::Track(HSteamNetConnection conn, const LinkConfigProfile &profile)
+{
+	if (!Settings.Enabled || !profile.AutoTune)
+		return;
+	Links[conn] = Link{.Profile = profile,
+					   .Current = Adjustment{.SendRateMin = profile.SendRateMin,
+											 .NagleTimeUsec = profile.NagleTimeUsec}};
+}
+
+bool LinkTuner::Healthy(const Sample &sample) const
+{
+	// Unknown counts as unhealthy, nothing is raised before GNS has measured the path
+	return sample.PingMs >= 0 && sample.PingMs <= Settings.MaxPing.count() &&
+		   sample.QualityLocal >= 1.0f - Settings.MaxLoss &&
+		   sample.QualityRemote >= 1.0f - Settings.MaxLoss;
+}
+
+std::optional<LinkTuner::Adjustment> LinkTuner::Update(HSteamNetConnection conn,
+													   const Sample &sample)
+{
+	const auto it = Links.find(conn);
+	if (it == Links.end())
+		return std::nullopt;
+	Link &link = it->second;
+	const LinkConfigProfile &profile = link.Profile;
+	Adjustment next = link.Current;
+
+	const int64_t pending = (int64_t)sample.PendingReliableBytes + sample.PendingUnreliableBytes;
+	const bool backedUp = sample.QueueTimeUsec >= Settings.HighQueueTime.count() ||
+						  pending >= Settings.HighPendingBytes;
+	const bool growing = sample.QueueTimeUsec > link.QueueTimeUsec || pending > link.PendingBytes;
+	link.QueueTimeUsec = sample.QueueTimeUsec;
+	link.PendingBytes = pending;
+
+	if (!Healthy(sample))
+	{
+		// Loss or latency, the path is what is saturated
+		next = Adjustment{.SendRateMin = profile.SendRateMin,
+						  .NagleTimeUsec = profile.NagleTimeUsec};
+	}
+	else if (backedUp && growing)
+	{
+		next.SendRateMin = (int32_t)std::min<int64_t>(
+			profile.SendRateMax, (int64_t)(next.SendRateMin * Settings.RateGrowth));
+		next.NagleTimeUsec = 0;
+	}
+	else if (sample.QueueTimeUsec <= Settings.LowQueueTime.count() &&
+			 pending <= Settings.LowPendingBytes)
+	{
+		next.SendRateMin = std::max(profile.SendRateMin,
+									(int32_t)(next.SendRateMin * Settings.RateDecay));
+		next.NagleTimeUsec = profile.NagleTimeUsec;
+	}
+
+	if (next.SendRateMin == link.Current.SendRateMin &&
+		next.NagleTimeUsec == link.Current.NagleTimeUsec)
+		return std::nullopt;
+	link.Current = next;
+	return next;
+}
@@ -0,0 +1,146 @@
+#pragma once
+#include <steam/steamnetworkingtypes.h>
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+
+#include "Network/NetworkEnums.hpp"
+
+/// @brief GNS settings for one class of link, applied to each connection as it is made.
+struct LinkConfigProfile
+{
+	/// Bytes GNS holds for the connection before reliable sends start failing.
+	int32_t SendBufferSize = 512 * 1024;
+	/// Bounds of the GNS bandwidth estimate, bytes per second.
+	int32_t SendRateMin = 128 * 1024;
+	int32_t SendRateMax = 1024 * 1024;
+	/// How long batched sends wait for more data to share a packet with.
+	int32_t NagleTimeUsec = 5000;
+	/// 0 keeps the GNS default, which is also the most it accepts. Lower it for paths that add
+	/// tunnel overhead.
+	int32_t MTUPacketSize = 0;
+	/// Hand connections using this profile to the LinkTuner when it is enabled. Only datacenter
+	/// links opt in, anywhere else congestion is real and GNS is left to handle it.
+	bool AutoTune = false;
+};
+
+/**
+ * @brief LinkConfigProfile per peer NetworkIdentityType.
+ * @details Defaults to datacenter settings for every server type and internet settings for the
+ * rest, which covers game clients whichever identity they connect with.
+ */
+struct LinkConfigProfiles
+{
+	std::unordered_map<NetworkIdentityType, LinkConfigProfile> ByType = {
+		{NetworkIdentityType::eShard, Datacenter()},
+		{NetworkIdentityType::eProxy, Datacenter()},
+		{NetworkIdentityType::eWatchDog, Datacenter()},
+		{NetworkIdentityType::eCartograph, Datacenter()},
+	};
+	/// Anything ByType does not name.
+	LinkConfigProfile Fallback;
+
+	[[nodiscard]] const LinkConfigProfile &For(NetworkIdentityType type) const
+	{
+		const auto it = ByType.find(type);
+		return it == ByType.end() ? Fallback : it->second;
+	}
+
+	/// Plenty of bandwidth and sub millisecond round trips, handoff bursts should not wait on the
+	/// bandwidth estimate to ramp up.
+	static LinkConfigProfile Datacenter()
+	{
+		return LinkConfigProfile{.SendBufferSize = 16 * 1024 * 1024,
+								 .SendRateMin = 8 * 1024 * 1024,
+								 .SendRateMax = 256 * 1024 * 1024,
+								 .NagleTimeUsec = 500,
+								 .AutoTune = true};
+	}
+};
+
+struct LinkTunerSettings
+{
+	/// Off leaves every connection on its profile.
+	bool Enabled = false;
+	std::chrono::milliseconds Interval = std::chrono::milliseconds(250);
+	/// A link is backed up once data waits this long in GNS, or this much is waiting to go out.
+	std::chrono::microseconds HighQueueTime = std::chrono::milliseconds(20);
+	int32_t HighPendingBytes = 256 * 1024;
+	/// The path counts as healthy while the round trip and the share of packets lost, in either
+	/// direction, stay under these. Anything worse is congestion for GNS to handle.
+	std::chrono::milliseconds MaxPing = std::chrono::milliseconds(10);
+	float MaxLoss = 0.01f;
+	/// And settled again once both fall under these.
+	std::chrono::microseconds LowQueueTime = std::chrono::milliseconds(2);
+	int32_t LowPendingBytes = 16 * 1024;
+	/// Applied to the send rate floor per interval while congested, and on the way back down.
+	float RateGrowth = 1.5f;
+	float RateDecay = 0.8f;
+};
+
+/**
+ * @brief Moves a connection's send rate floor and Nagle time with its GNS queue.
+ * @details A queue that keeps growing on a path with low loss and round trip means the GNS
+ * bandwidth estimate is what holds the link back, so the floor is raised towards the profile's
+ * SendRateMax and Nagle turned off, full packets gain nothing from waiting. Once loss or round
+ * trip climb the path itself is saturated, the floor drops straight back to the profile and GNS
+ * congestion control is left to do its job. Once settled the floor decays back as well. Only
+ * decides, the caller reads the GNS status and applies the result. Owned by the Interlink tick
+ * thread.
+ */
+class LinkTuner
+{
+   public:
+	struct Sample
+	{
+		int64_t QueueTimeUsec = 0;
+		int32_t PendingReliableBytes = 0;
+		int32_t PendingUnreliableBytes = 0;
+		/// As GNS reports them, negative while not yet known.
+		int32_t PingMs = -1;
+		float QualityLocal = -1;
+		float QualityRemote = -1;
+	};
+	struct Adjustment
+	{
+		int32_t SendRateMin = 0;
+		int32_t NagleTimeUsec = 0;
+	};
+
+	void Configure(const LinkTunerSettings &settings) { Settings = settings; }
+	[[nodiscard]] bool Enabled() const { return Settings.Enabled; }
+	/// @brief True once per Interval, when the tracked connections should be sampled.
+	[[nodiscard]] bool Due(std::chrono::steady_clock::time_point now);
+
+	/// @brief Start tuning conn from profile, ignored when the profile opts out.
+	void Track(HSteamNetConnection conn, const LinkConfigProfile &profile);
+	void Forget(HSteamNetConnection conn) { Links.erase(conn); }
+	[[nodiscard]] bool IsTracked(HSteamNetConnection conn) const { return Links.contains(conn); }
+	/// @brief Settings last applied to conn, nullopt when it is not tracked.
+	[[nodiscard]] std::optional<Adjustment> Current(HSteamNetConnection conn) const
+	{
+		const auto it = Links.find(conn);
+		if (it == Links.end())
+			return std::nullopt;
+		return it->second.Current;
+	}
+
+	/// @return What to set on conn, or nullopt when nothing changes.
+	std::optional<Adjustment> Update(HSteamNetConnection conn, const Sample &sample);
+
+   private:
+	struct Link
+	{
+		LinkConfigProfile Profile;
+		Adjustment Current;
+		/// Queue as of the previous sample, to tell a growing queue from one draining.
+		int64_t QueueTimeUsec = 0;
+		int64_t PendingBytes = 0;
+	};
+	[[nodiscard]] bool Healthy(const Sample &sample) const;
+	LinkTunerSettings Settings;
+	std::chrono::steady_clock::time_point NextSample;
+	std::unordered_map<HSteamNetConnection, Link> Links;
+};
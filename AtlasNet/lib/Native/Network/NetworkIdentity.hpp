@@ -1,5 +1,6 @@
 #pragma once
 #include <cstdint>
+#include <cstring>
 #include <functional>
 #include <optional>
 #include <string>
@@ -33,15 +34,30 @@ struct NetworkIdentity
 	[[nodiscard]] static std::optional<InterLinkIdentifier> FromEncodedByteStream(
 		const std::byte* data, size_t size);*/
 
+	// Compare the type byte and the raw 16 UUID bytes. No formatting, no allocation.
 	bool operator==(const NetworkIdentity& other) const noexcept
-
 	{
-		return ToString() == other.ToString();
+		return Type == other.Type && ID == other.ID;
 	}
 	bool operator<(const NetworkIdentity& other) const noexcept
 	{
-		return ToString() < other.ToString();
+		if (Type != other.Type)
+			return Type < other.Type;
+		return ID < other.ID;
+	}
+	[[nodiscard]] size_t Hash() const noexcept
+	{
+		static_assert(sizeof(UUID) == 16, "NetworkIdentity::Hash expects a 16 byte UUID");
+		uint64_t lo, hi;
+		std::memcpy(&lo, &ID, sizeof(lo));
+		std::memcpy(&hi, reinterpret_cast<const uint8_t*>(&ID) + sizeof(lo), sizeof(hi));
+		// UUIDs are random already, just fold the halves and the type together
+		uint64_t h = lo ^ (hi * 0x9e3779b97f4a7c15ULL) ^ (static_cast<uint64_t>(Type) << 56);
+		h ^= h >> 32;
+		return static_cast<size_t>(h);
 	}
+	/// Picked up by boost::hash, used by the hashed multi_index connection tables.
+	friend size_t hash_value(const NetworkIdentity& id) noexcept { return id.Hash(); }
 	void Serialize(ByteWriter& bw) const
 	{
 		bw.write_scalar(Type);
@@ -59,17 +75,6 @@ namespace std
 template <>
 struct hash<NetworkIdentity>
 {
-    size_t operator()(const NetworkIdentity& key) const noexcept
-    {
-        size_t h1 = std::hash<int>{}(static_cast<int>(key.Type));
-
-        // treat the UUID as a contiguous byte array
-        size_t h2 = std::hash<std::string_view>{}(
-            std::string_view(reinterpret_cast<const char*>(key.ID.data()), key.ID.size())
-        );
-
-        // standard hash combine
-        return h1 ^ (h2 + 0x9e3779b97f4a7c15ULL + (h1 << 6) + (h1 >> 2));
-    }
+    size_t operator()(const NetworkIdentity& key) const noexcept { return key.Hash(); }
 };
 }
\ No newline at end of file
@@ -0,0 +1,93 @@
+#pragma once
+#include <steam/isteamnetworkingsockets.h>
+#include <steam/isteamnetworkingutils.h>
+#include <steam/steamnetworkingtypes.h>
+
+#include <atomic>
+#include <boost/smart_ptr/intrusive_ptr.hpp>
+#include <cstdint>
+#include <vector>
+
+#include "Global/Serialize/ByteWriter.hpp"
+
+struct OutboundBuffer;
+using OutboundBufferPtr = boost::intrusive_ptr<OutboundBuffer>;
+
+/**
+ * @brief Serialized packet bytes handed to GNS without copying.
+ * @details Messages built with MakeMessage point straight at Writer's storage instead of owning a
+ * copy. Every message and every OutboundBufferPtr holds a reference and GNS drops its reference
+ * through FreeData once the message is sent, so one buffer can back messages to any number of
+ * connections and be serialized on a different thread than the one sending it.
+ */
+struct OutboundBuffer
+{
+	ByteWriter Writer;
+	/// GNS lane the bytes go out on where the connection has lanes configured.
+	uint16_t Lane = 0;
+	/// End offsets of the messages Writer is cut into. Empty sends Writer as a single message.
+	std::vector<uint32_t> FrameEnds;
+
+	static OutboundBufferPtr Create() { return OutboundBufferPtr(new OutboundBuffer()); }
+
+	/// @brief Build a GNS message referencing this buffer. Ownership of the message passes to the
+	/// caller, who must either send it or Release() it.
+	/// @param useLane false for connections without lanes, which only accept lane 0.
+	ISteamNetworkingMessage *MakeMessage(HSteamNetConnection conn, int sendFlags,
+										 bool useLane = false)
+	{
+		return MakeFrame(0, (uint32_t)Writer.size(), conn, sendFlags, useLane);
+	}
+	/// @brief MakeMessage for every frame, appended to out in order.
+	void AppendMessages(std::vector<ISteamNetworkingMessage *> &out, HSteamNetConnection conn,
+						int sendFlags, bool useLane = false)
+	{
+		if (FrameEnds.empty())
+		{
+			out.push_back(MakeMessage(conn, sendFlags, useLane));
+			return;
+		}
+		uint32_t begin = 0;
+		for (uint32_t end : FrameEnds)
+		{
+			out.push_back(MakeFrame(begin, end, conn, sendFlags, useLane));
+			begin = end;
+		}
+	}
+
+   private:
+	OutboundBuffer() = default;
+	std::atomic<uint32_t> Refs{0};
+
+	ISteamNetworkingMessage *MakeFrame(uint32_t begin, uint32_t end, HSteamNetConnection conn,
+									   int sendFlags, bool useLane)
+	{
+		ISteamNetworkingMessage *msg = SteamNetworkingUtils()->AllocateMessage(0);
+		Refs.fetch_add(1, std::memory_order_relaxed);
+		msg->m_pData = const_cast<uint8_t *>(Writer.data()) + begin;
+		msg->m_cbSize = (int)(end - begin);
+		msg->m_conn = conn;
+		msg->m_nFlags = sendFlags;
+		msg->m_idxLane = useLane ? Lane : 0;
+		msg->m_nUserData = (int64)(intptr_t)this;
+		msg->m_pfnFreeData = &OutboundBuffer::FreeData;
+		return msg;
+	}
+
+	void Unref()
+	{
+		if (Refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			delete this;
+	}
+	/// Called by GNS, possibly from its own service thread.
+	static void FreeData(SteamNetworkingMessage_t *msg)
+	{
+		reinterpret_cast<OutboundBuffer *>((intptr_t)msg->m_nUserData)->Unref();
+	}
+
+	friend void intrusive_ptr_add_ref(OutboundBuffer *buffer)
+	{
+		buffer->Refs.fetch_add(1, std::memory_order_relaxed);
+	}
+	friend void intrusive_ptr_release(OutboundBuffer *buffer) { buffer->Unref(); }
+};
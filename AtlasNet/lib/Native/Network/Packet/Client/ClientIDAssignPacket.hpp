@@ -22,4 +22,3 @@ class ClientIDAssignPacket
    public:
 	NetworkIdentity AssignedClientID;
 };
-ATLASNET_REGISTER_PACKET(ClientIDAssignPacket,"ClientIDAssignPacket");
\ No newline at end of file
@@ -1,12 +1,15 @@
 #pragma once
 
 /// @brief Packet Types Internal to InterLink
+#include <array>
+#include <mutex>
+#include <variant>
+
 #include "Global/Misc/Singleton.hpp"
 #include "Global/Serialize/ByteReader.hpp"
 #include "Global/Serialize/ByteWriter.hpp"
 #include "Global/pch.hpp"
-
-using PacketTypeID = uint32_t;
+#include "PacketTypeList.hpp"
 
 class IPacket
 {
@@ -31,10 +34,99 @@ class IPacket
 	virtual void DeserializeData(ByteReader& br) = 0;
 	[[nodiscard]] virtual bool ValidateData() const = 0;
 };
+/// @brief Where the handlers of a packet type run.
+enum class PacketDispatchPolicy : uint8_t
+{
+	eNetworkThread,	 /// Inline on the network thread, the tick thread for an Interlink
+	eWorkerPool		 /// On a dispatch worker when one is running, in order per sender
+};
+BOOST_DESCRIBE_ENUM(PacketDispatchPolicy, eNetworkThread, eWorkerPool)
+
+/// @brief GNS lane a packet type is sent on over internal connections.
+enum class PacketLane : uint16_t
+{
+	eHandoff,  /// Entity and client transfer stages, never queued behind anything else
+	eDefault,
+	eBulk,	   /// Large responses and telemetry
+	eCount
+};
+BOOST_DESCRIBE_ENUM(PacketLane, eHandoff, eDefault, eBulk)
+
+/// @brief Scheduling of one lane, as passed to ConfigureConnectionLanes.
+struct PacketLaneSpec
+{
+	int Priority;	  /// Lower is served first, strictly
+	uint16_t Weight;  /// Share among lanes of equal priority
+};
+/// Default and bulk share a priority so bulk traffic is slowed down, never starved.
+inline constexpr std::array<PacketLaneSpec, (size_t)PacketLane::eCount> PacketLaneSpecs = {{
+	{.Priority = 0, .Weight = 1},  // eHandoff
+	{.Priority = 1, .Weight = 4},  // eDefault
+	{.Priority = 1, .Weight = 1},  // eBulk
+}};
+
+/// @brief Codec applied to a packet's serialized bytes on internal connections.
+enum class PacketCompression : uint8_t
+{
+	eNone,
+	eLZ4,  /// Cheap enough for latency sensitive packets
+	eZstd  /// Better ratio for bulk data, uses the type's trained dictionary when one is loaded
+};
+BOOST_DESCRIBE_ENUM(PacketCompression, eNone, eLZ4, eZstd)
+
+/// @brief Per type settings, declared as static members on the TPacket and recorded at
+/// registration.
+struct PacketTypeTraits
+{
+	std::string_view Name;
+	PacketDispatchPolicy Dispatch = PacketDispatchPolicy::eNetworkThread;
+	PacketLane Lane = PacketLane::eDefault;
+	PacketCompression Compression = PacketCompression::eNone;
+	/// Serialized packets at or below this size are sent as is.
+	uint32_t CompressionThreshold = 1024;
+};
+
+/// @brief Deleter that hands a pooled packet back to the pool it was taken from.
+struct PacketPoolReturn
+{
+	void (*Recycle)(IPacket*, void*) = nullptr;
+	/// The thread's pool it came from, opaque to everyone but the packet type.
+	void* Pool = nullptr;
+	void operator()(IPacket* packet) const
+	{
+		if (Recycle)
+			Recycle(packet, Pool);
+		else
+			delete packet;
+	}
+};
+/// @brief Packet on loan from its type's pool. Returned to the pool when it goes out of scope.
+using PooledPacket = std::unique_ptr<IPacket, PacketPoolReturn>;
+
+/// @brief Alternative T of a pooled packet's variant, ready to decode into. Kept as is when v
+/// already holds it, so storage grown by earlier packets is reused; the decoder overwrites it.
+template <typename T, typename... Ts>
+T& ReuseAlternative(std::variant<Ts...>& v)
+{
+	if (T* current = std::get_if<T>(&v))
+		return *current;
+	return v.template emplace<T>();
+}
+
+/**
+ * @brief Packet types this process can decode, each with a dense index.
+ * @details The built in types come from the compile time list in PacketTypes.hpp and are present
+ * as soon as the registry exists, whatever order static initializers run in. Types defined outside
+ * the library are appended by ATLASNET_REGISTER_PACKET, before any Interlink starts. Lookups by
+ * index are plain array reads, so per type tables elsewhere are vectors indexed by IndexOf.
+ */
 class PacketRegistry : public Singleton<PacketRegistry>
 {
 public:
     using FactoryFn = std::unique_ptr<IPacket>(*)();
+    using AcquireFn = PooledPacket(*)();
+
+    PacketRegistry();
 
     static PacketRegistry& Instance()
     {
@@ -42,34 +134,53 @@ public:
         return instance;
     }
 
-    bool Register(PacketTypeID type, FactoryFn fn)
+    /// @return false when the type is already known. A different type whose name hashes to the
+    /// same ID asserts.
+    bool Register(PacketTypeID type, FactoryFn fn, AcquireFn acquire = nullptr,
+                  PacketTypeTraits traits = {});
+
+    /// @return the dense index of type, or InvalidPacketIndex when it is not registered
+    [[nodiscard]] uint32_t IndexOf(PacketTypeID type) const { return PacketIndexFind(Slots, type); }
+    [[nodiscard]] size_t GetTypeCount() const { return Entries.size(); }
+    [[nodiscard]] PacketTypeID GetTypeAt(uint32_t index) const { return Entries[index].Type; }
+
+    [[nodiscard]] const PacketTypeTraits* GetTraits(PacketTypeID type) const
+    {
+        const uint32_t index = IndexOf(type);
+        return index == InvalidPacketIndex ? nullptr : &Entries[index].Traits;
+    }
+    [[nodiscard]] const PacketTypeTraits& GetTraitsAt(uint32_t index) const
+    {
+        return Entries[index].Traits;
+    }
+    /// @brief Calls fn(type, traits) for every type, in index order.
+    template <typename Fn>
+    void ForEachType(Fn&& fn) const
     {
-        return factories.emplace(type, fn).second;
+        for (const Entry& entry : Entries)
+            fn(entry.Type, entry.Traits);
     }
 
     std::unique_ptr<IPacket> Create(PacketTypeID type) const
     {
-        auto it = factories.find(type);
-        if (it == factories.end())
+        const uint32_t index = IndexOf(type);
+        if (index == InvalidPacketIndex)
 		{
 			ASSERT(false, "Packet Type not registered?");
             return nullptr;
 
 		}
-        return it->second();
+        return Entries[index].Factory();
     }
 
     std::unique_ptr<IPacket> CreateFromBytes(std::span<const uint8_t> bytes) const
     {
-        ByteReader br(bytes);
-
-        PacketTypeID type = br.read_scalar<PacketTypeID>();
-        ByteReader br2(bytes);
-        auto pkt = Create(type);
+        auto pkt = Create(PeekPacketType(bytes));
         if (!pkt)
             return nullptr;
 
-        pkt->Deserialize(br2);
+        ByteReader br(bytes);
+        pkt->Deserialize(br);
 
         if (!pkt->Validate())
 		{
@@ -81,8 +192,50 @@ public:
         return pkt;
     }
 
+    /// @brief Decode into a recycled instance of the packet type instead of a fresh allocation.
+    /// @details Meant for the receive path where the packet only lives until dispatch returns.
+    /// Instances are reused as is, so DeserializeData must overwrite every field it reads.
+    PooledPacket AcquireFromBytes(std::span<const uint8_t> bytes) const
+    {
+        const uint32_t index = IndexOf(PeekPacketType(bytes));
+        if (index == InvalidPacketIndex)
+		{
+			ASSERT(false, "Packet Type not registered?");
+            return nullptr;
+		}
+        const Entry& entry = Entries[index];
+        PooledPacket pkt =
+            entry.Acquire ? entry.Acquire() : PooledPacket(entry.Factory().release());
+
+        ByteReader br(bytes);
+        pkt->Deserialize(br);
+
+        if (!pkt->Validate())
+		{
+			ASSERT(false,"Message From bytes failed to validate");
+            return nullptr;
+		}
+
+        return pkt;
+    }
+
+    static PacketTypeID PeekPacketType(std::span<const uint8_t> bytes)
+    {
+        ByteReader br(bytes);
+        return br.read_scalar<PacketTypeID>();
+    }
+
 private:
-    std::unordered_map<PacketTypeID, FactoryFn> factories;
+    struct Entry
+    {
+        PacketTypeID Type = 0;
+        FactoryFn Factory = nullptr;
+        AcquireFn Acquire = nullptr;
+        PacketTypeTraits Traits;
+    };
+    std::vector<Entry> Entries;
+    /// Open addressed PacketTypeID to index, a power of two in size and at most half full.
+    std::vector<PacketIndexSlot> Slots;
 };
 template <size_t N>
 struct FixedString
@@ -111,6 +264,13 @@ class TPacket : public IPacket
     public:
     static constexpr PacketTypeID TypeID =
         HashString(Name.value);
+    /// Shadow in the derived packet to change where its handlers run.
+    static constexpr PacketDispatchPolicy DispatchPolicy = PacketDispatchPolicy::eNetworkThread;
+    /// Shadow in the derived packet to send it on another lane.
+    static constexpr PacketLane Lane = PacketLane::eDefault;
+    /// Shadow in the derived packet to compress it once it serializes past the threshold.
+    static constexpr PacketCompression Compression = PacketCompression::eNone;
+    static constexpr uint32_t CompressionThreshold = 1024;
 protected:
 
 
@@ -121,6 +281,27 @@ public:
     {
         return std::make_unique<Derived>();
     }
+    /// @brief Max idle instances kept per thread, and max handed back to it by other threads.
+    /// Anything past that is freed on release.
+    static constexpr size_t PoolCapacity = 64;
+    /// @brief Take an instance from this thread's pool, allocating only when the pool is empty.
+    /// @details The instance goes back to this pool whichever thread releases it, so a packet
+    /// handled on a dispatch worker is reused by the thread that received it.
+    static PooledPacket Acquire()
+    {
+        Pool& pool = LocalPool();
+        if (pool.Free.empty())
+        {
+            // Both keep their reserved capacity, swapping never allocates
+            std::lock_guard lock(pool.ReturnedMutex);
+            pool.Free.swap(pool.Returned);
+        }
+        if (pool.Free.empty())
+            return PooledPacket(new Derived(), PacketPoolReturn{&Recycle, &pool});
+        IPacket* packet = pool.Free.back();
+        pool.Free.pop_back();
+        return PooledPacket(packet, PacketPoolReturn{&Recycle, &pool});
+    }
     const std::string_view GetPacketName() const override 
     {
         return Name.value;
@@ -129,11 +310,108 @@ public:
     {
         return Name.value;
     }
+    /// Reads the derived packet's trait members, so only call once Derived is complete.
+    static constexpr PacketTypeTraits Traits()
+    {
+        return PacketTypeTraits{.Name = Name.value,
+                                .Dispatch = Derived::DispatchPolicy,
+                                .Lane = Derived::Lane,
+                                .Compression = Derived::Compression,
+                                .CompressionThreshold = Derived::CompressionThreshold};
+    }
+
+private:
+    struct Pool
+    {
+        /// Owning thread only.
+        std::vector<Derived*> Free;
+        /// Released on other threads, taken over once Free runs dry.
+        std::mutex ReturnedMutex;
+        std::vector<Derived*> Returned;
+        Pool()
+        {
+            Free.reserve(PoolCapacity);
+            Returned.reserve(PoolCapacity);
+        }
+        ~Pool()
+        {
+            for (Derived* packet : Free)
+                delete packet;
+            for (Derived* packet : Returned)
+                delete packet;
+        }
+    };
+    /// Every pool of the type. A pool outlives its thread and is handed to the next thread that
+    /// acquires, so packets still on loan always have a pool to go back to.
+    struct PoolList
+    {
+        std::mutex Mutex;
+        std::vector<std::unique_ptr<Pool>> All;
+        std::vector<Pool*> Unowned;
+    };
+    static PoolList& Pools()
+    {
+        static PoolList list;
+        return list;
+    }
+    static inline thread_local Pool* CurrentPool = nullptr;
+    static Pool& LocalPool()
+    {
+        struct Owner
+        {
+            Pool* Owned = nullptr;
+            Owner()
+            {
+                PoolList& list = Pools();
+                std::lock_guard lock(list.Mutex);
+                if (!list.Unowned.empty())
+                {
+                    Owned = list.Unowned.back();
+                    list.Unowned.pop_back();
+                }
+                else
+                    Owned = list.All.emplace_back(std::make_unique<Pool>()).get();
+                CurrentPool = Owned;
+            }
+            ~Owner()
+            {
+                CurrentPool = nullptr;
+                PoolList& list = Pools();
+                std::lock_guard lock(list.Mutex);
+                list.Unowned.push_back(Owned);
+            }
+        };
+        thread_local Owner owner;
+        return *owner.Owned;
+    }
+    static void Recycle(IPacket* packet, void* owner)
+    {
+        Pool& pool = *static_cast<Pool*>(owner);
+        if (&pool == CurrentPool)
+        {
+            if (pool.Free.size() < PoolCapacity)
+                pool.Free.push_back(static_cast<Derived*>(packet));
+            else
+                delete packet;
+            return;
+        }
+        {
+            std::lock_guard lock(pool.ReturnedMutex);
+            if (pool.Returned.size() < PoolCapacity)
+            {
+                pool.Returned.push_back(static_cast<Derived*>(packet));
+                return;
+            }
+        }
+        delete packet;
+    }
 };
 
+/// @brief Register a packet type defined outside the library. Types of the library itself are
+/// listed in PacketTypes.hpp instead.
 #define ATLASNET_REGISTER_PACKET(Type, Name)                     \
     static const bool Type##_registered = []() -> bool {         \
         PacketRegistry::Get().Register(HashString(Type::GetPacketNameStatic().data()),         \
-                                       &Type::Create);           \
+                                       &Type::Create, &Type::Acquire, Type::Traits()); \
         return true;                                             \
     }()
\ No newline at end of file
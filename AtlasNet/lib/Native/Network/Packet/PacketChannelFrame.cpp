@@ -0,0 +1,12 @@
+#include "PacketChannelFrame.hpp"
+
+void PacketChannelFrame::Begin(ByteWriter& bw)
+{
+	bw.write_scalar<PacketTypeID>(TypeID);
+}
+
+void PacketChannelFrame::Append(ByteWriter& bw, ChannelID channel, std::span<const uint8_t> bytes)
+{
+	bw.u16(channel);
+	bw.blob(bytes);
+}
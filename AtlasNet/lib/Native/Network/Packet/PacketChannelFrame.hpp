@@ -0,0 +1,51 @@
+#pragma once
+#include <cstdint>
+#include <span>
+
+#include "Global/Serialize/ByteReader.hpp"
+#include "Global/Serialize/ByteWriter.hpp"
+#include "Packet.hpp"
+
+/// Names a client on one proxy↔shard link. 0 is never handed out.
+using ChannelID = uint16_t;
+inline constexpr ChannelID InvalidChannelID = 0;
+
+/**
+ * @brief Messages of many clients coalesced into a single message on a proxy↔shard link.
+ * @details Laid out as [TypeID] followed by [Channel][blob] per message up to the end. A blob is
+ * a client packet exactly as the client sent it or will receive it, never decoded on the way.
+ * TypeID takes the place of a packet type so receivers tell frames apart with
+ * PacketRegistry::PeekPacketType.
+ */
+struct PacketChannelFrame
+{
+	static constexpr PacketTypeID TypeID = HashString("PacketChannelFrame");
+	static constexpr size_t HeaderSize = sizeof(PacketTypeID);
+
+	/// @brief Start a frame in an empty writer.
+	static void Begin(ByteWriter& bw);
+	static void Append(ByteWriter& bw, ChannelID channel, std::span<const uint8_t> bytes);
+
+	/// @brief Call fn(channel, bytes) for every message in order, bytes point into frame.
+	/// @return false when the frame is malformed. Messages before the damage were still passed on.
+	template <typename Fn>
+	static bool ForEach(std::span<const uint8_t> frame, Fn&& fn)
+	{
+		try
+		{
+			ByteReader br(frame);
+			if (br.read_scalar<PacketTypeID>() != TypeID)
+				return false;
+			while (br.remaining() > 0)
+			{
+				const ChannelID channel = br.u16();
+				fn(channel, br.blob());
+			}
+			return true;
+		}
+		catch (const std::exception&)
+		{
+			return false;
+		}
+	}
+};
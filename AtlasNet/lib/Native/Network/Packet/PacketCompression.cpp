@@ -0,0 +1,240 @@
+#include "PacketCompression.hpp"
+
+#include <lz4.h>
+#include <zdict.h>
+#include <zstd.h>
+
+#include <chrono>
+#include <fstream>
+#include <iterator>
+
+#include "Global/Serialize/ByteReader.hpp"
+#include "PacketMetrics.hpp"
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+uint64_t NanosSince(Clock::time_point start)
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+}
+
+/// Compression contexts are reused per thread since any thread can send.
+ZSTD_CCtx* ThreadCompressContext()
+{
+	struct Owner
+	{
+		ZSTD_CCtx* Context = ZSTD_createCCtx();
+		~Owner() { ZSTD_freeCCtx(Context); }
+	};
+	thread_local Owner owner;
+	return owner.Context;
+}
+std::vector<uint8_t>& ThreadCompressScratch()
+{
+	thread_local std::vector<uint8_t> scratch;
+	return scratch;
+}
+}  // namespace
+
+void PacketCompressedHeader::Serialize(ByteWriter& bw) const
+{
+	bw.write_scalar<PacketTypeID>(TypeID);
+	bw.write_scalar(Codec);
+	bw.u32(RawSize);
+}
+
+std::optional<PacketCompressedHeader> PacketCompressedHeader::Read(std::span<const uint8_t> bytes)
+{
+	if (bytes.size() < Size)
+		return std::nullopt;
+	ByteReader br(bytes);
+	if (br.read_scalar<PacketTypeID>() != TypeID)
+		return std::nullopt;
+	PacketCompressedHeader header;
+	header.Codec = br.read_scalar<PacketCompression>();
+	header.RawSize = br.u32();
+	return header;
+}
+
+PacketCompressor::PacketCompressor() : DecompressContext(ZSTD_createDCtx())
+{
+	Registry.ForEachType(
+		[this](PacketTypeID, const PacketTypeTraits& traits)
+		{ Codecs.push_back(traits.Compression); });
+}
+
+PacketCompressor::~PacketCompressor()
+{
+	for (auto& [type, dictionary] : Dictionaries)
+	{
+		ZSTD_freeCDict(dictionary.Compress);
+		ZSTD_freeDDict(dictionary.Decompress);
+	}
+	ZSTD_freeDCtx(DecompressContext);
+}
+
+void PacketCompressor::LoadDictionaries(const std::filesystem::path& dir)
+{
+	Registry.ForEachType(
+		[&](PacketTypeID type, const PacketTypeTraits& traits)
+		{
+			if (traits.Compression != PacketCompression::eZstd)
+				return;
+			const std::filesystem::path file = dir / (std::string(traits.Name) + ".zdict");
+			std::ifstream in(file, std::ios::binary);
+			if (!in)
+				return;
+			const std::vector<uint8_t> dictionary((std::istreambuf_iterator<char>(in)),
+												  std::istreambuf_iterator<char>());
+			if (LoadDictionary(type, dictionary))
+				logger.DebugFormatted("Loaded {} byte dictionary for {}", dictionary.size(),
+									  traits.Name);
+		});
+}
+
+bool PacketCompressor::LoadDictionary(PacketTypeID type, std::span<const uint8_t> dictionary)
+{
+	const uint32_t id = ZDICT_getDictID(dictionary.data(), dictionary.size());
+	if (id == 0)
+	{
+		logger.ErrorFormatted("Dictionary for packet type {} is not a zstd dictionary", type);
+		return false;
+	}
+	if (auto existing = Dictionaries.find(type); existing != Dictionaries.end())
+	{
+		DictionariesByID.erase(ZSTD_getDictID_fromDDict(existing->second.Decompress));
+		ZSTD_freeCDict(existing->second.Compress);
+		ZSTD_freeDDict(existing->second.Decompress);
+		Dictionaries.erase(existing);
+	}
+	Dictionary& loaded = Dictionaries[type];
+	loaded.Compress = ZSTD_createCDict(dictionary.data(), dictionary.size(), ZstdLevel);
+	loaded.Decompress = ZSTD_createDDict(dictionary.data(), dictionary.size());
+	DictionariesByID[id] = loaded.Decompress;
+	return true;
+}
+
+std::vector<uint8_t> PacketCompressor::TrainDictionary(
+	std::span<const std::vector<uint8_t>> samples, size_t capacity)
+{
+	std::vector<uint8_t> joined;
+	std::vector<size_t> sizes;
+	sizes.reserve(samples.size());
+	for (const auto& sample : samples)
+	{
+		joined.insert(joined.end(), sample.begin(), sample.end());
+		sizes.push_back(sample.size());
+	}
+	std::vector<uint8_t> dictionary(capacity);
+	const size_t size = ZDICT_trainFromBuffer(dictionary.data(), dictionary.size(), joined.data(),
+											  sizes.data(), (unsigned)sizes.size());
+	if (ZDICT_isError(size))
+		return {};
+	dictionary.resize(size);
+	return dictionary;
+}
+
+void PacketCompressor::Compress(PacketTypeID type, OutboundBufferPtr& buffer)
+{
+	const uint32_t index = Registry.IndexOf(type);
+	if (index >= Codecs.size() || Codecs[index] == PacketCompression::eNone)
+		return;
+	const PacketCompression codec = Codecs[index];
+	const std::span<const uint8_t> raw = buffer->Writer.bytes();
+	if (raw.size() <= Registry.GetTraitsAt(index).CompressionThreshold)
+		return;
+
+	const auto start = Clock::now();
+	std::vector<uint8_t>& scratch = ThreadCompressScratch();
+	size_t compressedSize = 0;
+	if (codec == PacketCompression::eLZ4)
+	{
+		scratch.resize(LZ4_compressBound((int)raw.size()));
+		const int written = LZ4_compress_default((const char*)raw.data(), (char*)scratch.data(),
+												 (int)raw.size(), (int)scratch.size());
+		compressedSize = written > 0 ? (size_t)written : 0;
+	}
+	else
+	{
+		scratch.resize(ZSTD_compressBound(raw.size()));
+		auto dictionary = Dictionaries.find(type);
+		const size_t written =
+			dictionary != Dictionaries.end()
+				? ZSTD_compress_usingCDict(ThreadCompressContext(), scratch.data(), scratch.size(),
+										   raw.data(), raw.size(), dictionary->second.Compress)
+				: ZSTD_compressCCtx(ThreadCompressContext(), scratch.data(), scratch.size(),
+									raw.data(), raw.size(), ZstdLevel);
+		compressedSize = ZSTD_isError(written) ? 0 : written;
+	}
+	const uint64_t compressNs = NanosSince(start);
+
+	const size_t wireSize = PacketCompressedHeader::Size + compressedSize;
+	if (compressedSize == 0 || wireSize >= raw.size())
+	{
+		PacketMetrics::RecordCompress(type, raw.size(), raw.size(), compressNs);
+		return;
+	}
+	PacketMetrics::RecordCompress(type, raw.size(), wireSize, compressNs);
+
+	OutboundBufferPtr compressed = OutboundBuffer::Create();
+	compressed->Lane = buffer->Lane;
+	compressed->Writer = ByteWriter(wireSize);
+	PacketCompressedHeader{.Codec = codec, .RawSize = (uint32_t)raw.size()}.Serialize(
+		compressed->Writer);
+	compressed->Writer.write(scratch.data(), compressedSize);
+	buffer = std::move(compressed);
+}
+
+PooledPacket PacketCompressor::Decode(std::span<const uint8_t> bytes)
+{
+	if (PacketRegistry::PeekPacketType(bytes) != PacketCompressedHeader::TypeID)
+		return Registry.AcquireFromBytes(bytes);
+
+	const auto header = PacketCompressedHeader::Read(bytes);
+	if (!header || header->RawSize > MaxRawBytes || header->RawSize < sizeof(PacketTypeID))
+	{
+		logger.ErrorFormatted("Rejecting compressed packet of {} bytes", bytes.size());
+		return nullptr;
+	}
+	const std::span<const uint8_t> payload = bytes.subspan(PacketCompressedHeader::Size);
+
+	const auto start = Clock::now();
+	Scratch.resize(header->RawSize);
+	bool ok = false;
+	if (header->Codec == PacketCompression::eLZ4)
+	{
+		const int read = LZ4_decompress_safe((const char*)payload.data(), (char*)Scratch.data(),
+											 (int)payload.size(), (int)Scratch.size());
+		ok = read == (int)header->RawSize;
+	}
+	else if (header->Codec == PacketCompression::eZstd)
+	{
+		const uint32_t dictionaryID = ZSTD_getDictID_fromFrame(payload.data(), payload.size());
+		auto dictionary = DictionariesByID.find(dictionaryID);
+		size_t read;
+		if (dictionaryID == 0)
+			read = ZSTD_decompressDCtx(DecompressContext, Scratch.data(), Scratch.size(),
+									   payload.data(), payload.size());
+		else if (dictionary != DictionariesByID.end())
+			read = ZSTD_decompress_usingDDict(DecompressContext, Scratch.data(), Scratch.size(),
+											  payload.data(), payload.size(), dictionary->second);
+		else
+		{
+			logger.ErrorFormatted("No dictionary loaded with ID {}", dictionaryID);
+			return nullptr;
+		}
+		ok = !ZSTD_isError(read) && read == header->RawSize;
+	}
+	if (!ok)
+	{
+		logger.ErrorFormatted("Failed to decompress {} packet of {} bytes",
+							  boost::describe::enum_to_string(header->Codec, "unknown"),
+							  bytes.size());
+		return nullptr;
+	}
+
+	const std::span<const uint8_t> raw(Scratch.data(), header->RawSize);
+	PacketMetrics::RecordDecompress(PacketRegistry::PeekPacketType(raw), NanosSince(start));
+	return Registry.AcquireFromBytes(raw);
+}
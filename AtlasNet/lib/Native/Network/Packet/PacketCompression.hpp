@@ -0,0 +1,81 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "Debug/Log.hpp"
+#include "Network/OutboundBuffer.hpp"
+#include "Packet.hpp"
+
+struct ZSTD_CDict_s;
+struct ZSTD_DDict_s;
+struct ZSTD_DCtx_s;
+
+/**
+ * @brief Header in front of a compressed packet, laid out as [TypeID][Codec][RawSize][bytes].
+ * @details Like stream chunks, TypeID stands in for a packet type. The real type is the first
+ * thing in the decompressed bytes.
+ */
+struct PacketCompressedHeader
+{
+	static constexpr PacketTypeID TypeID = HashString("PacketCompressed");
+	static constexpr size_t Size = sizeof(PacketTypeID) + sizeof(uint8_t) + sizeof(uint32_t);
+
+	PacketCompression Codec = PacketCompression::eNone;
+	uint32_t RawSize = 0;
+
+	void Serialize(ByteWriter& bw) const;
+	static std::optional<PacketCompressedHeader> Read(std::span<const uint8_t> bytes);
+};
+
+/**
+ * @brief Compresses outbound packet bytes per their type's PacketCompression trait and decodes
+ * compressed frames on the way in.
+ * @details Compress may be called from any thread. Dictionaries must be loaded before packets
+ * are sent, after that they are only read. Decode keeps a reusable scratch buffer and belongs to
+ * the receiving thread. Ratios and timings are recorded per type into PacketMetrics.
+ */
+class PacketCompressor
+{
+   public:
+	static constexpr int ZstdLevel = 3;
+	/// Compressed frames announcing more than this are rejected before anything is allocated.
+	size_t MaxRawBytes = 64 * 1024 * 1024;
+
+	PacketCompressor();
+	~PacketCompressor();
+	PacketCompressor(const PacketCompressor&) = delete;
+	PacketCompressor& operator=(const PacketCompressor&) = delete;
+
+	/// @brief Load <dir>/<PacketName>.zdict for every eZstd packet type that has one.
+	void LoadDictionaries(const std::filesystem::path& dir);
+	bool LoadDictionary(PacketTypeID type, std::span<const uint8_t> dictionary);
+	/// @brief Train a zstd dictionary from serialized packets of one type, for LoadDictionary.
+	static std::vector<uint8_t> TrainDictionary(std::span<const std::vector<uint8_t>> samples,
+												size_t capacity = 16 * 1024);
+
+	/// @brief Replace buffer with a compressed frame when its type asks for it and it pays off.
+	void Compress(PacketTypeID type, OutboundBufferPtr& buffer);
+	/// @brief Decode a packet, decompressing it first if it arrived as a compressed frame.
+	PooledPacket Decode(std::span<const uint8_t> bytes);
+
+   private:
+	struct Dictionary
+	{
+		ZSTD_CDict_s* Compress = nullptr;
+		ZSTD_DDict_s* Decompress = nullptr;
+	};
+
+	const PacketRegistry& Registry = PacketRegistry::Get();
+	/// By dense registry index, built up front and never modified.
+	std::vector<PacketCompression> Codecs;
+	std::unordered_map<PacketTypeID, Dictionary> Dictionaries;
+	/// Decompression dictionaries by the ID zstd writes into every frame.
+	std::unordered_map<uint32_t, ZSTD_DDict_s*> DictionariesByID;
+	ZSTD_DCtx_s* DecompressContext = nullptr;
+	std::vector<uint8_t> Scratch;
+	Log logger = Log("PacketCompression");
+};
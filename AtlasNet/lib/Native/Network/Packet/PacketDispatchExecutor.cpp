@@ -0,0 +1,124 @@
+#include "PacketDispatchExecutor.hpp"
+
+PacketDispatchExecutor::PacketDispatchExecutor(PacketManager& manager) : Manager(manager)
+{
+	Registry.ForEachType(
+		[this](PacketTypeID, const PacketTypeTraits& traits)
+		{
+			auto stats = std::make_unique<PacketDispatchStats>();
+			stats->Name = traits.Name;
+			stats->Policy = traits.Dispatch;
+			Stats.push_back(std::move(stats));
+		});
+}
+
+PacketDispatchExecutor::~PacketDispatchExecutor()
+{
+	Stop();
+}
+
+void PacketDispatchExecutor::Start(uint32_t workers)
+{
+	ASSERT(Lanes.empty(), "PacketDispatchExecutor already started");
+	for (uint32_t i = 0; i < workers; i++)
+	{
+		Lanes.push_back(std::make_unique<Lane>());
+	}
+	for (auto& lane : Lanes)
+	{
+		lane->Thread =
+			std::jthread([this, l = lane.get()](std::stop_token st) { LaneEntry(*l, st); });
+	}
+	logger.DebugFormatted("Started {} dispatch lanes", workers);
+}
+
+void PacketDispatchExecutor::Stop()
+{
+	for (auto& lane : Lanes)
+	{
+		lane->Thread.request_stop();
+		{
+			std::lock_guard lock(lane->Mutex);
+		}
+		lane->CV.notify_all();
+	}
+	for (auto& lane : Lanes)
+	{
+		if (lane->Thread.joinable())
+			lane->Thread.join();
+		DrainLane(*lane);
+	}
+	Lanes.clear();
+}
+
+const PacketDispatchStats* PacketDispatchExecutor::GetStats(PacketTypeID type) const
+{
+	const uint32_t index = Registry.IndexOf(type);
+	return index < Stats.size() ? Stats[index].get() : nullptr;
+}
+
+void PacketDispatchExecutor::Dispatch(PooledPacket packet, const PacketManager::PacketInfo& info)
+{
+	const uint32_t index = Registry.IndexOf(packet->GetPacketType());
+	PacketDispatchStats* stats = index < Stats.size() ? Stats[index].get() : nullptr;
+
+	if (Lanes.empty() || !stats || stats->Policy != PacketDispatchPolicy::eWorkerPool)
+	{
+		RunHandlers(*packet, info, stats);
+		return;
+	}
+
+	Lane& lane = *Lanes[info.sender.Hash() % Lanes.size()];
+	stats->QueueDepth.fetch_add(1, std::memory_order_relaxed);
+	lane.Queue.Push(Task{.Packet = std::move(packet),
+						 .Info = info,
+						 .Queued = std::chrono::steady_clock::now(),
+						 .Stats = stats});
+
+	// Pairs with the fence in LaneEntry: either the worker sees the task or we see it idle
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (lane.Idle.load(std::memory_order_relaxed))
+	{
+		{
+			std::lock_guard lock(lane.Mutex);
+		}
+		lane.CV.notify_one();
+	}
+}
+
+void PacketDispatchExecutor::RunHandlers(const IPacket& packet,
+										 const PacketManager::PacketInfo& info,
+										 PacketDispatchStats* stats)
+{
+	Manager.Dispatch(packet, packet.GetPacketType(), info);
+	if (stats)
+		stats->Dispatched.fetch_add(1, std::memory_order_relaxed);
+}
+
+void PacketDispatchExecutor::DrainLane(Lane& lane)
+{
+	while (auto task = lane.Queue.Pop())
+	{
+		task->Stats->QueueDepth.fetch_sub(1, std::memory_order_relaxed);
+		task->Stats->QueueWaitUsec.Record(std::chrono::duration_cast<std::chrono::microseconds>(
+											  std::chrono::steady_clock::now() - task->Queued)
+											  .count());
+		RunHandlers(*task->Packet, task->Info, task->Stats);
+	}
+}
+
+void PacketDispatchExecutor::LaneEntry(Lane& lane, std::stop_token st)
+{
+	while (!st.stop_requested())
+	{
+		DrainLane(lane);
+
+		lane.Idle.store(true, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		{
+			std::unique_lock lock(lane.Mutex);
+			lane.CV.wait(lock, st, [&lane] { return !lane.Queue.Empty(); });
+		}
+		lane.Idle.store(false, std::memory_order_relaxed);
+	}
+}
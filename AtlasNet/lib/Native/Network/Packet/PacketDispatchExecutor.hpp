@@ -0,0 +1,90 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+#include "Debug/Log.hpp"
+#include "Global/Misc/LatencyHistogram.hpp"
+#include "Global/Misc/MPSCQueue.hpp"
+#include "Packet.hpp"
+#include "PacketManager.hpp"
+
+/// @brief Dispatch counters for one packet type. Handler time is tracked by PacketMetrics.
+struct PacketDispatchStats
+{
+	std::string_view Name;
+	PacketDispatchPolicy Policy = PacketDispatchPolicy::eNetworkThread;
+	std::atomic<uint64_t> Dispatched{0};
+	/// Packets handed to a worker lane whose handlers have not run yet.
+	std::atomic<int64_t> QueueDepth{0};
+	LatencyHistogram QueueWaitUsec;
+};
+
+/**
+ * @brief Runs packet handlers either inline or on a pool of worker lanes.
+ * @details Packet types whose PacketDispatchPolicy is eWorkerPool are handed to the lane picked by
+ * hashing the sender, so packets from one sender are handled in the order they arrived while
+ * different senders proceed in parallel. Everything else, and everything while no workers are
+ * running, is dispatched inline. Ordering between a pinned and a pooled type from the same sender
+ * is not preserved. Handing a packet to a lane costs one allocation, the MPSCQueue node, while the
+ * packet itself goes back to the receiving thread's pool (see PacketPoolAllocCheck).
+ */
+class PacketDispatchExecutor
+{
+   public:
+	explicit PacketDispatchExecutor(PacketManager& manager);
+	~PacketDispatchExecutor();
+	PacketDispatchExecutor(const PacketDispatchExecutor&) = delete;
+	PacketDispatchExecutor& operator=(const PacketDispatchExecutor&) = delete;
+
+	void Start(uint32_t workers);
+	/// @brief Runs whatever is still queued, then joins the workers.
+	void Stop();
+	[[nodiscard]] bool IsRunning() const { return !Lanes.empty(); }
+
+	/// @brief Called by the threads receiving packets. Each sender's packets must all come in on
+	/// the same one of them for their order to hold.
+	void Dispatch(PooledPacket packet, const PacketManager::PacketInfo& info);
+
+	[[nodiscard]] const PacketDispatchStats* GetStats(PacketTypeID type) const;
+	template <typename Fn>
+	void ForEachStats(Fn&& fn) const
+	{
+		for (uint32_t index = 0; index < Stats.size(); index++)
+			fn(Registry.GetTypeAt(index), *Stats[index]);
+	}
+
+   private:
+	struct Task
+	{
+		PooledPacket Packet;
+		PacketManager::PacketInfo Info;
+		std::chrono::steady_clock::time_point Queued;
+		PacketDispatchStats* Stats = nullptr;
+	};
+	struct Lane
+	{
+		MPSCQueue<Task> Queue;
+		std::atomic_bool Idle = false;
+		std::mutex Mutex;
+		std::condition_variable_any CV;
+		std::jthread Thread;
+	};
+
+	void RunHandlers(const IPacket& packet, const PacketManager::PacketInfo& info,
+					 PacketDispatchStats* stats);
+	void LaneEntry(Lane& lane, std::stop_token st);
+	void DrainLane(Lane& lane);
+
+	PacketManager& Manager;
+	const PacketRegistry& Registry = PacketRegistry::Get();
+	std::vector<std::unique_ptr<Lane>> Lanes;
+	/// By dense registry index. Built up front and never modified, so lookups need no lock.
+	std::vector<std::unique_ptr<PacketDispatchStats>> Stats;
+	Log logger = Log("PacketDispatch");
+};
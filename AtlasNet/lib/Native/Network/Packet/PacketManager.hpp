@@ -1,10 +1,15 @@
 
 #pragma once
 #include <atomic>
-#include <unordered_map>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
 
+#include "Global/Misc/EpochDomain.hpp"
 #include "Network/NetworkIdentity.hpp"
 #include "Packet.hpp"
+#include "PacketMetrics.hpp"
 class PacketManager
 {
    public:
@@ -23,7 +28,8 @@ class PacketManager
 	};
 
    public:
-	PacketManager() = default;
+	PacketManager() : m_table(new CallbackTable()) {}
+	~PacketManager() { delete m_table.load(std::memory_order_acquire); }
 	PacketManager(PacketManager&&) = delete;
 	PacketManager& operator=(const PacketManager&) = delete;
 	PacketManager& operator=(PacketManager&&) = delete;
@@ -32,11 +38,11 @@ class PacketManager
 	struct Subscription
 	{
 		PacketManager* owner = nullptr;
-		PacketTypeID type{};
+		uint32_t index = InvalidPacketIndex;
 		uint64_t id = 0;
 
 		Subscription() = default;
-		Subscription(PacketManager* o, PacketTypeID t, uint64_t i) : owner(o), type(t), id(i) {}
+		Subscription(PacketManager* o, uint32_t t, uint64_t i) : owner(o), index(t), id(i) {}
 
 		Subscription(const Subscription&) = delete;
 		Subscription& operator=(const Subscription&) = delete;
@@ -49,7 +55,7 @@ class PacketManager
 			{
 				Reset();
 				owner = other.owner;
-				type = other.type;
+				index = other.index;
 				id = other.id;
 				other.owner = nullptr;
 			}
@@ -62,7 +68,7 @@ class PacketManager
 		{
 			if (owner)
 			{
-				owner->Deactivate(type, id);
+				owner->Deactivate(index, id);
 				owner = nullptr;
 			}
 		}
@@ -73,75 +79,95 @@ class PacketManager
 	{
 		static_assert(std::is_base_of_v<IPacket, TPacket>);
 
+		const uint32_t index = m_registry.IndexOf(TPacket::TypeID);
+		ASSERT(index != InvalidPacketIndex, "Subscribing to a packet type that is not registered");
 		const uint64_t id = m_nextId.fetch_add(1, std::memory_order_relaxed);
 
-		auto entry = std::make_unique<CallbackEntry>();
+		auto entry = std::make_shared<CallbackEntry>();
 		entry->id = id;
 		entry->cb = [cb = std::move(cb)](const IPacket& pkt, const PacketManager::PacketInfo& info)
 		{ cb(static_cast<const TPacket&>(pkt), info); };
 
-		{
-			std::lock_guard lock(m_mutex);
-			m_callbacks[TPacket::TypeID].push_back(std::move(entry));
-		}
+		Update(
+			[&](CallbackTable& table)
+			{
+				if (table.size() <= index)
+					table.resize(index + 1);
+				table[index].push_back(std::move(entry));
+			});
 
-		return Subscription{this, TPacket::TypeID, id};
+		return Subscription{this, index, id};
 	}
 
+	/// @brief Lock and allocation free. Handlers see the subscriber list as it was when
+	/// dispatch started; handlers unsubscribed since are skipped.
 	void Dispatch(const IPacket& pkt, PacketTypeID type, const PacketInfo& info)
 	{
-		std::vector<CallbackEntry*> snapshot;
-
-		{
-			std::lock_guard lock(m_mutex);
-			auto it = m_callbacks.find(type);
-			if (it == m_callbacks.end())
-				return;
+		const EpochDomain::Guard guard(m_epoch);
+		const CallbackTable* table = m_table.load(std::memory_order_acquire);
 
-			snapshot.reserve(it->second.size());
-			for (auto& e : it->second) snapshot.push_back(e.get());
-		}
+		const uint32_t index = m_registry.IndexOf(type);
+		if (index >= table->size() || (*table)[index].empty())
+			return;
 
-		// Hot path: no locks held
-		for (auto* e : snapshot)
+		const auto start = std::chrono::steady_clock::now();
+		for (const auto& e : (*table)[index])
 		{
 			if (e->alive.load(std::memory_order_acquire))
 				e->cb(pkt, info);
 		}
+		PacketMetrics::RecordHandler(type, std::chrono::duration_cast<std::chrono::nanoseconds>(
+											   std::chrono::steady_clock::now() - start)
+											   .count());
 	}
 
-	void Cleanup()
-	{
-		std::lock_guard lock(m_mutex);
-
-		for (auto& [_, vec] : m_callbacks)
-		{
-			std::erase_if(vec, [](auto& e) { return !e->alive.load(std::memory_order_acquire); });
-		}
-	}
+	/// @brief Free retired subscriber tables no reader can see anymore. Unsubscribing already does
+	/// this, calling it by hand is only needed to release memory sooner.
+	void Cleanup() { m_epoch.Reclaim(); }
 
    private:
-	void Deactivate(PacketTypeID type, uint64_t id)
+	/// Subscribers by the packet type's dense registry index, only as long as the highest index
+	/// anyone subscribed to.
+	using CallbackTable = std::vector<std::vector<std::shared_ptr<CallbackEntry>>>;
+
+	/// Copy the current table, edit the copy and publish it. Writers are serialized, readers
+	/// never wait.
+	template <typename Fn>
+	void Update(Fn&& edit)
 	{
 		std::lock_guard lock(m_mutex);
+		const CallbackTable* current = m_table.load(std::memory_order_relaxed);
+		auto* next = new CallbackTable(*current);
+		edit(*next);
+		m_table.store(next, std::memory_order_release);
+		m_epoch.Retire([current] { delete current; });
+	}
 
-		auto it = m_callbacks.find(type);
-		if (it == m_callbacks.end())
-			return;
-
-		for (auto& e : it->second)
-		{
-			if (e->id == id)
+	void Deactivate(uint32_t index, uint64_t id)
+	{
+		Update(
+			[&](CallbackTable& table)
 			{
-				e->alive.store(false, std::memory_order_release);
-				break;
-			}
-		}
+				if (index >= table.size())
+					return;
+				std::erase_if(table[index],
+							  [id](const std::shared_ptr<CallbackEntry>& e)
+							  {
+								  if (e->id != id)
+									  return false;
+								  // Readers still holding the old table must skip it too
+								  e->alive.store(false, std::memory_order_release);
+								  return true;
+							  });
+			});
 	}
 
    private:
-	std::unordered_map<PacketTypeID, std::vector<std::unique_ptr<CallbackEntry>>> m_callbacks;
+	/// Cached, Get locks
+	const PacketRegistry& m_registry = PacketRegistry::Get();
+	std::atomic<const CallbackTable*> m_table;
+	EpochDomain m_epoch;
 
-	std::mutex m_mutex;
+	std::mutex m_mutex;  // writers only
 	std::atomic<uint64_t> m_nextId{1};
 };
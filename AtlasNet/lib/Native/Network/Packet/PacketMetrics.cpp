@@ -0,0 +1,193 @@
+#include "PacketMetrics.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+
+#include "PacketDispatchExecutor.hpp"
+
+struct PacketMetrics::Shard
+{
+	/// By dense registry index. Sized from the registry when the shard is created and never
+	/// resized afterwards, so other threads can read it while the owner records.
+	std::vector<std::unique_ptr<Counters>> ByIndex;
+};
+
+struct PacketMetrics::ShardList
+{
+	std::mutex Mutex;
+	std::vector<std::unique_ptr<Shard>> All;
+	/// Shards of exited threads, waiting for a new thread to take them over.
+	std::vector<Shard*> Free;
+};
+
+PacketMetrics::ShardList& PacketMetrics::Shards()
+{
+	static ShardList list;
+	return list;
+}
+
+PacketMetrics::Counters* PacketMetrics::Local(PacketTypeID type)
+{
+	static const PacketRegistry& registry = PacketRegistry::Get();
+	struct Owner
+	{
+		Shard* Owned = nullptr;
+		Owner()
+		{
+			ShardList& list = Shards();
+			std::lock_guard lock(list.Mutex);
+			if (!list.Free.empty())
+			{
+				Owned = list.Free.back();
+				list.Free.pop_back();
+				return;
+			}
+			auto shard = std::make_unique<Shard>();
+			shard->ByIndex.resize(registry.GetTypeCount());
+			for (auto& counters : shard->ByIndex)
+				counters = std::make_unique<Counters>();
+			Owned = shard.get();
+			list.All.push_back(std::move(shard));
+		}
+		~Owner()
+		{
+			ShardList& list = Shards();
+			std::lock_guard lock(list.Mutex);
+			list.Free.push_back(Owned);
+		}
+	};
+	thread_local Owner owner;
+	const uint32_t index = registry.IndexOf(type);
+	return index < owner.Owned->ByIndex.size() ? owner.Owned->ByIndex[index].get() : nullptr;
+}
+
+void PacketMetrics::RecordSend(PacketTypeID type, size_t bytes, uint64_t serializeNs,
+							   uint32_t recipients)
+{
+	Counters* c = Local(type);
+	if (!c)
+		return;
+	c->Sent.fetch_add(recipients, std::memory_order_relaxed);
+	c->SentBytes.fetch_add(bytes * recipients, std::memory_order_relaxed);
+	c->SizeBytes.Record(bytes);
+	c->SerializeNs.Record(serializeNs);
+}
+
+void PacketMetrics::RecordReceive(PacketTypeID type, size_t bytes, uint64_t deserializeNs)
+{
+	Counters* c = Local(type);
+	if (!c)
+		return;
+	c->Received.fetch_add(1, std::memory_order_relaxed);
+	c->ReceivedBytes.fetch_add(bytes, std::memory_order_relaxed);
+	c->SizeBytes.Record(bytes);
+	c->DeserializeNs.Record(deserializeNs);
+}
+
+void PacketMetrics::RecordHandler(PacketTypeID type, uint64_t handlerNs)
+{
+	Counters* c = Local(type);
+	if (!c)
+		return;
+	c->Handled.fetch_add(1, std::memory_order_relaxed);
+	c->HandlerNs.Record(handlerNs);
+}
+
+void PacketMetrics::RecordCompress(PacketTypeID type, size_t rawBytes, size_t wireBytes,
+								   uint64_t compressNs)
+{
+	Counters* c = Local(type);
+	if (!c)
+		return;
+	if (wireBytes < rawBytes)
+		c->Compressed.fetch_add(1, std::memory_order_relaxed);
+	c->CompressRawBytes.fetch_add(rawBytes, std::memory_order_relaxed);
+	c->CompressWireBytes.fetch_add(wireBytes, std::memory_order_relaxed);
+	c->CompressNs.Record(compressNs);
+}
+
+void PacketMetrics::RecordDecompress(PacketTypeID type, uint64_t decompressNs)
+{
+	Counters* c = Local(type);
+	if (!c)
+		return;
+	c->Decompressed.fetch_add(1, std::memory_order_relaxed);
+	c->DecompressNs.Record(decompressNs);
+}
+
+std::vector<PacketTypeTelemetry> PacketMetrics::Collect(const PacketDispatchExecutor* dispatch)
+{
+	const PacketRegistry& registry = PacketRegistry::Get();
+	std::vector<Counters> merged(registry.GetTypeCount());
+	{
+		ShardList& list = Shards();
+		std::lock_guard lock(list.Mutex);
+		for (const auto& shard : list.All)
+		{
+			for (size_t index = 0; index < shard->ByIndex.size(); index++)
+			{
+				const auto& c = shard->ByIndex[index];
+				Counters& m = merged[index];
+				m.Sent.fetch_add(c->Sent.load(std::memory_order_relaxed));
+				m.SentBytes.fetch_add(c->SentBytes.load(std::memory_order_relaxed));
+				m.Received.fetch_add(c->Received.load(std::memory_order_relaxed));
+				m.ReceivedBytes.fetch_add(c->ReceivedBytes.load(std::memory_order_relaxed));
+				m.Handled.fetch_add(c->Handled.load(std::memory_order_relaxed));
+				m.Compressed.fetch_add(c->Compressed.load(std::memory_order_relaxed));
+				m.CompressRawBytes.fetch_add(c->CompressRawBytes.load(std::memory_order_relaxed));
+				m.CompressWireBytes.fetch_add(c->CompressWireBytes.load(std::memory_order_relaxed));
+				m.Decompressed.fetch_add(c->Decompressed.load(std::memory_order_relaxed));
+				m.SizeBytes.Merge(c->SizeBytes);
+				m.SerializeNs.Merge(c->SerializeNs);
+				m.DeserializeNs.Merge(c->DeserializeNs);
+				m.HandlerNs.Merge(c->HandlerNs);
+				m.CompressNs.Merge(c->CompressNs);
+				m.DecompressNs.Merge(c->DecompressNs);
+			}
+		}
+	}
+
+	std::vector<PacketTypeTelemetry> out;
+	out.reserve(merged.size());
+	for (uint32_t index = 0; index < merged.size(); index++)
+	{
+		const Counters& m = merged[index];
+		if (m.Sent == 0 && m.Received == 0 && m.Handled == 0)
+			continue;
+		const std::string_view name = registry.GetTraitsAt(index).Name;
+		out.push_back(PacketTypeTelemetry{
+			.Name = name.empty() ? std::to_string(registry.GetTypeAt(index)) : std::string(name),
+			.Sent = m.Sent,
+			.SentBytes = m.SentBytes,
+			.Received = m.Received,
+			.ReceivedBytes = m.ReceivedBytes,
+			.SizeP50 = m.SizeBytes.Percentile(0.5),
+			.SizeP99 = m.SizeBytes.Percentile(0.99),
+			.SerializeP50 = m.SerializeNs.Percentile(0.5),
+			.SerializeP99 = m.SerializeNs.Percentile(0.99),
+			.DeserializeP50 = m.DeserializeNs.Percentile(0.5),
+			.DeserializeP99 = m.DeserializeNs.Percentile(0.99),
+			.Handled = m.Handled,
+			.HandlerP50 = m.HandlerNs.Percentile(0.5),
+			.HandlerP99 = m.HandlerNs.Percentile(0.99),
+			.Compressed = m.Compressed,
+			.CompressRawBytes = m.CompressRawBytes,
+			.CompressWireBytes = m.CompressWireBytes,
+			.CompressP50 = m.CompressNs.Percentile(0.5),
+			.CompressP99 = m.CompressNs.Percentile(0.99),
+			.Decompressed = m.Decompressed,
+			.DecompressP50 = m.DecompressNs.Percentile(0.5),
+			.DecompressP99 = m.DecompressNs.Percentile(0.99)});
+		if (const PacketDispatchStats* stats =
+				dispatch ? dispatch->GetStats(registry.GetTypeAt(index)) : nullptr)
+		{
+			PacketTypeTelemetry& t = out.back();
+			t.QueueDepth = (uint64_t)std::max<int64_t>(
+				stats->QueueDepth.load(std::memory_order_relaxed), 0);
+			t.QueueWaitP50Usec = stats->QueueWaitUsec.Percentile(0.5);
+			t.QueueWaitP99Usec = stats->QueueWaitUsec.Percentile(0.99);
+		}
+	}
+	return out;
+}
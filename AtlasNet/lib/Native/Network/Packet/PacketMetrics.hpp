@@ -0,0 +1,64 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "Global/Misc/LatencyHistogram.hpp"
+#include "Network/PacketTypeTelemetry.hpp"
+#include "Packet.hpp"
+
+class PacketDispatchExecutor;
+
+/**
+ * @brief Process wide per packet type traffic and timing counters.
+ * @details Every thread records into its own shard, so the send, receive and handler paths never
+ * share a cache line with another thread. Collect sums the shards. A shard outlives its thread and
+ * is handed to the next thread that starts recording, so nothing recorded is lost. Only types in
+ * the PacketRegistry are tracked. Times are in nanoseconds, most packets take well under a
+ * microsecond to serialize or decode.
+ */
+class PacketMetrics
+{
+   public:
+	struct Counters
+	{
+		std::atomic<uint64_t> Sent{0};
+		std::atomic<uint64_t> SentBytes{0};
+		std::atomic<uint64_t> Received{0};
+		std::atomic<uint64_t> ReceivedBytes{0};
+		std::atomic<uint64_t> Handled{0};
+		/// Sends over the type's compression threshold, before and after compression. Sends that
+		/// did not shrink went out raw and count the same on both sides.
+		std::atomic<uint64_t> Compressed{0};
+		std::atomic<uint64_t> CompressRawBytes{0};
+		std::atomic<uint64_t> CompressWireBytes{0};
+		std::atomic<uint64_t> Decompressed{0};
+		LatencyHistogram SizeBytes;
+		LatencyHistogram SerializeNs;
+		LatencyHistogram DeserializeNs;
+		LatencyHistogram HandlerNs;
+		LatencyHistogram CompressNs;
+		LatencyHistogram DecompressNs;
+	};
+
+	/// @param recipients Messages the serialized bytes went out as, more than one for multicast.
+	static void RecordSend(PacketTypeID type, size_t bytes, uint64_t serializeNs,
+						   uint32_t recipients = 1);
+	static void RecordReceive(PacketTypeID type, size_t bytes, uint64_t deserializeNs);
+	static void RecordHandler(PacketTypeID type, uint64_t handlerNs);
+	/// @param wireBytes What went out, rawBytes again when compressing did not pay off.
+	static void RecordCompress(PacketTypeID type, size_t rawBytes, size_t wireBytes,
+							   uint64_t compressNs);
+	static void RecordDecompress(PacketTypeID type, uint64_t decompressNs);
+
+	/// @brief Sum of all shards, one entry per type that saw any traffic.
+	/// @param dispatch When given, its worker queue depth and wait are filled in as well.
+	static std::vector<PacketTypeTelemetry> Collect(
+		const PacketDispatchExecutor* dispatch = nullptr);
+
+   private:
+	struct Shard;
+	struct ShardList;
+	static ShardList& Shards();
+	static Counters* Local(PacketTypeID type);
+};
@@ -0,0 +1,41 @@
+#include "Packet.hpp"
+#include "PacketTypes.hpp"
+
+PacketRegistry::PacketRegistry()
+{
+	Entries.reserve(BuiltinPacketTypes::Count);
+	BuiltinPacketTypes::ForEach(
+		[&]<typename T>(uint32_t index)
+		{
+			ASSERT(index == Entries.size(), "Built in packets registered out of order");
+			Entries.push_back(Entry{.Type = T::TypeID,
+									.Factory = &T::Create,
+									.Acquire = &T::Acquire,
+									.Traits = T::Traits()});
+		});
+	Slots.assign(BuiltinPacketTypes::IndexTable.begin(), BuiltinPacketTypes::IndexTable.end());
+}
+
+bool PacketRegistry::Register(PacketTypeID type, FactoryFn fn, AcquireFn acquire,
+							  PacketTypeTraits traits)
+{
+	const uint32_t existing = IndexOf(type);
+	if (existing != InvalidPacketIndex)
+	{
+		ASSERT(traits.Name.empty() || Entries[existing].Traits.Name == traits.Name,
+			   "Two packet names hash to the same PacketTypeID");
+		return false;
+	}
+
+	const uint32_t index = (uint32_t)Entries.size();
+	Entries.push_back(Entry{.Type = type, .Factory = fn, .Acquire = acquire, .Traits = traits});
+	if (Slots.size() < PacketIndexTableSize(Entries.size()))
+	{
+		Slots.assign(PacketIndexTableSize(Entries.size()), PacketIndexSlot{});
+		for (uint32_t i = 0; i < Entries.size(); i++)
+			PacketIndexInsert(Slots, Entries[i].Type, i);
+	}
+	else
+		PacketIndexInsert(Slots, type, index);
+	return true;
+}
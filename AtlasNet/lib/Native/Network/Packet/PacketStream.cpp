@@ -0,0 +1,130 @@
+#include "PacketStream.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "Global/Serialize/ByteReader.hpp"
+
+void PacketStreamChunkHeader::Serialize(ByteWriter& bw) const
+{
+	bw.write_scalar<PacketTypeID>(TypeID);
+	bw.u32(StreamID);
+	bw.u32(TotalSize);
+	bw.u32(Offset);
+}
+
+std::optional<PacketStreamChunkHeader> PacketStreamChunkHeader::Read(
+	std::span<const uint8_t> chunk)
+{
+	if (chunk.size() < Size)
+		return std::nullopt;
+	ByteReader br(chunk);
+	if (br.read_scalar<PacketTypeID>() != TypeID)
+		return std::nullopt;
+	PacketStreamChunkHeader header;
+	header.StreamID = br.u32();
+	header.TotalSize = br.u32();
+	header.Offset = br.u32();
+	return header;
+}
+
+OutboundBufferPtr SplitIntoChunks(const OutboundBuffer& packet, uint32_t streamID,
+								  uint32_t chunkBytes)
+{
+	const std::span<const uint8_t> bytes = packet.Writer.bytes();
+	const size_t chunks = (bytes.size() + chunkBytes - 1) / chunkBytes;
+
+	OutboundBufferPtr framed = OutboundBuffer::Create();
+	framed->Lane = packet.Lane;
+	framed->Writer = ByteWriter(bytes.size() + chunks * PacketStreamChunkHeader::Size);
+	framed->FrameEnds.reserve(chunks);
+	for (size_t offset = 0; offset < bytes.size(); offset += chunkBytes)
+	{
+		const size_t len = std::min<size_t>(chunkBytes, bytes.size() - offset);
+		PacketStreamChunkHeader{.StreamID = streamID,
+								.TotalSize = (uint32_t)bytes.size(),
+								.Offset = (uint32_t)offset}
+			.Serialize(framed->Writer);
+		framed->Writer.write(bytes.data() + offset, len);
+		framed->FrameEnds.push_back((uint32_t)framed->Writer.size());
+	}
+	return framed;
+}
+
+std::optional<PacketStreamAssembler::Completed> PacketStreamAssembler::Accept(
+	const NetworkIdentity& sender, std::span<const uint8_t> chunk)
+{
+	Stats.ChunksReceived.fetch_add(1, std::memory_order_relaxed);
+	const auto header = PacketStreamChunkHeader::Read(chunk);
+	if (!header)
+	{
+		logger.ErrorFormatted("Malformed stream chunk of {} bytes from {}", chunk.size(),
+							  sender.ToString());
+		return std::nullopt;
+	}
+	const std::span<const uint8_t> payload = chunk.subspan(PacketStreamChunkHeader::Size);
+
+	auto& streams = Streams[sender];
+	auto it = streams.find(header->StreamID);
+	if (it == streams.end())
+	{
+		if (header->Offset != 0 || header->TotalSize < sizeof(PacketTypeID) ||
+			header->TotalSize > MaxStreamBytes)
+		{
+			logger.ErrorFormatted("Rejecting stream {} from {}: offset {} size {}",
+								  header->StreamID, sender.ToString(), header->Offset,
+								  header->TotalSize);
+			Stats.Dropped.fetch_add(1, std::memory_order_relaxed);
+			if (streams.empty())
+				Streams.erase(sender);
+			return std::nullopt;
+		}
+		// Left uninitialized, every byte is written by exactly one chunk
+		Partial partial{.Data = std::unique_ptr<uint8_t[]>(new uint8_t[header->TotalSize]),
+						.TotalSize = header->TotalSize};
+		Stats.BytesPending.fetch_add(header->TotalSize, std::memory_order_relaxed);
+		it = streams.emplace(header->StreamID, std::move(partial)).first;
+	}
+
+	Partial& partial = it->second;
+	if (header->Offset != partial.Received || header->TotalSize != partial.TotalSize ||
+		payload.size() > partial.TotalSize - partial.Received)
+	{
+		logger.ErrorFormatted("Out of order chunk for stream {} from {} at offset {}",
+							  header->StreamID, sender.ToString(), header->Offset);
+		Drop(streams, it);
+		if (streams.empty())
+			Streams.erase(sender);
+		return std::nullopt;
+	}
+	std::memcpy(partial.Data.get() + partial.Received, payload.data(), payload.size());
+	partial.Received += (uint32_t)payload.size();
+	if (partial.Received < partial.TotalSize)
+		return std::nullopt;
+
+	Completed completed{.Data = std::move(partial.Data), .Size = partial.TotalSize};
+	Stats.BytesPending.fetch_sub(partial.TotalSize, std::memory_order_relaxed);
+	Stats.Completed.fetch_add(1, std::memory_order_relaxed);
+	streams.erase(it);
+	if (streams.empty())
+		Streams.erase(sender);
+	return completed;
+}
+
+void PacketStreamAssembler::DropSender(const NetworkIdentity& sender)
+{
+	auto found = Streams.find(sender);
+	if (found == Streams.end())
+		return;
+	auto& streams = found->second;
+	while (!streams.empty()) Drop(streams, streams.begin());
+	Streams.erase(found);
+}
+
+void PacketStreamAssembler::Drop(std::unordered_map<uint32_t, Partial>& streams,
+								 std::unordered_map<uint32_t, Partial>::iterator it)
+{
+	Stats.BytesPending.fetch_sub(it->second.TotalSize, std::memory_order_relaxed);
+	Stats.Dropped.fetch_add(1, std::memory_order_relaxed);
+	streams.erase(it);
+}
@@ -0,0 +1,89 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <unordered_map>
+
+#include "Debug/Log.hpp"
+#include "Network/NetworkIdentity.hpp"
+#include "Network/OutboundBuffer.hpp"
+#include "Packet.hpp"
+
+/**
+ * @brief Header in front of every chunk of a packet too large for a single message.
+ * @details A streamed packet goes out as consecutive chunks on one reliable lane, each laid out
+ * as [TypeID][StreamID][TotalSize][Offset][bytes]. TypeID takes the place of a packet type so the
+ * receiver can tell chunks apart with PacketRegistry::PeekPacketType.
+ */
+struct PacketStreamChunkHeader
+{
+	static constexpr PacketTypeID TypeID = HashString("PacketStreamChunk");
+	static constexpr size_t Size = sizeof(PacketTypeID) + 3 * sizeof(uint32_t);
+
+	uint32_t StreamID = 0;
+	uint32_t TotalSize = 0;
+	uint32_t Offset = 0;
+
+	void Serialize(ByteWriter& bw) const;
+	/// @brief Parse the header of a chunk, nullopt when the chunk is too short.
+	static std::optional<PacketStreamChunkHeader> Read(std::span<const uint8_t> chunk);
+};
+
+/// @brief Copy a serialized packet into a buffer framed as chunks of at most chunkBytes payload.
+/// @details The copy happens once on the sending thread. Every target then gets messages pointing
+/// into the same framed buffer, like any other OutboundBuffer.
+OutboundBufferPtr SplitIntoChunks(const OutboundBuffer& packet, uint32_t streamID,
+								  uint32_t chunkBytes);
+
+struct PacketStreamStats
+{
+	std::atomic<uint64_t> Completed{0};
+	/// Streams abandoned for a malformed chunk, exceeding the size limit or the sender leaving.
+	std::atomic<uint64_t> Dropped{0};
+	std::atomic<uint64_t> ChunksReceived{0};
+	/// Bytes held by streams still waiting for chunks.
+	std::atomic<uint64_t> BytesPending{0};
+};
+
+/**
+ * @brief Reassembles streamed packets on the receiving side.
+ * @details The first chunk allocates a buffer of the packet's full size and every chunk is copied
+ * straight to its offset there, so the payload is never gathered in a second buffer. Chunks must
+ * arrive in order, which GNS guarantees for reliable messages on one lane. Single threaded.
+ */
+class PacketStreamAssembler
+{
+   public:
+	/// Streams announcing more than this are rejected before anything is allocated.
+	size_t MaxStreamBytes = 64 * 1024 * 1024;
+
+	/// @brief A fully reassembled packet, still encoded.
+	struct Completed
+	{
+		std::unique_ptr<uint8_t[]> Data;
+		uint32_t Size = 0;
+		[[nodiscard]] std::span<const uint8_t> Bytes() const { return {Data.get(), Size}; }
+	};
+	/// @brief Take one chunk, returns the packet's bytes once its last chunk arrived.
+	std::optional<Completed> Accept(const NetworkIdentity& sender, std::span<const uint8_t> chunk);
+	/// @brief Forget every partial stream from sender, call when its connection goes away.
+	void DropSender(const NetworkIdentity& sender);
+
+	[[nodiscard]] const PacketStreamStats& GetStats() const { return Stats; }
+
+   private:
+	struct Partial
+	{
+		std::unique_ptr<uint8_t[]> Data;
+		uint32_t TotalSize = 0;
+		uint32_t Received = 0;
+	};
+	void Drop(std::unordered_map<uint32_t, Partial>& streams,
+			  std::unordered_map<uint32_t, Partial>::iterator it);
+
+	std::unordered_map<NetworkIdentity, std::unordered_map<uint32_t, Partial>> Streams;
+	PacketStreamStats Stats;
+	Log logger = Log("PacketStream");
+};
@@ -0,0 +1,98 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+using PacketTypeID = uint32_t;
+
+inline constexpr uint32_t InvalidPacketIndex = std::numeric_limits<uint32_t>::max();
+
+/// @brief One entry of the table mapping a PacketTypeID to its dense index.
+struct PacketIndexSlot
+{
+	PacketTypeID Type = 0;
+	uint32_t Index = InvalidPacketIndex;
+};
+
+/// @brief Smallest power of two table that keeps count entries at most half full.
+constexpr size_t PacketIndexTableSize(size_t count)
+{
+	size_t size = 8;
+	while (size < count * 2)
+		size *= 2;
+	return size;
+}
+
+/// @brief Linear probing from the ID's low bits, which are already an FNV hash.
+template <typename Slots>
+constexpr void PacketIndexInsert(Slots &slots, PacketTypeID type, uint32_t index)
+{
+	const size_t mask = slots.size() - 1;
+	size_t i = type & mask;
+	while (slots[i].Index != InvalidPacketIndex)
+		i = (i + 1) & mask;
+	slots[i] = PacketIndexSlot{.Type = type, .Index = index};
+}
+
+template <typename Slots>
+constexpr uint32_t PacketIndexFind(const Slots &slots, PacketTypeID type)
+{
+	const size_t mask = slots.size() - 1;
+	for (size_t i = type & mask;; i = (i + 1) & mask)
+	{
+		if (slots[i].Index == InvalidPacketIndex || slots[i].Type == type)
+			return slots[i].Index;
+	}
+}
+
+template <typename... Packets>
+consteval bool HasUniquePacketTypeIDs()
+{
+	constexpr std::array<PacketTypeID, sizeof...(Packets)> ids = {Packets::TypeID...};
+	for (size_t i = 0; i < ids.size(); i++)
+		for (size_t j = i + 1; j < ids.size(); j++)
+			if (ids[i] == ids[j])
+				return false;
+	return true;
+}
+
+/**
+ * @brief Packet types known at compile time, each given a dense index by its position.
+ * @details Two names hashing to the same PacketTypeID fail the build. The index table is built by
+ * the compiler, so looking a type up is a probe of a few slots in a constant array.
+ */
+template <typename... Packets>
+struct PacketTypeList
+{
+	static_assert(HasUniquePacketTypeIDs<Packets...>(),
+				  "Two packet names hash to the same PacketTypeID, rename one of them");
+
+	static constexpr size_t Count = sizeof...(Packets);
+	static constexpr std::array<PacketTypeID, Count> TypeIDs = {Packets::TypeID...};
+	static constexpr auto IndexTable = []
+	{
+		std::array<PacketIndexSlot, PacketIndexTableSize(Count)> slots{};
+		for (uint32_t i = 0; i < Count; i++)
+			PacketIndexInsert(slots, TypeIDs[i], i);
+		return slots;
+	}();
+
+	template <typename T>
+	static constexpr uint32_t IndexOf()
+	{
+		constexpr std::array<bool, Count> same = {std::is_same_v<T, Packets>...};
+		for (uint32_t i = 0; i < Count; i++)
+			if (same[i])
+				return i;
+		return InvalidPacketIndex;
+	}
+
+	/// @brief Calls fn.template operator()<Packet>(index) for every type, in index order.
+	template <typename Fn>
+	static void ForEach(Fn &&fn)
+	{
+		uint32_t index = 0;
+		(fn.template operator()<Packets>(index++), ...);
+	}
+};
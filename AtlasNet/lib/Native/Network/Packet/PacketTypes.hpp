@@ -0,0 +1,12 @@
+#pragma once
+#include "Entity/Packet/ClientTransferPacket.hpp"
+#include "Entity/Packet/EntityTransferPacket.hpp"
+#include "Entity/Packet/LocalEntityListRequestPacket.hpp"
+#include "Interlink/Packet/RelayPacket.hpp"
+#include "Network/Packet/Client/ClientIDAssignPacket.hpp"
+#include "PacketTypeList.hpp"
+
+/// @brief Every packet type the library sends, in dense index order. A new type only needs adding
+/// here, the build fails if its name hashes to the same ID as one already listed.
+using BuiltinPacketTypes = PacketTypeList<RelayPacket, EntityTransferPacket, ClientTransferPacket,
+										  LocalEntityListRequestPacket, ClientIDAssignPacket>;
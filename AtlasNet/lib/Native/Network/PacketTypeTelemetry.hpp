@@ -0,0 +1,142 @@
+#pragma once
+#include <format>
+#include <string>
+#include <vector>
+
+#include "Global/Serialize/ByteReader.hpp"
+#include "Global/Serialize/ByteWriter.hpp"
+
+/// @brief Cumulative traffic and timing of one packet type on one node, as published to the
+/// NetworkManifest. Sizes are in bytes and times in nanoseconds.
+struct PacketTypeTelemetry
+{
+	std::string Name;
+
+	uint64_t Sent = 0;
+	uint64_t SentBytes = 0;
+	uint64_t Received = 0;
+	uint64_t ReceivedBytes = 0;
+	uint64_t SizeP50 = 0;
+	uint64_t SizeP99 = 0;
+
+	uint64_t SerializeP50 = 0;
+	uint64_t SerializeP99 = 0;
+	uint64_t DeserializeP50 = 0;
+	uint64_t DeserializeP99 = 0;
+
+	uint64_t Handled = 0;
+	uint64_t HandlerP50 = 0;
+	uint64_t HandlerP99 = 0;
+
+	/// Sends over the type's compression threshold. CompressWireBytes includes the ones that did
+	/// not shrink and went out raw.
+	uint64_t Compressed = 0;
+	uint64_t CompressRawBytes = 0;
+	uint64_t CompressWireBytes = 0;
+	uint64_t CompressP50 = 0;
+	uint64_t CompressP99 = 0;
+	uint64_t Decompressed = 0;
+	uint64_t DecompressP50 = 0;
+	uint64_t DecompressP99 = 0;
+
+	/// eWorkerPool types only: packets waiting for a dispatch worker, and how long they waited
+	/// in microseconds, the resolution PacketDispatchExecutor records at.
+	uint64_t QueueDepth = 0;
+	uint64_t QueueWaitP50Usec = 0;
+	uint64_t QueueWaitP99Usec = 0;
+
+	static constexpr size_t ColumnCount = 26;
+
+	/// @brief Raw over wire bytes of compressed sends, 1 when nothing was compressed.
+	[[nodiscard]] double CompressionRatio() const
+	{
+		return CompressWireBytes ? double(CompressRawBytes) / double(CompressWireBytes) : 1.0;
+	}
+
+	void Serialize(ByteWriter& bw) const
+	{
+		bw.str(Name);
+		bw.u64(Sent);
+		bw.u64(SentBytes);
+		bw.u64(Received);
+		bw.u64(ReceivedBytes);
+		bw.u64(SizeP50);
+		bw.u64(SizeP99);
+		bw.u64(SerializeP50);
+		bw.u64(SerializeP99);
+		bw.u64(DeserializeP50);
+		bw.u64(DeserializeP99);
+		bw.u64(Handled);
+		bw.u64(HandlerP50);
+		bw.u64(HandlerP99);
+		bw.u64(Compressed);
+		bw.u64(CompressRawBytes);
+		bw.u64(CompressWireBytes);
+		bw.u64(CompressP50);
+		bw.u64(CompressP99);
+		bw.u64(Decompressed);
+		bw.u64(DecompressP50);
+		bw.u64(DecompressP99);
+		bw.u64(QueueDepth);
+		bw.u64(QueueWaitP50Usec);
+		bw.u64(QueueWaitP99Usec);
+	}
+	void Deserialize(ByteReader& br)
+	{
+		Name = br.str();
+		Sent = br.u64();
+		SentBytes = br.u64();
+		Received = br.u64();
+		ReceivedBytes = br.u64();
+		SizeP50 = br.u64();
+		SizeP99 = br.u64();
+		SerializeP50 = br.u64();
+		SerializeP99 = br.u64();
+		DeserializeP50 = br.u64();
+		DeserializeP99 = br.u64();
+		Handled = br.u64();
+		HandlerP50 = br.u64();
+		HandlerP99 = br.u64();
+		Compressed = br.u64();
+		CompressRawBytes = br.u64();
+		CompressWireBytes = br.u64();
+		CompressP50 = br.u64();
+		CompressP99 = br.u64();
+		Decompressed = br.u64();
+		DecompressP50 = br.u64();
+		DecompressP99 = br.u64();
+		QueueDepth = br.u64();
+		QueueWaitP50Usec = br.u64();
+		QueueWaitP99Usec = br.u64();
+	}
+	/// @brief Column order used by the plain string manifest and the Cartograph.
+	std::vector<std::string> ToRow() const
+	{
+		return {Name,
+				std::to_string(Sent),
+				std::to_string(SentBytes),
+				std::to_string(Received),
+				std::to_string(ReceivedBytes),
+				std::to_string(SizeP50),
+				std::to_string(SizeP99),
+				std::to_string(SerializeP50),
+				std::to_string(SerializeP99),
+				std::to_string(DeserializeP50),
+				std::to_string(DeserializeP99),
+				std::to_string(Handled),
+				std::to_string(HandlerP50),
+				std::to_string(HandlerP99),
+				std::to_string(Compressed),
+				std::to_string(CompressRawBytes),
+				std::to_string(CompressWireBytes),
+				std::format("{:.2f}", CompressionRatio()),
+				std::to_string(CompressP50),
+				std::to_string(CompressP99),
+				std::to_string(Decompressed),
+				std::to_string(DecompressP50),
+				std::to_string(DecompressP99),
+				std::to_string(QueueDepth),
+				std::to_string(QueueWaitP50Usec),
+				std::to_string(QueueWaitP99Usec)};
+	}
+};
@@ -0,0 +1,158 @@
+#include "PendingSendQueue.hpp"
+
+#include <algorithm>
+
+namespace
+{
+bool IsReliable(NetworkMessageSendFlag flag)
+{
+	return ((int)flag & k_nSteamNetworkingSend_Reliable) != 0;
+}
+}  // namespace
+
+InterlinkSendStatus PendingSendQueue::Push(const NetworkIdentity &who,
+										   const OutboundBufferPtr &buffer,
+										   NetworkMessageSendFlag flag)
+{
+	Destination &destination = Destinations[who];
+	const auto now = Clock::now();
+	Expire(destination, now);
+
+	const uint32_t bytes = (uint32_t)buffer->Writer.size();
+	// eImmidiateOrDrop promises not to wait, so it never waits for a connection either
+	// An empty queue still takes one reliable message over budget, or streamed packets larger than
+	// the budget could never wait for a connection
+	const bool oversizedFirst = IsReliable(flag) && destination.Entries.empty();
+	if (flag == NetworkMessageSendFlag::eImmidiateOrDrop ||
+		(!oversizedFirst && !MakeRoom(destination, bytes)))
+	{
+		destination.Dropped++;
+		Stats.Overflowed.fetch_add(1, std::memory_order_relaxed);
+		return InterlinkSendStatus::eDropped;
+	}
+
+	const auto expiry = IsReliable(flag) ? Settings.ReliableExpiry : Settings.UnreliableExpiry;
+	destination.Entries.push_back(
+		Entry{.Buffer = buffer, .Flag = flag, .Deadline = now + expiry, .Bytes = bytes});
+	destination.Bytes += bytes;
+	Stats.Queued.fetch_add(1, std::memory_order_relaxed);
+	Publish(who, destination.Bytes);
+	return destination.Bytes >= Settings.MaxBytes * Settings.BackpressureFraction
+			   ? InterlinkSendStatus::eBackpressured
+			   : InterlinkSendStatus::eAccepted;
+}
+
+bool PendingSendQueue::MakeRoom(Destination &destination, uint64_t bytes)
+{
+	auto fits = [&]
+	{
+		return destination.Bytes + bytes <= Settings.MaxBytes &&
+			   destination.Entries.size() < Settings.MaxMessages;
+	};
+	if (fits())
+		return true;
+	for (auto it = destination.Entries.begin(); it != destination.Entries.end() && !fits();)
+	{
+		if (IsReliable(it->Flag))
+		{
+			++it;
+			continue;
+		}
+		destination.Bytes -= it->Bytes;
+		destination.Dropped++;
+		Stats.Overflowed.fetch_add(1, std::memory_order_relaxed);
+		it = destination.Entries.erase(it);
+	}
+	return fits();
+}
+
+void PendingSendQueue::Expire(Destination &destination, Clock::time_point now)
+{
+	const size_t before = destination.Entries.size();
+	std::erase_if(destination.Entries,
+				  [&](const Entry &entry)
+				  {
+					  if (entry.Deadline > now)
+						  return false;
+					  destination.Bytes -= entry.Bytes;
+					  return true;
+				  });
+	const size_t expired = before - destination.Entries.size();
+	destination.Dropped += expired;
+	Stats.Expired.fetch_add(expired, std::memory_order_relaxed);
+}
+
+size_t PendingSendQueue::Abandon(const NetworkIdentity &who)
+{
+	auto it = Destinations.find(who);
+	if (it == Destinations.end())
+		return 0;
+	const size_t dropped = it->second.Entries.size();
+	it->second.Dropped += dropped;
+	it->second.Entries.clear();
+	it->second.Bytes = 0;
+	Stats.Abandoned.fetch_add(dropped, std::memory_order_relaxed);
+	Publish(who, 0);
+	return dropped;
+}
+
+void PendingSendQueue::Forget(const NetworkIdentity &who)
+{
+	Abandon(who);
+	Destinations.erase(who);
+}
+
+void PendingSendQueue::Sweep()
+{
+	const auto now = Clock::now();
+	if (now < NextSweep)
+		return;
+	NextSweep = now + ExpirySweepInterval;
+	for (auto &[who, destination] : Destinations)
+	{
+		if (destination.Entries.empty())
+			continue;
+		Expire(destination, now);
+		Publish(who, destination.Bytes);
+	}
+}
+
+void PendingSendQueue::Publish(const NetworkIdentity &who, uint64_t bytes)
+{
+	std::lock_guard lock(BoardMutex);
+	if (bytes == 0)
+		Board.erase(who);
+	else
+		Board[who] = bytes;
+	BoardSize.store((uint32_t)Board.size(), std::memory_order_release);
+}
+
+InterlinkSendStatus PendingSendQueue::Pressure(const NetworkIdentity &who,
+											   NetworkMessageSendFlag flag) const
+{
+	if (BoardSize.load(std::memory_order_acquire) == 0)
+		return InterlinkSendStatus::eAccepted;
+	uint64_t bytes = 0;
+	{
+		std::lock_guard lock(BoardMutex);
+		auto it = Board.find(who);
+		if (it == Board.end())
+			return InterlinkSendStatus::eAccepted;
+		bytes = it->second;
+	}
+	if (bytes >= Settings.MaxBytes && !IsReliable(flag))
+		return InterlinkSendStatus::eDropped;
+	if (bytes >= Settings.MaxBytes * Settings.BackpressureFraction)
+		return InterlinkSendStatus::eBackpressured;
+	return InterlinkSendStatus::eAccepted;
+}
+
+PendingSendQueue::Depth PendingSendQueue::GetDepth(const NetworkIdentity &who) const
+{
+	auto it = Destinations.find(who);
+	if (it == Destinations.end())
+		return {};
+	return Depth{.Messages = (uint32_t)it->second.Entries.size(),
+				 .Bytes = it->second.Bytes,
+				 .Dropped = it->second.Dropped};
+}
@@ -0,0 +1,127 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+#include "Interlink/InterlinkEnums.hpp"
+#include "Network/NetworkEnums.hpp"
+#include "Network/NetworkIdentity.hpp"
+#include "Network/OutboundBuffer.hpp"
+
+struct PendingSendSettings
+{
+	/// Budget of a single destination. A message that does not fit evicts queued unreliable
+	/// messages, oldest first, and is dropped when that is not enough.
+	uint64_t MaxBytes = 4 * 1024 * 1024;
+	uint32_t MaxMessages = 4096;
+	/// Senders are told to back off once a destination holds this fraction of MaxBytes.
+	float BackpressureFraction = 0.75f;
+	std::chrono::milliseconds ReliableExpiry = std::chrono::seconds(10);
+	/// Unreliable traffic is state that the next update replaces, it goes stale quickly.
+	std::chrono::milliseconds UnreliableExpiry = std::chrono::milliseconds(250);
+};
+
+struct PendingSendStats
+{
+	std::atomic<uint64_t> Queued{0};
+	std::atomic<uint64_t> Flushed{0};
+	std::atomic<uint64_t> Expired{0};
+	/// Messages that did not fit the budget, or were eImmidiateOrDrop with no connection.
+	std::atomic<uint64_t> Overflowed{0};
+	/// Messages thrown away because their destination could not be reached.
+	std::atomic<uint64_t> Abandoned{0};
+};
+
+/**
+ * @brief Messages waiting for their destination's connection, bounded and expiring per destination.
+ * @details Everything but Pressure belongs to the Interlink tick thread. Pressure reads a small board
+ * of per destination byte counts that the tick thread republishes whenever a queue changes, so
+ * producers can throttle before serializing. The board is empty, and Pressure lock free, while every
+ * destination is connected.
+ */
+class PendingSendQueue
+{
+   public:
+	struct Depth
+	{
+		uint32_t Messages = 0;
+		uint64_t Bytes = 0;
+		uint64_t Dropped = 0;
+	};
+
+	void Configure(const PendingSendSettings &settings) { Settings = settings; }
+
+	/// @brief Queue buffer for who until its connection is up.
+	InterlinkSendStatus Push(const NetworkIdentity &who, const OutboundBufferPtr &buffer,
+							 NetworkMessageSendFlag flag);
+	/// @brief Hand every message for who that has not expired to send, oldest first.
+	template <typename SendFn>
+	void Flush(const NetworkIdentity &who, SendFn &&send)
+	{
+		auto it = Destinations.find(who);
+		if (it == Destinations.end())
+			return;
+		Expire(it->second, Clock::now());
+		for (const Entry &entry : it->second.Entries)
+			send(entry.Buffer, entry.Flag);
+		Stats.Flushed.fetch_add(it->second.Entries.size(), std::memory_order_relaxed);
+		it->second.Entries.clear();
+		it->second.Bytes = 0;
+		Publish(who, 0);
+	}
+	/// @brief Throw away everything queued for who, when it turned out to be unreachable.
+	/// @return number of messages dropped
+	size_t Abandon(const NetworkIdentity &who);
+	/// @brief Forget who entirely, including its drop counter, once its connection is gone.
+	void Forget(const NetworkIdentity &who);
+	/// @brief Drop expired messages of every destination. Runs at most every ExpirySweepInterval.
+	void Sweep();
+
+	/// @brief What a send to who should report right now. Safe from any thread.
+	[[nodiscard]] InterlinkSendStatus Pressure(const NetworkIdentity &who,
+											   NetworkMessageSendFlag flag) const;
+	[[nodiscard]] Depth GetDepth(const NetworkIdentity &who) const;
+	template <typename Fn>
+	void ForEachDepth(Fn &&fn) const
+	{
+		for (const auto &[who, destination] : Destinations)
+			fn(who, Depth{.Messages = (uint32_t)destination.Entries.size(),
+						  .Bytes = destination.Bytes,
+						  .Dropped = destination.Dropped});
+	}
+	[[nodiscard]] const PendingSendStats &GetStats() const { return Stats; }
+
+	std::chrono::milliseconds ExpirySweepInterval = std::chrono::milliseconds(100);
+
+   private:
+	using Clock = std::chrono::steady_clock;
+	struct Entry
+	{
+		OutboundBufferPtr Buffer;
+		NetworkMessageSendFlag Flag;
+		Clock::time_point Deadline;
+		uint32_t Bytes;
+	};
+	struct Destination
+	{
+		std::deque<Entry> Entries;
+		uint64_t Bytes = 0;
+		uint64_t Dropped = 0;
+	};
+	void Expire(Destination &destination, Clock::time_point now);
+	/// @brief Evict queued unreliable messages, oldest first, until bytes more fit.
+	bool MakeRoom(Destination &destination, uint64_t bytes);
+	void Publish(const NetworkIdentity &who, uint64_t bytes);
+
+	PendingSendSettings Settings;
+	std::unordered_map<NetworkIdentity, Destination> Destinations;
+	Clock::time_point NextSweep;
+	PendingSendStats Stats;
+
+	mutable std::mutex BoardMutex;
+	std::unordered_map<NetworkIdentity, uint64_t> Board;
+	std::atomic<uint32_t> BoardSize = 0;
+};
@@ -0,0 +1,143 @@
+#pragma once
+#include <steam/isteamnetworkingsockets.h>
+#include <steam/steamnetworkingtypes.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include "Global/Misc/LatencyHistogram.hpp"
+
+enum class ReceiveMode : uint8_t
+{
+	eSingleBatch,	  /// Pull at most one batch per tick
+	eDrainUntilEmpty  /// Keep pulling batches until the poll group is empty or the budget runs out
+};
+
+struct ReceiveDrainSettings
+{
+	ReceiveMode Mode = ReceiveMode::eDrainUntilEmpty;
+	uint32_t MinBatch = 32;
+	uint32_t MaxBatch = 1024;
+	/// Upper bound on the time a single tick spends draining. Messages left over are picked up on
+	/// the next tick, this only keeps a flood from starving callbacks and outbound work.
+	std::chrono::microseconds TimeBudget = std::chrono::milliseconds(2);
+};
+
+/// @brief What a single drain pulled off the poll group.
+struct ReceiveDrainStats
+{
+	uint32_t Messages = 0;
+	uint64_t Bytes = 0;
+	uint32_t Batches = 0;
+	bool BudgetExhausted = false;
+	/// Stopped on a full batch, so messages were most likely left in the poll group. GNS cannot
+	/// count a poll group's queue without taking the messages, so this is all that is known.
+	bool LeftMessages = false;
+};
+
+/// @brief Running per-tick receive counters, safe to read from any thread.
+struct ReceiveTelemetry
+{
+	std::atomic<uint64_t> TotalMessages{0};
+	std::atomic<uint64_t> TotalBytes{0};
+	std::atomic<uint64_t> BudgetExhaustedTicks{0};
+	/// Ticks that did not get to the end of the queue, see ReceiveDrainStats::LeftMessages.
+	std::atomic<uint64_t> LeftMessagesTicks{0};
+	std::atomic<uint32_t> CurrentBatchSize{0};
+
+	LatencyHistogram MessagesPerTick;
+	LatencyHistogram BytesPerTick;
+
+	void Record(const ReceiveDrainStats &stats, uint32_t batchSize) noexcept
+	{
+		TotalMessages.fetch_add(stats.Messages, std::memory_order_relaxed);
+		TotalBytes.fetch_add(stats.Bytes, std::memory_order_relaxed);
+		if (stats.BudgetExhausted)
+			BudgetExhaustedTicks.fetch_add(1, std::memory_order_relaxed);
+		if (stats.LeftMessages)
+			LeftMessagesTicks.fetch_add(1, std::memory_order_relaxed);
+		CurrentBatchSize.store(batchSize, std::memory_order_relaxed);
+		MessagesPerTick.Record(stats.Messages);
+		BytesPerTick.Record(stats.Bytes);
+	}
+};
+
+/**
+ * @brief Pulls messages from a GNS poll group in batches whose size follows the backlog.
+ * @details The batch doubles every time GNS fills it completely and halves once a batch comes back
+ * less than a quarter full, clamped to [MinBatch, MaxBatch]. The message array is kept between
+ * ticks so draining does not allocate once the batch size has settled.
+ */
+class ReceiveDrain
+{
+   public:
+	ReceiveDrain() { Configure(ReceiveDrainSettings()); }
+
+	void Configure(const ReceiveDrainSettings &settings)
+	{
+		Settings = settings;
+		Settings.MinBatch = std::max<uint32_t>(Settings.MinBatch, 1);
+		Settings.MaxBatch = std::max(Settings.MaxBatch, Settings.MinBatch);
+		BatchSize = Settings.MinBatch;
+	}
+
+	/// @brief Receive from the poll group, calling onMessage for each message.
+	/// @details onMessage takes ownership of the message and must Release() it.
+	template <typename OnMessage>
+	ReceiveDrainStats Drain(ISteamNetworkingSockets *sockets, HSteamNetPollGroup pollGroup,
+							OnMessage &&onMessage)
+	{
+		using clock = std::chrono::steady_clock;
+		const auto deadline = clock::now() + Settings.TimeBudget;
+
+		ReceiveDrainStats stats;
+		while (true)
+		{
+			Messages.resize(BatchSize);
+			const int received =
+				sockets->ReceiveMessagesOnPollGroup(pollGroup, Messages.data(), (int)BatchSize);
+			if (received <= 0)
+				break;
+			stats.Batches++;
+			stats.Messages += (uint32_t)received;
+
+			for (int i = 0; i < received; ++i)
+			{
+				stats.Bytes += (uint32_t)Messages[i]->m_cbSize;
+				onMessage(Messages[i]);
+			}
+
+			const bool filled = (uint32_t)received == BatchSize;
+			if (filled)
+				BatchSize = std::min(BatchSize * 2, Settings.MaxBatch);
+			else if ((uint32_t)received < BatchSize / 4)
+				BatchSize = std::max(BatchSize / 2, Settings.MinBatch);
+
+			if (!filled)
+				break;
+			if (Settings.Mode == ReceiveMode::eSingleBatch)
+			{
+				stats.LeftMessages = true;
+				break;
+			}
+			if (clock::now() >= deadline)
+			{
+				stats.BudgetExhausted = true;
+				stats.LeftMessages = true;
+				break;
+			}
+		}
+		return stats;
+	}
+
+	[[nodiscard]] uint32_t GetBatchSize() const { return BatchSize; }
+	[[nodiscard]] const ReceiveDrainSettings &GetSettings() const { return Settings; }
+
+   private:
+	ReceiveDrainSettings Settings;
+	uint32_t BatchSize = 32;
+	std::vector<ISteamNetworkingMessage *> Messages;
+};
@@ -0,0 +1,109 @@
+#include "VirtualChannelTable.hpp"
+
+#include <limits>
+#include <mutex>
+
+std::optional<ChannelID> VirtualChannelTable::Open(const NetworkIdentity& link,
+												   const ClientID& client)
+{
+	std::unique_lock lock(Mutex);
+	if (const auto it = Routes.find(client); it != Routes.end())
+	{
+		if (it->second.Link == link)
+			return it->second.Channel;
+		CloseRoute(client);
+	}
+
+	Link& l = Links[link];
+	ChannelID channel = InvalidChannelID;
+	// Fresh IDs first, reuse only starts once all of them went out
+	if (l.Next <= std::numeric_limits<ChannelID>::max())
+		channel = (ChannelID)l.Next++;
+	else if (!l.Free.empty())
+	{
+		channel = l.Free.front();
+		l.Free.pop_front();
+	}
+	else
+		return std::nullopt;
+
+	l.Clients[channel] = client;
+	Routes[client] = Route{.Link = link, .Channel = channel};
+	return channel;
+}
+
+void VirtualChannelTable::Adopt(const NetworkIdentity& link, ChannelID channel,
+								const ClientID& client)
+{
+	std::unique_lock lock(Mutex);
+	if (const auto it = Routes.find(client); it != Routes.end())
+	{
+		if (it->second.Link == link && it->second.Channel == channel)
+			return;
+		CloseRoute(client);
+	}
+
+	Link& l = Links[link];
+	if (const auto previous = l.Clients.find(channel); previous != l.Clients.end())
+		Routes.erase(previous->second);
+	l.Clients[channel] = client;
+	Routes[client] = Route{.Link = link, .Channel = channel};
+}
+
+void VirtualChannelTable::Forget(const NetworkIdentity& peer)
+{
+	std::unique_lock lock(Mutex);
+	if (!peer.IsInternal())
+	{
+		CloseRoute(peer.ID);
+		return;
+	}
+	const auto it = Links.find(peer);
+	if (it == Links.end())
+		return;
+	for (const auto& [channel, client] : it->second.Clients)
+		Routes.erase(client);
+	Links.erase(it);
+}
+
+std::optional<VirtualChannelTable::Route> VirtualChannelTable::RouteOf(
+	const ClientID& client) const
+{
+	std::shared_lock lock(Mutex);
+	const auto it = Routes.find(client);
+	if (it == Routes.end())
+		return std::nullopt;
+	return it->second;
+}
+
+std::optional<ClientID> VirtualChannelTable::ClientOn(const NetworkIdentity& link,
+													  ChannelID channel) const
+{
+	std::shared_lock lock(Mutex);
+	const auto l = Links.find(link);
+	if (l == Links.end())
+		return std::nullopt;
+	const auto it = l->second.Clients.find(channel);
+	if (it == l->second.Clients.end())
+		return std::nullopt;
+	return it->second;
+}
+
+size_t VirtualChannelTable::Size() const
+{
+	std::shared_lock lock(Mutex);
+	return Routes.size();
+}
+
+void VirtualChannelTable::CloseRoute(const ClientID& client)
+{
+	const auto route = Routes.find(client);
+	if (route == Routes.end())
+		return;
+	if (const auto l = Links.find(route->second.Link); l != Links.end())
+	{
+		l->second.Clients.erase(route->second.Channel);
+		l->second.Free.push_back(route->second.Channel);
+	}
+	Routes.erase(route);
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include <boost/container_hash/hash.hpp>
+#include <deque>
+#include <optional>
+#include <shared_mutex>
+#include <unordered_map>
+
+#include "Client/Client.hpp"
+#include "Network/NetworkIdentity.hpp"
+#include "Network/Packet/PacketChannelFrame.hpp"
+
+/**
+ * @brief Which client each virtual channel on a proxy↔shard link belongs to.
+ * @details Channel IDs are scoped to one link. The proxy picks them when it activates a client on
+ * a shard and the shard adopts them from the ClientTransferPacket activation. A client has at
+ * most one channel, on the link to the shard owning it. Freed IDs are reused oldest first, so a
+ * message still in flight for a client that left rarely lands on the next one. Safe from any
+ * thread.
+ */
+class VirtualChannelTable
+{
+   public:
+	struct Route
+	{
+		NetworkIdentity Link;
+		ChannelID Channel = InvalidChannelID;
+	};
+
+	/// @brief Proxy side. Give client a channel on link, closing the one it had on another link.
+	/// @return nullopt when every ID on the link is taken.
+	std::optional<ChannelID> Open(const NetworkIdentity& link, const ClientID& client);
+	/// @brief Shard side. Take over the channel the proxy picked, replacing its previous client.
+	void Adopt(const NetworkIdentity& link, ChannelID channel, const ClientID& client);
+	/// @brief Close the client's channel or, for an internal peer, every channel on its link.
+	void Forget(const NetworkIdentity& peer);
+
+	[[nodiscard]] std::optional<Route> RouteOf(const ClientID& client) const;
+	[[nodiscard]] std::optional<ClientID> ClientOn(const NetworkIdentity& link,
+												   ChannelID channel) const;
+	[[nodiscard]] size_t Size() const;
+
+   private:
+	struct Link
+	{
+		std::unordered_map<ChannelID, ClientID> Clients;
+		std::deque<ChannelID> Free;
+		// Never handed out yet
+		uint32_t Next = InvalidChannelID + 1;
+	};
+	void CloseRoute(const ClientID& client);
+
+	mutable std::shared_mutex Mutex;
+	std::unordered_map<NetworkIdentity, Link> Links;
+	std::unordered_map<ClientID, Route, boost::hash<ClientID>> Routes;
+};
@@ -34,6 +34,8 @@ class EntityLedgersView
 	PacketManager::Subscription subToLocalEntityListRequestPacket;
 	std::atomic_uint32_t RequestsUnanswered = 0;
 	std::vector<EntityLedgerEntry> EntityListResponses;
+	// Responses from different shards can be handled on different dispatch lanes
+	std::mutex ResponsesMutex;
 
 	void OnLocalEntityListRequestPacket(const LocalEntityListRequestPacket& p,
 										const PacketManager::PacketInfo& info)
@@ -44,6 +46,7 @@ class EntityLedgersView
 		auto BoundID = HeuristicManifest::Get().BoundIDFromShard(info.sender);
 		if (BoundID.has_value())
 		{
+			std::lock_guard lock(ResponsesMutex);
 			logger.DebugFormatted(
 				"LocalEntityListRequestPacket arrived from {} with {} entities",
 				info.sender.ToString(),
@@ -85,22 +88,24 @@ class EntityLedgersView
 	~EntityLedgersView() {}
 	void GetEntityLists(std::vector<EntityLedgerEntry>& entities)
 	{
-		EntityListResponses.clear();
+		{
+			std::lock_guard lock(ResponsesMutex);
+			EntityListResponses.clear();
+		}
 		entities.clear();
 		auto startTime = std::chrono::high_resolution_clock::now();
 		const auto server_list = ServerRegistry::Get().GetServers();
+		std::vector<NetworkIdentity> shards;
 		for (const auto& [netID, Entry] : server_list)
 		{
 			if (netID.Type == NetworkIdentityType::eShard)
-			{
-				LocalEntityListRequestPacket p;
-				p.status = LocalEntityListRequestPacket::MsgStatus::eQuery;
-				p.Request_IncludeMetadata = false;
-				Interlink::Get().SendMessage(netID, p, NetworkMessageSendFlag::eReliableNow);
-
-				RequestsUnanswered.fetch_add(1, std::memory_order_relaxed);
-			}
+				shards.push_back(netID);
 		}
+		LocalEntityListRequestPacket p;
+		p.status = LocalEntityListRequestPacket::MsgStatus::eQuery;
+		p.Request_IncludeMetadata = false;
+		RequestsUnanswered.fetch_add((uint32_t)shards.size(), std::memory_order_relaxed);
+		Interlink::Get().SendMessageToMany(shards, p, NetworkMessageSendFlag::eReliableNow);
 		// Wait until all responses decrement RequestsUnanswered to 0
 		while (RequestsUnanswered.load(std::memory_order_acquire) > 0)
 		{
@@ -113,7 +118,10 @@ class EntityLedgersView
 		auto elapsedMs =
 			std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime).count();
 
-		entities = std::move(EntityListResponses);
+		{
+			std::lock_guard lock(ResponsesMutex);
+			entities = std::move(EntityListResponses);
+		}
 		logger.DebugFormatted("GetEntityLists completed in {}ms. returned {} entries",
 							  std::to_string(elapsedMs), entities.size());
 	}
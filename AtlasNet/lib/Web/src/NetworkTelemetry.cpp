@@ -41,6 +41,18 @@ void NetworkTelemetry::GetAllTelemetry(std::vector<std::vector<std::string>>& ou
     //}
 }
 
+void NetworkTelemetry::GetAllPacketTelemetry(std::vector<std::vector<std::string>>& out_telemetry) {
+    NetworkManifest::Get().GetAllPacketTelemetry(out_telemetry);
+}
+
+void NetworkTelemetry::GetAllHandshakeTelemetry(std::vector<std::vector<std::string>>& out_telemetry) {
+    NetworkManifest::Get().GetAllHandshakeTelemetry(out_telemetry);
+}
+
+void NetworkTelemetry::GetAllTickTelemetry(std::vector<std::vector<std::string>>& out_telemetry) {
+    NetworkManifest::Get().GetAllTickTelemetry(out_telemetry);
+}
+
 void NetworkTelemetry::GetLivePingUploadSpeed(float &out_upload_kbps) {
     //HealthManifest::Get().GetLivePingUploadSpeed(out_upload_kbps);
 }
@@ -8,6 +8,9 @@ public:
     
     void GetLivePingIDs(std::vector<std::string>& out_live_ids, std::vector<std::string>& out_health);
     void GetAllTelemetry(std::vector<std::vector<std::string>>& out_telemetry);
+    void GetAllPacketTelemetry(std::vector<std::vector<std::string>>& out_telemetry);
+    void GetAllHandshakeTelemetry(std::vector<std::vector<std::string>>& out_telemetry);
+    void GetAllTickTelemetry(std::vector<std::vector<std::string>>& out_telemetry);
     void GetLivePingUploadSpeed(float &out_upload_kbps);
     void GetLivePingDownloadSpeed(float &out_download_kbps);
 };
\ No newline at end of file
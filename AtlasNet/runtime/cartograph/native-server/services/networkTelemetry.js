@@ -1,5 +1,11 @@
+const CONNECTION_TELEMETRY_COLUMN_COUNT = 18;
+
 function decodeConnectionRow(row) {
-  const hasShardId = row.length >= 14;
+  // Rows from before the pending queue columns carry 13 columns, before the tuning columns 16
+  const hasShardId =
+    row.length === 14 ||
+    row.length === 17 ||
+    row.length >= CONNECTION_TELEMETRY_COLUMN_COUNT + 1;
   const offset = hasShardId ? 1 : 0;
 
   return {
@@ -17,6 +23,108 @@ function decodeConnectionRow(row) {
     qualityLocal: Number(row[offset + 10]),
     qualityRemote: Number(row[offset + 11]),
     state: row[offset + 12],
+    pendingQueueMessages: Number(row[offset + 13] ?? 0),
+    pendingQueueBytes: Number(row[offset + 14] ?? 0),
+    pendingQueueDropped: Number(row[offset + 15] ?? 0),
+    sendRateMin: Number(row[offset + 16] ?? 0),
+    nagleTimeUsec: Number(row[offset + 17] ?? 0),
+  };
+}
+
+const PACKET_TELEMETRY_COLUMN_COUNT = 26;
+
+function decodePacketTypeRow(row) {
+  return {
+    shardId: row[0],
+    name: row[1],
+    sent: Number(row[2]),
+    sentBytes: Number(row[3]),
+    received: Number(row[4]),
+    receivedBytes: Number(row[5]),
+    sizeP50: Number(row[6]),
+    sizeP99: Number(row[7]),
+    serializeP50Ns: Number(row[8]),
+    serializeP99Ns: Number(row[9]),
+    deserializeP50Ns: Number(row[10]),
+    deserializeP99Ns: Number(row[11]),
+    handled: Number(row[12]),
+    handlerP50Ns: Number(row[13]),
+    handlerP99Ns: Number(row[14]),
+    compressed: Number(row[15]),
+    compressRawBytes: Number(row[16]),
+    compressWireBytes: Number(row[17]),
+    compressionRatio: Number(row[18]),
+    compressP50Ns: Number(row[19]),
+    compressP99Ns: Number(row[20]),
+    decompressed: Number(row[21]),
+    decompressP50Ns: Number(row[22]),
+    decompressP99Ns: Number(row[23]),
+    queueDepth: Number(row[24]),
+    queueWaitP50Usec: Number(row[25]),
+    queueWaitP99Usec: Number(row[26]),
+  };
+}
+
+const HANDSHAKE_TELEMETRY_COLUMN_COUNT = 18;
+
+function decodeHandshakeRow(row) {
+  return {
+    shardId: row[0],
+    batches: Number(row[1]),
+    clientsPerBatchP50: Number(row[2]),
+    clientsPerBatchP99: Number(row[3]),
+    clients: Number(row[4]),
+    unplaced: Number(row[5]),
+    persistFailures: Number(row[6]),
+    queuedP50Usec: Number(row[7]),
+    queuedP99Usec: Number(row[8]),
+    resolveP50Usec: Number(row[9]),
+    resolveP99Usec: Number(row[10]),
+    heuristicReloadP50Usec: Number(row[11]),
+    heuristicReloadP99Usec: Number(row[12]),
+    persistP50Usec: Number(row[13]),
+    persistP99Usec: Number(row[14]),
+    notifyP50Usec: Number(row[15]),
+    notifyP99Usec: Number(row[16]),
+    totalP50Usec: Number(row[17]),
+    totalP99Usec: Number(row[18]),
+  };
+}
+
+const TICK_TELEMETRY_COLUMN_COUNT = 29;
+
+function decodeTickRow(row) {
+  return {
+    shardId: row[0],
+    ticks: Number(row[1]),
+    wakeDeadline: Number(row[2]),
+    wakeInbound: Number(row[3]),
+    wakeOutbound: Number(row[4]),
+    wakeTransport: Number(row[5]),
+    tickP50Usec: Number(row[6]),
+    tickP99Usec: Number(row[7]),
+    wakeLatencyP50Usec: Number(row[8]),
+    wakeLatencyP99Usec: Number(row[9]),
+    receivedMessages: Number(row[10]),
+    receivedBytes: Number(row[11]),
+    receiveBudgetExhausted: Number(row[12]),
+    receiveLeftMessages: Number(row[13]),
+    receiveBatchSize: Number(row[14]),
+    clientReceivedMessages: Number(row[15]),
+    clientReceivedBytes: Number(row[16]),
+    clientReceiveBudgetExhausted: Number(row[17]),
+    clientReceiveLeftMessages: Number(row[18]),
+    clientReceiveBatchSize: Number(row[19]),
+    admittedFromSnapshot: Number(row[20]),
+    admittedAfterLookup: Number(row[21]),
+    admissionRejected: Number(row[22]),
+    admissionLookupP50Usec: Number(row[23]),
+    admissionLookupP99Usec: Number(row[24]),
+    linkRetunes: Number(row[25]),
+    streamsCompleted: Number(row[26]),
+    streamsDropped: Number(row[27]),
+    streamChunksReceived: Number(row[28]),
+    streamBytesPending: Number(row[29]),
   };
 }
 
@@ -52,7 +160,13 @@ function toStringRows(telemetryVec) {
   return rows;
 }
 
-function buildNetworkTelemetry(ids, rows) {
+function buildNetworkTelemetry(
+  ids,
+  rows,
+  packetRows = [],
+  handshakeRows = [],
+  tickRows = []
+) {
   const normalizedIds = [];
   if (Array.isArray(ids)) {
     for (const id of ids) {
@@ -82,6 +196,52 @@ function buildNetworkTelemetry(ids, rows) {
     }
   }
 
+  const packetTypesByShard = new Map();
+  if (Array.isArray(packetRows)) {
+    for (const row of packetRows) {
+      if (!Array.isArray(row) || row.length < PACKET_TELEMETRY_COLUMN_COUNT + 1) {
+        continue;
+      }
+      const decoded = decodePacketTypeRow(row);
+      const shardId = String(decoded.shardId ?? '').trim();
+      if (shardId.length === 0) {
+        continue;
+      }
+      if (!packetTypesByShard.has(shardId)) {
+        packetTypesByShard.set(shardId, []);
+      }
+      packetTypesByShard.get(shardId).push(decoded);
+    }
+  }
+
+  const handshakeByShard = new Map();
+  if (Array.isArray(handshakeRows)) {
+    for (const row of handshakeRows) {
+      if (!Array.isArray(row) || row.length < HANDSHAKE_TELEMETRY_COLUMN_COUNT + 1) {
+        continue;
+      }
+      const decoded = decodeHandshakeRow(row);
+      const shardId = String(decoded.shardId ?? '').trim();
+      if (shardId.length > 0) {
+        handshakeByShard.set(shardId, decoded);
+      }
+    }
+  }
+
+  const tickByShard = new Map();
+  if (Array.isArray(tickRows)) {
+    for (const row of tickRows) {
+      if (!Array.isArray(row) || row.length < TICK_TELEMETRY_COLUMN_COUNT + 1) {
+        continue;
+      }
+      const decoded = decodeTickRow(row);
+      const shardId = String(decoded.shardId ?? '').trim();
+      if (shardId.length > 0) {
+        tickByShard.set(shardId, decoded);
+      }
+    }
+  }
+
   const orderedShardIds = [];
   const seen = new Set();
   for (const id of normalizedIds) {
@@ -107,6 +267,11 @@ function buildNetworkTelemetry(ids, rows) {
       downloadKbps: inAvg,
       uploadKbps: outAvg,
       connections,
+      packetTypes: (packetTypesByShard.get(id) ?? []).sort(
+        (a, b) => b.sentBytes + b.receivedBytes - (a.sentBytes + a.receivedBytes)
+      ),
+      handshake: handshakeByShard.get(id),
+      tick: tickByShard.get(id),
     };
   });
 }
@@ -133,16 +298,40 @@ function readNetworkTelemetry(addon, networkTelemetry) {
   networkTelemetry.GetLivePingIDs(idsVec, healthVec);
   networkTelemetry.GetAllTelemetry(telemetryVec);
 
+  const packetTelemetryVec = new std_vector_std_vector_std_string__();
+  if (typeof networkTelemetry.GetAllPacketTelemetry === 'function') {
+    networkTelemetry.GetAllPacketTelemetry(packetTelemetryVec);
+  }
+
+  const handshakeTelemetryVec = new std_vector_std_vector_std_string__();
+  if (typeof networkTelemetry.GetAllHandshakeTelemetry === 'function') {
+    networkTelemetry.GetAllHandshakeTelemetry(handshakeTelemetryVec);
+  }
+
+  const tickTelemetryVec = new std_vector_std_vector_std_string__();
+  if (typeof networkTelemetry.GetAllTickTelemetry === 'function') {
+    networkTelemetry.GetAllTickTelemetry(tickTelemetryVec);
+  }
+
   const ids = [];
   const count = Math.min(idsVec.size(), healthVec.size());
   for (let i = 0; i < count; i += 1) {
     ids.push(String(idsVec.get(i)));
   }
 
-  return buildNetworkTelemetry(ids, toStringRows(telemetryVec));
+  return buildNetworkTelemetry(
+    ids,
+    toStringRows(telemetryVec),
+    toStringRows(packetTelemetryVec),
+    toStringRows(handshakeTelemetryVec),
+    toStringRows(tickTelemetryVec)
+  );
 }
 
 module.exports = {
+  HANDSHAKE_TELEMETRY_COLUMN_COUNT,
+  PACKET_TELEMETRY_COLUMN_COUNT,
+  TICK_TELEMETRY_COLUMN_COUNT,
   buildNetworkTelemetry,
   readNetworkTelemetry,
 };
@@ -1,15 +1,23 @@
 const Redis = require('ioredis');
 const { formatUuid } = require('./RevertByteOptimation/format');
-const { buildNetworkTelemetry } = require('./networkTelemetry');
+const {
+  buildNetworkTelemetry,
+  PACKET_TELEMETRY_COLUMN_COUNT,
+  HANDSHAKE_TELEMETRY_COLUMN_COUNT,
+  TICK_TELEMETRY_COLUMN_COUNT,
+} = require('./networkTelemetry');
 const { getDatabaseTargets, SNAPSHOT_CONNECT_TIMEOUT_MS } = require('../config');
 
 const AUTHORITY_TELEMETRY_KEY = 'Authority_Telemetry';
 const HEALTH_PING_KEY = 'Health_Ping';
 const NETWORK_TELEMETRY_KEY = 'Network_Telemetry';
+const PACKET_TELEMETRY_KEY = 'Network_PacketTelemetry';
+const HANDSHAKE_TELEMETRY_KEY = 'Network_HandshakeTelemetry';
+const TICK_TELEMETRY_KEY = 'Network_TickTelemetry';
 const HEURISTIC_MANIFEST_KEY = 'HeuristicManifest';
 
 const AUTHORITY_TELEMETRY_COLUMN_COUNT = 7;
-const NETWORK_TELEMETRY_COLUMN_COUNT = 13;
+const NETWORK_TELEMETRY_COLUMN_COUNT = 18;
 const GRID_SHAPE_SERIALIZED_SIZE_BYTES = 28;
 const CLAIMED_OWNER_MAP_CACHE_TTL_MS = 500;
 
@@ -279,7 +287,46 @@ async function readNetworkTelemetryFromDatabase() {
         }
       }
 
-      return buildNetworkTelemetry(liveShardIds, rows);
+      const allPacketTelemetry = await client.hgetall(PACKET_TELEMETRY_KEY);
+      const packetRows = [];
+      for (const [shardId, payload] of Object.entries(allPacketTelemetry || {})) {
+        for (const line of String(payload).split(/\r?\n/)) {
+          if (!line) {
+            continue;
+          }
+          const columns = parseTabSeparatedColumns(line, PACKET_TELEMETRY_COLUMN_COUNT);
+          if (!columns) {
+            continue;
+          }
+          packetRows.push([String(shardId), ...columns]);
+        }
+      }
+
+      const allHandshakeTelemetry = await client.hgetall(HANDSHAKE_TELEMETRY_KEY);
+      const handshakeRows = [];
+      for (const [proxyId, payload] of Object.entries(allHandshakeTelemetry || {})) {
+        const columns = parseTabSeparatedColumns(
+          String(payload).trim(),
+          HANDSHAKE_TELEMETRY_COLUMN_COUNT
+        );
+        if (columns) {
+          handshakeRows.push([String(proxyId), ...columns]);
+        }
+      }
+
+      const allTickTelemetry = await client.hgetall(TICK_TELEMETRY_KEY);
+      const tickRows = [];
+      for (const [nodeId, payload] of Object.entries(allTickTelemetry || {})) {
+        const columns = parseTabSeparatedColumns(
+          String(payload).trim(),
+          TICK_TELEMETRY_COLUMN_COUNT
+        );
+        if (columns) {
+          tickRows.push([String(nodeId), ...columns]);
+        }
+      }
+
+      return buildNetworkTelemetry(liveShardIds, rows, packetRows, handshakeRows, tickRows);
     })) || []
   );
 }
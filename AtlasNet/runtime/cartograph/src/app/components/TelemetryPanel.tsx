@@ -79,6 +79,191 @@ export function TelemetryPanel({
             <Metric label="Connections" value={shard.connections.length} />
           </div>
 
+          {/* Tick loop */}
+          {shard.tick && (
+            <div className="space-y-4">
+              <h3 className="text-sm font-medium text-slate-300">Tick Loop</h3>
+              <div className="grid grid-cols-3 gap-4 rounded-2xl bg-slate-900/60 border border-slate-800 p-4">
+                <Metric label="Ticks" value={shard.tick.ticks} />
+                <Metric
+                  label="Tick µs p50/p99"
+                  value={`${shard.tick.tickP50Usec}/${shard.tick.tickP99Usec}`}
+                />
+                <Metric
+                  label="Wake latency µs p50/p99"
+                  value={`${shard.tick.wakeLatencyP50Usec}/${shard.tick.wakeLatencyP99Usec}`}
+                />
+                <Metric
+                  label="Wakeups deadline/inbound"
+                  value={`${shard.tick.wakeDeadline}/${shard.tick.wakeInbound}`}
+                />
+                <Metric
+                  label="Wakeups outbound/transport"
+                  value={`${shard.tick.wakeOutbound}/${shard.tick.wakeTransport}`}
+                />
+                <Metric
+                  label="Received msgs/bytes"
+                  value={`${shard.tick.receivedMessages}/${shard.tick.receivedBytes}`}
+                />
+                <Metric
+                  label="Receive batch, budget hit/left msgs"
+                  value={`${shard.tick.receiveBatchSize}, ${shard.tick.receiveBudgetExhausted}/${shard.tick.receiveLeftMessages}`}
+                />
+                <Metric
+                  label="Client received msgs/bytes"
+                  value={`${shard.tick.clientReceivedMessages}/${shard.tick.clientReceivedBytes}`}
+                />
+                <Metric
+                  label="Client batch, budget hit/left msgs"
+                  value={`${shard.tick.clientReceiveBatchSize}, ${shard.tick.clientReceiveBudgetExhausted}/${shard.tick.clientReceiveLeftMessages}`}
+                />
+                <Metric
+                  label="Admitted snapshot/lookup, rejected"
+                  value={`${shard.tick.admittedFromSnapshot}/${shard.tick.admittedAfterLookup}, ${shard.tick.admissionRejected}`}
+                />
+                <Metric
+                  label="Admission lookup µs p50/p99"
+                  value={`${shard.tick.admissionLookupP50Usec}/${shard.tick.admissionLookupP99Usec}`}
+                />
+                <Metric label="Link retunes" value={shard.tick.linkRetunes} />
+                <Metric
+                  label="Streams completed/dropped"
+                  value={`${shard.tick.streamsCompleted}/${shard.tick.streamsDropped}`}
+                />
+                <Metric
+                  label="Stream chunks, bytes pending"
+                  value={`${shard.tick.streamChunksReceived}, ${shard.tick.streamBytesPending}`}
+                />
+              </div>
+            </div>
+          )}
+
+          {/* Handshake, proxies only */}
+          {shard.handshake && (
+            <div className="space-y-4">
+              <h3 className="text-sm font-medium text-slate-300">
+                Client Handshake
+              </h3>
+              <div className="grid grid-cols-3 gap-4 rounded-2xl bg-slate-900/60 border border-slate-800 p-4">
+                <Metric label="Batches" value={shard.handshake.batches} />
+                <Metric
+                  label="Clients per batch p50/p99"
+                  value={`${shard.handshake.clientsPerBatchP50}/${shard.handshake.clientsPerBatchP99}`}
+                />
+                <Metric label="Clients" value={shard.handshake.clients} />
+                <Metric label="Unplaced" value={shard.handshake.unplaced} />
+                <Metric
+                  label="Persist failures"
+                  value={shard.handshake.persistFailures}
+                />
+                <Metric
+                  label="Queued µs p50/p99"
+                  value={`${shard.handshake.queuedP50Usec}/${shard.handshake.queuedP99Usec}`}
+                />
+                <Metric
+                  label="Resolve µs p50/p99"
+                  value={`${shard.handshake.resolveP50Usec}/${shard.handshake.resolveP99Usec}`}
+                />
+                <Metric
+                  label="Heuristic reload µs p50/p99"
+                  value={`${shard.handshake.heuristicReloadP50Usec}/${shard.handshake.heuristicReloadP99Usec}`}
+                />
+                <Metric
+                  label="Persist µs p50/p99"
+                  value={`${shard.handshake.persistP50Usec}/${shard.handshake.persistP99Usec}`}
+                />
+                <Metric
+                  label="Notify µs p50/p99"
+                  value={`${shard.handshake.notifyP50Usec}/${shard.handshake.notifyP99Usec}`}
+                />
+                <Metric
+                  label="Total µs p50/p99"
+                  value={`${shard.handshake.totalP50Usec}/${shard.handshake.totalP99Usec}`}
+                />
+              </div>
+            </div>
+          )}
+
+          {/* Packet types */}
+          <div className="space-y-4">
+            <h3 className="text-sm font-medium text-slate-300">
+              Packet Types
+            </h3>
+
+            {(shard.packetTypes?.length ?? 0) > 0 ? (
+              <div className="overflow-x-auto rounded-2xl bg-slate-900/80 border border-slate-800 p-4">
+                <table className="w-full font-mono text-xs text-slate-200">
+                  <thead className="text-slate-400">
+                    <tr>
+                      <th className="text-left p-1">Type</th>
+                      <th className="text-right p-1">Sent</th>
+                      <th className="text-right p-1">Sent Bytes</th>
+                      <th className="text-right p-1">Received</th>
+                      <th className="text-right p-1">Received Bytes</th>
+                      <th className="text-right p-1">Size p50/p99</th>
+                      <th className="text-right p-1">Serialize ns p50/p99</th>
+                      <th className="text-right p-1">Deserialize ns p50/p99</th>
+                      <th className="text-right p-1">Handled</th>
+                      <th className="text-right p-1">Handler ns p50/p99</th>
+                      <th className="text-right p-1">Queued</th>
+                      <th className="text-right p-1">Queue wait µs p50/p99</th>
+                      <th className="text-right p-1">Compressed/Decompressed</th>
+                      <th className="text-right p-1">Raw/Wire Bytes</th>
+                      <th className="text-right p-1">Ratio</th>
+                      <th className="text-right p-1">Compress ns p50/p99</th>
+                      <th className="text-right p-1">Decompress ns p50/p99</th>
+                    </tr>
+                  </thead>
+                  <tbody>
+                    {shard.packetTypes!.map((p) => (
+                      <tr key={p.name}>
+                        <td className="text-left p-1">{p.name}</td>
+                        <td className="text-right p-1">{p.sent}</td>
+                        <td className="text-right p-1">{p.sentBytes}</td>
+                        <td className="text-right p-1">{p.received}</td>
+                        <td className="text-right p-1">{p.receivedBytes}</td>
+                        <td className="text-right p-1">{p.sizeP50}/{p.sizeP99}</td>
+                        <td className="text-right p-1">
+                          {p.serializeP50Ns}/{p.serializeP99Ns}
+                        </td>
+                        <td className="text-right p-1">
+                          {p.deserializeP50Ns}/{p.deserializeP99Ns}
+                        </td>
+                        <td className="text-right p-1">{p.handled}</td>
+                        <td className="text-right p-1">
+                          {p.handlerP50Ns}/{p.handlerP99Ns}
+                        </td>
+                        <td className="text-right p-1">{p.queueDepth}</td>
+                        <td className="text-right p-1">
+                          {p.queueWaitP50Usec}/{p.queueWaitP99Usec}
+                        </td>
+                        <td className="text-right p-1">
+                          {p.compressed}/{p.decompressed}
+                        </td>
+                        <td className="text-right p-1">
+                          {p.compressRawBytes}/{p.compressWireBytes}
+                        </td>
+                        <td className="text-right p-1">
+                          {p.compressionRatio.toFixed(2)}
+                        </td>
+                        <td className="text-right p-1">
+                          {p.compressP50Ns}/{p.compressP99Ns}
+                        </td>
+                        <td className="text-right p-1">
+                          {p.decompressP50Ns}/{p.decompressP99Ns}
+                        </td>
+                      </tr>
+                    ))}
+                  </tbody>
+                </table>
+              </div>
+            ) : (
+              <div className="text-sm text-slate-500 italic">
+                No packet traffic recorded.
+              </div>
+            )}
+          </div>
+
           {/* Connections */}
           <div className="space-y-4">
             <h3 className="text-sm font-medium text-slate-300">
@@ -117,6 +302,15 @@ export function TelemetryPanel({
                   <Metric label="Pending Unreliable Bytes" value={c.pendingUnreliableBytes} />
                   <Metric label="Unacked Reliable Bytes" value={c.sentUnackedReliableBytes} />
                   <Metric label="State" value={c.state} />
+
+                  {/* Interlink pending queue */}
+                  <Metric label="Queued Messages" value={c.pendingQueueMessages} />
+                  <Metric label="Queued Bytes" value={c.pendingQueueBytes} />
+                  <Metric label="Queue Drops" value={c.pendingQueueDropped} />
+
+                  {/* LinkTuner */}
+                  <Metric label="Send Rate Min (B/s)" value={c.sendRateMin} />
+                  <Metric label="Nagle (µs)" value={c.nagleTimeUsec} />
                 </div>
               </div>
             ))}
@@ -29,6 +29,100 @@ export interface ConnectionTelemetry {
   qualityLocal: number;
   qualityRemote: number;
   state: string;
+  /** Messages Interlink holds until the connection is up, and how many it gave up on. */
+  pendingQueueMessages: number;
+  pendingQueueBytes: number;
+  pendingQueueDropped: number;
+  /** GNS send rate floor (bytes/s) and Nagle time in effect, as tuned. */
+  sendRateMin: number;
+  nagleTimeUsec: number;
+}
+
+/** Cumulative per packet type counters of one node. Sizes in bytes, times in ns. */
+export interface PacketTypeTelemetry {
+  name: string;
+  sent: number;
+  sentBytes: number;
+  received: number;
+  receivedBytes: number;
+  sizeP50: number;
+  sizeP99: number;
+  serializeP50Ns: number;
+  serializeP99Ns: number;
+  deserializeP50Ns: number;
+  deserializeP99Ns: number;
+  handled: number;
+  handlerP50Ns: number;
+  handlerP99Ns: number;
+  /** Sends over the compression threshold, raw and on the wire, raw/wire as the ratio. */
+  compressed: number;
+  compressRawBytes: number;
+  compressWireBytes: number;
+  compressionRatio: number;
+  compressP50Ns: number;
+  compressP99Ns: number;
+  decompressed: number;
+  decompressP50Ns: number;
+  decompressP99Ns: number;
+  /** Dispatch worker backlog of eWorkerPool types, wait in µs. */
+  queueDepth: number;
+  queueWaitP50Usec: number;
+  queueWaitP99Usec: number;
+}
+
+/** Cumulative client handshake stages of one proxy, times in µs. */
+export interface HandshakeTelemetry {
+  batches: number;
+  clientsPerBatchP50: number;
+  clientsPerBatchP99: number;
+  clients: number;
+  unplaced: number;
+  persistFailures: number;
+  queuedP50Usec: number;
+  queuedP99Usec: number;
+  resolveP50Usec: number;
+  resolveP99Usec: number;
+  heuristicReloadP50Usec: number;
+  heuristicReloadP99Usec: number;
+  persistP50Usec: number;
+  persistP99Usec: number;
+  notifyP50Usec: number;
+  notifyP99Usec: number;
+  totalP50Usec: number;
+  totalP99Usec: number;
+}
+
+/** Cumulative Interlink tick loop counters of one node, times in µs. */
+export interface TickTelemetry {
+  ticks: number;
+  wakeDeadline: number;
+  wakeInbound: number;
+  wakeOutbound: number;
+  wakeTransport: number;
+  tickP50Usec: number;
+  tickP99Usec: number;
+  wakeLatencyP50Usec: number;
+  wakeLatencyP99Usec: number;
+  receivedMessages: number;
+  receivedBytes: number;
+  receiveBudgetExhausted: number;
+  receiveLeftMessages: number;
+  receiveBatchSize: number;
+  clientReceivedMessages: number;
+  clientReceivedBytes: number;
+  clientReceiveBudgetExhausted: number;
+  clientReceiveLeftMessages: number;
+  clientReceiveBatchSize: number;
+  admittedFromSnapshot: number;
+  admittedAfterLookup: number;
+  admissionRejected: number;
+  admissionLookupP50Usec: number;
+  admissionLookupP99Usec: number;
+  linkRetunes: number;
+  streamsCompleted: number;
+  streamsDropped: number;
+  streamChunksReceived: number;
+  streamBytesPending: number;
 }
 
 export interface ShardTelemetry {
@@ -36,6 +130,9 @@ export interface ShardTelemetry {
   downloadKbps: number;
   uploadKbps: number;
   connections: ConnectionTelemetry[];
+  packetTypes?: PacketTypeTelemetry[];
+  handshake?: HandshakeTelemetry;
+  tick?: TickTelemetry;
 }
 
 export interface AuthorityEntityTelemetry {
@@ -28,6 +28,7 @@ services:
     networks: [${ATLASNET_NETWORK_NAME}]
     volumes:
       - /var/run/docker.sock:/var/run/docker.sock
+      - /dev/shm:/run/atlasnet # same host Interlink links
     deploy:
      resources:
         limits:
@@ -73,6 +74,7 @@ services:
     networks: [${ATLASNET_NETWORK_NAME}]
     volumes:
       - /var/run/docker.sock:/var/run/docker.sock
+      - /dev/shm:/run/atlasnet # same host Interlink links
     ports:
       - target: ${PORT_PROXY}
         published: ${PORT_PROXY_PUBLISHED}